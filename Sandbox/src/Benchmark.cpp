@@ -0,0 +1,88 @@
+#include "Benchmark.h"
+#include <imgui/imgui.h>
+
+Benchmark::Benchmark(const std::string& name, const std::string& title)
+	: Layer(name), m_Title(title)
+{
+}
+
+void Benchmark::OnUpdate(Hazel::Timestep ts)
+{
+	HZ_PROFILE_FUNCTION();
+
+	Hazel::RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
+	Hazel::RenderCommand::Clear();
+
+	// Run outside of ImGui, a run can take long enough to stall the frame anyway
+	if (m_RunRequested)
+	{
+		m_RunRequested = false;
+		m_Results = Run();
+		m_HasResults = true;
+		LogResults();
+	}
+}
+
+void Benchmark::OnImGuiRender()
+{
+	HZ_PROFILE_FUNCTION();
+
+	ImGui::Begin(m_Title.c_str());
+
+	OnSettingsImGuiRender();
+	if (ImGui::Button("Run"))
+		RequestRun();
+
+	if (m_HasResults)
+	{
+		ImGui::Separator();
+		ImGui::Columns((int)m_Results.Columns.size());
+		for (const std::string& column : m_Results.Columns)
+		{
+			ImGui::Text("%s", column.c_str());
+			ImGui::NextColumn();
+		}
+
+		for (const auto& row : m_Results.Rows)
+		{
+			for (const std::string& cell : row)
+			{
+				ImGui::Text("%s", cell.c_str());
+				ImGui::NextColumn();
+			}
+		}
+		ImGui::Columns(1);
+
+		for (const std::string& note : m_Results.Notes)
+			ImGui::Text("%s", note.c_str());
+	}
+
+	ImGui::End();
+}
+
+void Benchmark::LogResults() const
+{
+	std::vector<size_t> widths(m_Results.Columns.size());
+	for (size_t i = 0; i < widths.size(); i++)
+		widths[i] = m_Results.Columns[i].size();
+	for (const auto& row : m_Results.Rows)
+	{
+		for (size_t i = 0; i < row.size() && i < widths.size(); i++)
+			widths[i] = std::max(widths[i], row[i].size());
+	}
+
+	auto formatRow = [&](const std::vector<std::string>& cells)
+	{
+		std::string line;
+		for (size_t i = 0; i < cells.size() && i < widths.size(); i++)
+			line += fmt::format("{0:<{1}}  ", cells[i], widths[i]);
+		return line;
+	};
+
+	HZ_INFO("{0}", m_Title);
+	HZ_INFO("{0}", formatRow(m_Results.Columns));
+	for (const auto& row : m_Results.Rows)
+		HZ_INFO("{0}", formatRow(row));
+	for (const std::string& note : m_Results.Notes)
+		HZ_INFO("{0}", note);
+}
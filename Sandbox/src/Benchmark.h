@@ -0,0 +1,42 @@
+#pragma once
+
+#include "xingxing.h"
+
+#include <string>
+#include <vector>
+
+// The results of a benchmark run as a table, shown in the benchmark's window and written to the log
+struct BenchmarkResults
+{
+	std::vector<std::string> Columns;
+	std::vector<std::vector<std::string>> Rows;
+	// Shown below the table, like the checksums that keep the measured work from being optimized away
+	std::vector<std::string> Notes;
+};
+
+// Base of the Sandbox benchmarks that measure in one go. The layer shows a window with the benchmark's
+// settings, a Run button and the results of the last run, which are logged as well.
+// Benchmarks are opt-in, see SandboxApp.cpp; one picked on the command line runs on its first frame.
+class Benchmark : public Hazel::Layer
+{
+public:
+	Benchmark(const std::string& name, const std::string& title);
+	virtual ~Benchmark() = default;
+
+	void OnUpdate(Hazel::Timestep ts) override;
+	virtual void OnImGuiRender() override;
+
+	// Runs at the start of the next frame
+	void RequestRun() { m_RunRequested = true; }
+protected:
+	virtual BenchmarkResults Run() = 0;
+	// Drawn above the Run button
+	virtual void OnSettingsImGuiRender() {}
+private:
+	void LogResults() const;
+private:
+	std::string m_Title;
+	bool m_RunRequested = false;
+	bool m_HasResults = false;
+	BenchmarkResults m_Results;
+};
@@ -0,0 +1,119 @@
+#include "ComponentLayoutBenchmark.h"
+
+#include "XingXing/Core/Timer.h"
+
+namespace {
+
+	// SpriteRendererComponent before it held asset handles
+	struct RefSpriteRendererComponent
+	{
+		glm::vec4 Color{ 1.0f, 1.0f, 1.0f, 1.0f };
+		Hazel::Ref<Hazel::Texture2D> Texture;
+		Hazel::Ref<Hazel::SubTexture2D> SubTexture;
+		float TilingFactor = 1.0f;
+	};
+
+}
+
+ComponentLayoutBenchmark::ComponentLayoutBenchmark()
+	: Benchmark("ComponentLayoutBenchmark", "Component Layout Benchmark")
+{
+}
+
+void ComponentLayoutBenchmark::OnAttach()
+{
+	HZ_PROFILE_FUNCTION();
+
+	// A handful of textures shared by many sprites, as in a typical scene
+	for (uint32_t i = 0; i < 8; i++)
+		m_Textures.push_back(Hazel::Texture2D::Create(Hazel::TextureSpecification()));
+}
+
+void ComponentLayoutBenchmark::OnDetach()
+{
+	HZ_PROFILE_FUNCTION();
+
+	m_Textures.clear();
+}
+
+BenchmarkResults ComponentLayoutBenchmark::Run()
+{
+	HZ_PROFILE_FUNCTION();
+
+	BenchmarkResults results;
+	results.Columns = { "Entities", "Ref copy (ms)", "Handle copy (ms)", "Ref iteration (ms)", "Handle iteration (ms)" };
+	uint64_t checksum = 0;
+
+	std::vector<Hazel::AssetHandle<Hazel::Texture2D>> handles;
+	for (const auto& texture : m_Textures)
+		handles.push_back(Hazel::AssetTable<Hazel::Texture2D>::Add(texture));
+
+	const uint32_t entityCounts[] = { 1000, 10000, 100000, 500000 };
+	for (uint32_t entityCount : entityCounts)
+	{
+		float refCopy = 0.0f, handleCopy = 0.0f, refIteration = 0.0f, handleIteration = 0.0f;
+
+		entt::registry source;
+		std::vector<entt::entity> entities(entityCount);
+		source.create(entities.begin(), entities.end());
+		for (uint32_t i = 0; i < entityCount; i++)
+		{
+			size_t texture = i % m_Textures.size();
+			source.emplace<RefSpriteRendererComponent>(entities[i], glm::vec4(1.0f), m_Textures[texture]);
+			source.emplace<Hazel::SpriteRendererComponent>(entities[i]).Texture = handles[texture];
+		}
+
+		// Copying, as Scene::Copy and prefab instantiation do
+		{
+			entt::registry destination;
+			destination.create(entities.begin(), entities.end());
+			auto view = source.view<RefSpriteRendererComponent>();
+
+			Hazel::Timer timer;
+			destination.insert<RefSpriteRendererComponent>(view.data(), view.data() + view.size(), view.raw(), view.raw() + view.size());
+			refCopy = timer.ElapsedMillis();
+		}
+
+		{
+			entt::registry destination;
+			destination.create(entities.begin(), entities.end());
+			auto view = source.view<Hazel::SpriteRendererComponent>();
+
+			Hazel::Timer timer;
+			destination.insert<Hazel::SpriteRendererComponent>(view.data(), view.data() + view.size(), view.raw(), view.raw() + view.size());
+			handleCopy = timer.ElapsedMillis();
+		}
+
+		// Resolving the texture of every sprite, as rendering does
+		{
+			Hazel::Timer timer;
+			source.view<RefSpriteRendererComponent>().each([&](auto entity, auto& sprite)
+			{
+				if (sprite.SubTexture)
+					checksum += sprite.SubTexture->GetTexture()->GetRendererID();
+				else if (sprite.Texture)
+					checksum += sprite.Texture->GetRendererID();
+			});
+			refIteration = timer.ElapsedMillis();
+		}
+
+		{
+			Hazel::Timer timer;
+			source.view<Hazel::SpriteRendererComponent>().each([&](auto entity, auto& sprite)
+			{
+				if (sprite.SubTexture)
+					checksum += Hazel::AssetTable<Hazel::SubTexture2D>::Get(sprite.SubTexture)->GetTexture()->GetRendererID();
+				else if (sprite.Texture)
+					checksum += Hazel::AssetTable<Hazel::Texture2D>::Get(sprite.Texture)->GetRendererID();
+			});
+			handleIteration = timer.ElapsedMillis();
+		}
+
+		results.Rows.push_back({ std::to_string(entityCount), fmt::format("{0:.3f}", refCopy), fmt::format("{0:.3f}", handleCopy),
+			fmt::format("{0:.3f}", refIteration), fmt::format("{0:.3f}", handleIteration) });
+	}
+
+	results.Notes.push_back(fmt::format("Sprite bytes per entity: Ref {0}, handle {1}", sizeof(RefSpriteRendererComponent), sizeof(Hazel::SpriteRendererComponent)));
+	results.Notes.push_back(fmt::format("Checksum: {0}", checksum));
+	return results;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Compares the handle based SpriteRendererComponent with the Ref<> layout it replaced: bytes per
+// entity, copying a scene's worth of sprites and iterating them the way rendering does
+class ComponentLayoutBenchmark : public Benchmark
+{
+public:
+	ComponentLayoutBenchmark();
+	virtual ~ComponentLayoutBenchmark() = default;
+
+	virtual void OnAttach() override;
+	virtual void OnDetach() override;
+protected:
+	virtual BenchmarkResults Run() override;
+private:
+	std::vector<Hazel::Ref<Hazel::Texture2D>> m_Textures;
+};
@@ -0,0 +1,76 @@
+#include "EntityCommandBufferBenchmark.h"
+#include <imgui/imgui.h>
+
+#include "XingXing/Scene/EntityCommandBuffer.h"
+#include "XingXing/Core/Timer.h"
+
+EntityCommandBufferBenchmark::EntityCommandBufferBenchmark()
+	: Benchmark("EntityCommandBufferBenchmark", "Entity Command Buffer Benchmark")
+{
+}
+
+void EntityCommandBufferBenchmark::OnSettingsImGuiRender()
+{
+	ImGui::DragInt("Spawns per frame", &m_SpawnCount, 100.0f, 1, 100000);
+	ImGui::DragInt("Frames", &m_FrameCount, 1.0f, 1, 1000);
+}
+
+BenchmarkResults EntityCommandBufferBenchmark::Run()
+{
+	HZ_PROFILE_FUNCTION();
+
+	BenchmarkResults results;
+	results.Columns = { "Spawn + destroy", "Average (ms)", "Max (ms)" };
+
+	for (bool useCommandBuffer : { false, true })
+	{
+		Hazel::Scene scene;
+		Hazel::Entity bullet = scene.CreateEntity("Bullet");
+		bullet.AddComponent<Hazel::SpriteRendererComponent>(glm::vec4{ 0.8f, 0.3f, 0.2f, 1.0f });
+		bullet.GetComponent<Hazel::TransformComponent>().Scale = { 0.1f, 0.1f, 1.0f };
+		const Hazel::UUID bulletID = bullet.GetUUID();
+
+		std::vector<Hazel::UUID> spawned;
+		float total = 0.0f, max = 0.0f;
+		for (int frame = 0; frame < m_FrameCount; frame++)
+		{
+			Hazel::Timer timer;
+			if (useCommandBuffer)
+			{
+				Hazel::EntityCommandBuffer& commands = scene.GetCommandBuffer();
+				for (Hazel::UUID entity : spawned)
+					commands.DestroyEntity(entity);
+
+				spawned.clear();
+				for (int i = 0; i < m_SpawnCount; i++)
+					spawned.push_back(commands.Instantiate(bulletID, { (float)(i % 100), (float)(i / 100), 0.0f }));
+
+				commands.Playback(scene);
+			}
+			else
+			{
+				for (Hazel::UUID entity : spawned)
+					scene.DestroyEntity(scene.GetEntityByUUID(entity));
+
+				spawned.clear();
+				Hazel::Entity source = scene.GetEntityByUUID(bulletID);
+				for (int i = 0; i < m_SpawnCount; i++)
+				{
+					Hazel::Entity entity = scene.DuplicateEntity(source);
+					entity.GetComponent<Hazel::TransformComponent>().Translation = { (float)(i % 100), (float)(i / 100), 0.0f };
+					spawned.push_back(entity.GetUUID());
+				}
+			}
+
+			float frameTime = timer.ElapsedMillis();
+			total += frameTime;
+			max = std::max(max, frameTime);
+		}
+
+		results.Rows.push_back({ useCommandBuffer ? "Command buffer" : "Immediate",
+			fmt::format("{0:.3f}", total / m_FrameCount), fmt::format("{0:.3f}", max) });
+	}
+
+	results.Notes.push_back(fmt::format("{0} entities per frame over {1} frames", m_SpawnCount, m_FrameCount));
+	return results;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Spawns and destroys a batch of sprite entities for a number of frames, either immediately one at
+// a time or recorded into the scene's command buffer and played back in bulk
+class EntityCommandBufferBenchmark : public Benchmark
+{
+public:
+	EntityCommandBufferBenchmark();
+	virtual ~EntityCommandBufferBenchmark() = default;
+protected:
+	virtual BenchmarkResults Run() override;
+	virtual void OnSettingsImGuiRender() override;
+private:
+	int m_SpawnCount = 10000;
+	int m_FrameCount = 60;
+};
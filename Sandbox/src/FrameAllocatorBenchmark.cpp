@@ -0,0 +1,146 @@
+#include "FrameAllocatorBenchmark.h"
+#include <imgui/imgui.h>
+
+#include "XingXing/Core/Timer.h"
+
+#include <iomanip>
+#include <sstream>
+
+FrameAllocatorBenchmark::FrameAllocatorBenchmark()
+	: Benchmark("FrameAllocatorBenchmark", "Frame Allocator Benchmark")
+{
+}
+
+void FrameAllocatorBenchmark::OnSettingsImGuiRender()
+{
+	auto allocationStats = Hazel::AllocationTracker::GetStats();
+	auto frameStats = Hazel::FrameAllocator::GetStats();
+	ImGui::Text("Heap allocations last frame: %llu (%.1f KB)", allocationStats.AllocationsLastFrame, allocationStats.BytesLastFrame / 1024.0f);
+	ImGui::Text("Frame arena last frame: %.1f KB, %d overflows", frameStats.UsedLastFrame / 1024.0f, frameStats.OverflowsLastFrame);
+	if (!Hazel::AllocationTracker::IsEnabled())
+		ImGui::Text("Allocation tracking is disabled, heap allocation counts read 0");
+
+	ImGui::DragInt("Iterations", &m_Iterations, 1000.0f, 1000, 10000000);
+}
+
+BenchmarkResults FrameAllocatorBenchmark::Run()
+{
+	HZ_PROFILE_FUNCTION();
+
+	BenchmarkResults results;
+	results.Columns = { "Case", "Heap allocations", "Arena heap allocations", "Heap (ns)", "Arena (ns)" };
+	uint64_t checksum = 0;
+
+	const uint32_t iterations = (uint32_t)m_Iterations;
+
+	// Runs heapFunc and arenaFunc iterations times each, counting heap allocations and time
+	auto measure = [&](const char* name, auto heapFunc, auto arenaFunc)
+	{
+		uint64_t allocations = Hazel::AllocationTracker::GetAllocationCount();
+		Hazel::Timer timer;
+		for (uint32_t i = 0; i < iterations; i++)
+			heapFunc(i);
+		float heap = timer.ElapsedMillis() * 1e6f / iterations;
+		uint64_t heapAllocations = Hazel::AllocationTracker::GetAllocationCount() - allocations;
+
+		allocations = Hazel::AllocationTracker::GetAllocationCount();
+		timer.Reset();
+		for (uint32_t i = 0; i < iterations; i++)
+			arenaFunc(i);
+		float arena = timer.ElapsedMillis() * 1e6f / iterations;
+		uint64_t arenaHeapAllocations = Hazel::AllocationTracker::GetAllocationCount() - allocations;
+
+		// Allocations per iteration
+		results.Rows.push_back({ name, fmt::format("{0:.3f}", (double)heapAllocations / iterations), fmt::format("{0:.3f}", (double)arenaHeapAllocations / iterations),
+			fmt::format("{0:.1f}", heap), fmt::format("{0:.1f}", arena) });
+	};
+
+	// Instrumentor::WriteProfile, before and after
+	const char* scopeName = "void __cdecl Hazel::Scene::OnUpdateRuntime(class Hazel::Timestep)";
+	measure("Profile event",
+		[&](uint32_t i)
+		{
+			std::stringstream json;
+			json << std::setprecision(3) << std::fixed;
+			json << ",{\"cat\":\"function\",\"dur\":" << i << ",\"name\":\"" << scopeName << "\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":" << i * 16.6;
+			json << "}";
+			checksum += json.str().size();
+		},
+		[&](uint32_t i)
+		{
+			fmt::memory_buffer json;
+			fmt::format_to(json, ",{{\"cat\":\"function\",\"dur\":{},\"name\":\"{}\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":{:.3f}}}", i, scopeName, i * 16.6);
+			checksum += json.size();
+		});
+
+	// Strings passed in from scripts, e.g. Entity.FindEntityByName
+	const char* scriptString = "EnemySpawner_Wave03_Right";
+	measure("Script string",
+		[&](uint32_t i)
+		{
+			std::string str(scriptString);
+			checksum += str[i % str.size()];
+		},
+		[&](uint32_t i)
+		{
+			Hazel::ScratchScope scratch;
+			size_t length = strlen(scriptString);
+			char* str = Hazel::ScratchAllocator::Get().Allocate<char>(length + 1);
+			memcpy(str, scriptString, length + 1);
+			checksum += str[i % length];
+		});
+
+	// Scene::DestroyEntity copying the children it iterates
+	std::vector<Hazel::UUID> children(16);
+	measure("Children copy",
+		[&](uint32_t i)
+		{
+			std::vector<Hazel::UUID> copy = children;
+			checksum += copy.size();
+		},
+		[&](uint32_t i)
+		{
+			Hazel::ScratchScope scratch;
+			std::pmr::vector<Hazel::UUID> copy(children.begin(), children.end(), Hazel::ScratchAllocator::GetMemoryResource());
+			checksum += copy.size();
+		});
+
+	// Per-frame lists, e.g. transforms gathered for rendering. A local arena stands in for the frame
+	// allocator, its reset for the frame boundary; resetting the real one here would free live data.
+	Hazel::LinearAllocator arena(64 * 1024);
+	Hazel::LinearMemoryResource arenaResource(arena);
+	measure("Frame list",
+		[&](uint32_t i)
+		{
+			std::vector<glm::mat4> transforms;
+			for (uint32_t j = 0; j < 64; j++)
+				transforms.emplace_back(1.0f);
+			checksum += transforms.size();
+		},
+		[&](uint32_t i)
+		{
+			std::pmr::vector<glm::mat4> transforms(&arenaResource);
+			for (uint32_t j = 0; j < 64; j++)
+				transforms.emplace_back(1.0f);
+			checksum += transforms.size();
+			arena.Reset();
+		});
+
+	// Panel labels passed as const std::string&
+	measure("Panel label",
+		[&](uint32_t i)
+		{
+			auto label = [](const std::string& name) { return name.size(); };
+			checksum += label("Circle Collider 2D");
+		},
+		[&](uint32_t i)
+		{
+			auto label = [](const char* name) { return strlen(name); };
+			checksum += label("Circle Collider 2D");
+		});
+
+	if (!Hazel::AllocationTracker::IsEnabled())
+		results.Notes.push_back("Allocation tracking is disabled, heap allocation counts read 0");
+	results.Notes.push_back(fmt::format("Checksum: {0}", checksum));
+	return results;
+}
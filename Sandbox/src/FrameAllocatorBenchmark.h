@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Heap allocations and time of the transient allocations moved onto the frame and scratch
+// allocators, each run the old way and the new way. Also shows the allocations of the last frame.
+class FrameAllocatorBenchmark : public Benchmark
+{
+public:
+	FrameAllocatorBenchmark();
+	virtual ~FrameAllocatorBenchmark() = default;
+protected:
+	virtual BenchmarkResults Run() override;
+	virtual void OnSettingsImGuiRender() override;
+private:
+	int m_Iterations = 100000;
+};
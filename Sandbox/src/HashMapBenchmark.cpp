@@ -0,0 +1,82 @@
+#include "HashMapBenchmark.h"
+#include <imgui/imgui.h>
+
+#include "XingXing/Core/FlatHashMap.h"
+#include "XingXing/Core/Timer.h"
+
+#include <random>
+
+HashMapBenchmark::HashMapBenchmark()
+	: Benchmark("HashMapBenchmark", "Hash Map Benchmark")
+{
+}
+
+void HashMapBenchmark::OnSettingsImGuiRender()
+{
+	ImGui::DragInt("Lookups", &m_LookupCount, 1024.0f, 1024, 1 << 24);
+}
+
+BenchmarkResults HashMapBenchmark::Run()
+{
+	HZ_PROFILE_FUNCTION();
+
+	BenchmarkResults results;
+	results.Columns = { "Entities", "unordered_map (ns)", "FlatHashMap (ns)", "Internal call (ns)" };
+	uint64_t checksum = 0;
+
+	std::mt19937_64 random(1234);
+	const uint32_t entityCounts[] = { 1000, 10000, 100000, 200000 };
+	for (uint32_t entityCount : entityCounts)
+	{
+		Hazel::Scene scene;
+		std::vector<Hazel::UUID> uuids;
+		std::unordered_map<Hazel::UUID, entt::entity> unorderedMap;
+		Hazel::FlatHashMap<Hazel::UUID, entt::entity> flatHashMap;
+		for (uint32_t i = 0; i < entityCount; i++)
+		{
+			Hazel::Entity entity = scene.CreateEntity();
+			uuids.push_back(entity.GetUUID());
+			unorderedMap[entity.GetUUID()] = entity;
+			flatHashMap[entity.GetUUID()] = entity;
+		}
+
+		// Random access, like scripts spread over the scene
+		std::vector<Hazel::UUID> queries((size_t)m_LookupCount);
+		for (Hazel::UUID& query : queries)
+			query = uuids[random() % entityCount];
+
+		Hazel::Timer timer;
+		for (Hazel::UUID query : queries)
+		{
+			// What GetEntityByUUID used to do
+			if (unorderedMap.find(query) != unorderedMap.end())
+				checksum += (uint32_t)unorderedMap.at(query);
+		}
+		float unorderedMapLookup = timer.ElapsedMillis() * 1e6f / (float)queries.size();
+
+		timer.Reset();
+		for (Hazel::UUID query : queries)
+		{
+			auto it = flatHashMap.find(query);
+			if (it != flatHashMap.end())
+				checksum += (uint32_t)it->second;
+		}
+		float flatHashMapLookup = timer.ElapsedMillis() * 1e6f / (float)queries.size();
+
+		timer.Reset();
+		glm::vec3 translation(0.0f);
+		for (Hazel::UUID query : queries)
+		{
+			Hazel::Entity entity = scene.GetEntityByUUID(query);
+			translation += entity.GetComponent<Hazel::TransformComponent>().Translation;
+		}
+		float internalCall = timer.ElapsedMillis() * 1e6f / (float)queries.size();
+		checksum += (uint64_t)translation.x;
+
+		results.Rows.push_back({ std::to_string(entityCount), fmt::format("{0:.1f}", unorderedMapLookup), fmt::format("{0:.1f}", flatHashMapLookup),
+			fmt::format("{0:.1f}", internalCall) });
+	}
+
+	results.Notes.push_back(fmt::format("Checksum: {0}", checksum));
+	return results;
+}
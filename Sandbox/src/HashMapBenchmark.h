@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Compares UUID lookups in std::unordered_map and FlatHashMap, and times the core of a typical
+// script internal call (TransformComponent_GetTranslation without the managed transition)
+class HashMapBenchmark : public Benchmark
+{
+public:
+	HashMapBenchmark();
+	virtual ~HashMapBenchmark() = default;
+protected:
+	virtual BenchmarkResults Run() override;
+	virtual void OnSettingsImGuiRender() override;
+private:
+	int m_LookupCount = 1 << 22;
+};
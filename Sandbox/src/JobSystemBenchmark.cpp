@@ -0,0 +1,79 @@
+#include "JobSystemBenchmark.h"
+#include <imgui/imgui.h>
+
+#include "XingXing/Core/Timer.h"
+
+#include <thread>
+
+JobSystemBenchmark::JobSystemBenchmark()
+	: Benchmark("JobSystemBenchmark", "Job System Benchmark")
+{
+}
+
+void JobSystemBenchmark::OnSettingsImGuiRender()
+{
+	ImGui::Text("Workers: %d", Hazel::JobSystem::GetWorkerCount());
+	ImGui::DragInt("Elements", &m_ElementCount, 1024.0f, 1024, 1 << 24);
+	ImGui::DragInt("Grain Size", &m_GrainSize, 64.0f, 64, 1 << 20);
+	ImGui::SliderInt("Iterations", &m_Iterations, 1, 512);
+	ImGui::SliderInt("Repetitions", &m_Repetitions, 1, 20);
+}
+
+float JobSystemBenchmark::RunKernel()
+{
+	HZ_PROFILE_FUNCTION();
+
+	for (size_t i = 0; i < m_Data.size(); i++)
+		m_Data[i] = (float)i * 0.001f;
+
+	Hazel::Timer timer;
+	Hazel::JobSystem::ParallelFor((uint32_t)m_Data.size(), (uint32_t)m_GrainSize, [this](uint32_t begin, uint32_t end)
+	{
+		for (uint32_t i = begin; i < end; i++)
+		{
+			float value = m_Data[i];
+			for (int iteration = 0; iteration < m_Iterations; iteration++)
+				value = std::sin(value) * 0.5f + std::sqrt(std::abs(value) + 1.0f);
+			m_Data[i] = value;
+		}
+	});
+	return timer.ElapsedMillis();
+}
+
+BenchmarkResults JobSystemBenchmark::Run()
+{
+	HZ_PROFILE_FUNCTION();
+
+	BenchmarkResults results;
+	results.Columns = { "Workers", "Time (ms)", "Speedup" };
+
+	m_Data.resize((size_t)m_ElementCount);
+
+	// The pool is rebuilt for every worker count, it is idle between frames so this is safe
+	uint32_t maxWorkers = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+	float baseline = 0.0f;
+	for (uint32_t workerCount = 0; workerCount <= maxWorkers; workerCount = workerCount == 0 ? 1 : workerCount * 2)
+	{
+		Hazel::JobSystem::Shutdown();
+		if (workerCount > 0)
+			Hazel::JobSystem::Init(workerCount);
+
+		// Best of the repetitions
+		float time = FLT_MAX;
+		for (int repetition = 0; repetition < m_Repetitions; repetition++)
+			time = std::min(time, RunKernel());
+
+		if (workerCount == 0)
+			baseline = time;
+		results.Rows.push_back({ std::to_string(workerCount), fmt::format("{0:.3f}", time), fmt::format("{0:.2f}x", baseline / time) });
+	}
+
+	float checksum = 0.0f;
+	for (float value : m_Data)
+		checksum += value;
+	results.Notes.push_back(fmt::format("Checksum: {0}", checksum));
+
+	Hazel::JobSystem::Shutdown();
+	Hazel::JobSystem::Init();
+	return results;
+}
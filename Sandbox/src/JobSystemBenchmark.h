@@ -0,0 +1,24 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Runs a compute kernel through JobSystem::ParallelFor with an increasing number of workers
+// and reports the speedup over running it on the main thread alone
+class JobSystemBenchmark : public Benchmark
+{
+public:
+	JobSystemBenchmark();
+	virtual ~JobSystemBenchmark() = default;
+protected:
+	virtual BenchmarkResults Run() override;
+	virtual void OnSettingsImGuiRender() override;
+private:
+	float RunKernel();
+private:
+	int m_ElementCount = 1 << 20;
+	int m_GrainSize = 4096;
+	int m_Iterations = 64;
+	int m_Repetitions = 5;
+
+	std::vector<float> m_Data;
+};
@@ -0,0 +1,122 @@
+#include "NativeSystemBenchmark.h"
+#include <imgui/imgui.h>
+
+#include "XingXing/Core/Timer.h"
+
+namespace {
+
+	struct MoverComponent
+	{
+		glm::vec3 Velocity{ 1.0f, 0.5f, 0.0f };
+	};
+
+	class MoverScript : public Hazel::ScriptableEntity
+	{
+	protected:
+		virtual void OnUpdate(Hazel::Timestep ts) override
+		{
+			GetComponent<Hazel::TransformComponent>().Translation += m_Velocity * (float)ts;
+		}
+	private:
+		glm::vec3 m_Velocity{ 1.0f, 0.5f, 0.0f };
+	};
+
+}
+
+NativeSystemBenchmark::NativeSystemBenchmark()
+	: Benchmark("NativeSystemBenchmark", "Native System Benchmark")
+{
+}
+
+void NativeSystemBenchmark::OnSettingsImGuiRender()
+{
+	ImGui::DragInt("Entities", &m_EntityCount, 1000.0f, 1000, 1000000);
+	ImGui::DragInt("Frames", &m_FrameCount, 1.0f, 1, 1000);
+}
+
+BenchmarkResults NativeSystemBenchmark::Run()
+{
+	HZ_PROFILE_FUNCTION();
+
+	BenchmarkResults results;
+	results.Columns = { "Update", "Runtime start (ms)", "Per frame (ms)", "Runtime stop (ms)" };
+	float checksum = 0.0f;
+
+	const Hazel::Timestep ts = 1.0f / 60.0f;
+
+	// addSystems registers the scene's native systems, setup adds the components of each entity.
+	// system is the name of the system whose time is measured.
+	auto measure = [&](const char* name, const char* system, auto addSystems, auto setup)
+	{
+		Hazel::Scene scene;
+		addSystems(scene);
+		for (int i = 0; i < m_EntityCount; i++)
+			setup(scene.CreateEntity());
+
+		Hazel::Timer timer;
+		scene.OnRuntimeStart();
+		float start = timer.ElapsedMillis();
+
+		float update = 0.0f;
+		for (int frame = 0; frame < m_FrameCount; frame++)
+		{
+			scene.OnUpdateRuntime(ts);
+			for (const auto& scheduled : scene.GetSystemScheduler().GetSystems())
+			{
+				if (scheduled.Name == system)
+					update += scheduled.Timing.Duration;
+			}
+		}
+		update /= m_FrameCount;
+
+		auto view = scene.GetAllEntitiesWith<Hazel::TransformComponent>();
+		for (auto entity : view)
+			checksum += view.get(entity).Translation.x;
+
+		timer.Reset();
+		scene.OnRuntimeStop();
+		float stop = timer.ElapsedMillis();
+
+		results.Rows.push_back({ name, fmt::format("{0:.3f}", start), fmt::format("{0:.3f}", update), fmt::format("{0:.3f}", stop) });
+	};
+
+	measure("NativeScriptComponent", "Native Scripts",
+		[](Hazel::Scene& scene) {},
+		[](Hazel::Entity entity)
+		{
+			entity.AddComponent<Hazel::NativeScriptComponent>().Bind<MoverScript>();
+		});
+
+	measure("Native system", "Movers",
+		[](Hazel::Scene& scene)
+		{
+			scene.AddNativeSystem<Hazel::TransformComponent, MoverComponent>("Movers", [](auto view, Hazel::Timestep ts)
+			{
+				view.each([ts](auto entity, Hazel::TransformComponent& transform, MoverComponent& mover)
+				{
+					transform.Translation += mover.Velocity * (float)ts;
+				});
+			});
+		},
+		[](Hazel::Entity entity)
+		{
+			entity.AddComponent<MoverComponent>();
+		});
+
+	measure("Parallel native system", "Movers",
+		[](Hazel::Scene& scene)
+		{
+			scene.AddParallelNativeSystem<MoverComponent, Hazel::TransformComponent>("Movers", 4096,
+				[](entt::entity entity, MoverComponent& mover, Hazel::TransformComponent& transform, Hazel::Timestep ts)
+			{
+				transform.Translation += mover.Velocity * (float)ts;
+			});
+		},
+		[](Hazel::Entity entity)
+		{
+			entity.AddComponent<MoverComponent>();
+		});
+
+	results.Notes.push_back(fmt::format("Checksum: {0:.1f}", checksum));
+	return results;
+}
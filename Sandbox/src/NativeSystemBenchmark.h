@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Moves 100k entities by their velocity every frame, once through a ScriptableEntity per entity,
+// once as a native system over a component view and once as a parallel native system
+class NativeSystemBenchmark : public Benchmark
+{
+public:
+	NativeSystemBenchmark();
+	virtual ~NativeSystemBenchmark() = default;
+protected:
+	virtual BenchmarkResults Run() override;
+	virtual void OnSettingsImGuiRender() override;
+private:
+	int m_EntityCount = 100000;
+	int m_FrameCount = 60;
+};
@@ -0,0 +1,75 @@
+#include "PrefabBenchmark.h"
+
+#include "XingXing/Core/Timer.h"
+
+PrefabBenchmark::PrefabBenchmark()
+	: Benchmark("PrefabBenchmark", "Prefab Benchmark")
+{
+}
+
+void PrefabBenchmark::OnAttach()
+{
+	HZ_PROFILE_FUNCTION();
+
+	// An enemy: sprite, collision and a marker circle
+	Hazel::Scene scene;
+	Hazel::Entity enemy = scene.CreateEntity("Enemy");
+	enemy.AddComponent<Hazel::SpriteRendererComponent>(glm::vec4{ 0.8f, 0.2f, 0.3f, 1.0f });
+	enemy.AddComponent<Hazel::CircleRendererComponent>();
+	enemy.AddComponent<Hazel::Rigidbody2DComponent>().Type = Hazel::Rigidbody2DComponent::BodyType::Dynamic;
+	enemy.AddComponent<Hazel::BoxCollider2DComponent>();
+	enemy.AddComponent<Hazel::TextComponent>().TextString = "Enemy";
+	m_Prefab = Hazel::Prefab::Create(enemy);
+}
+
+void PrefabBenchmark::OnDetach()
+{
+	HZ_PROFILE_FUNCTION();
+
+	m_Prefab = nullptr;
+}
+
+BenchmarkResults PrefabBenchmark::Run()
+{
+	HZ_PROFILE_FUNCTION();
+
+	BenchmarkResults results;
+	results.Columns = { "Entities", "AddComponent (ms)", "Prefab (ms)" };
+
+	const uint32_t entityCounts[] = { 100, 500, 1000, 10000 };
+	for (uint32_t entityCount : entityCounts)
+	{
+		std::vector<glm::vec3> translations(entityCount);
+		for (uint32_t i = 0; i < entityCount; i++)
+			translations[i] = { (float)(i % 100), (float)(i / 100), 0.0f };
+
+		float addComponentTime = 0.0f;
+		{
+			Hazel::Scene scene;
+			Hazel::Timer timer;
+			for (uint32_t i = 0; i < entityCount; i++)
+			{
+				Hazel::Entity entity = scene.CreateEntity("Enemy");
+				entity.GetComponent<Hazel::TransformComponent>().Translation = translations[i];
+				entity.AddComponent<Hazel::SpriteRendererComponent>(glm::vec4{ 0.8f, 0.2f, 0.3f, 1.0f });
+				entity.AddComponent<Hazel::CircleRendererComponent>();
+				entity.AddComponent<Hazel::Rigidbody2DComponent>().Type = Hazel::Rigidbody2DComponent::BodyType::Dynamic;
+				entity.AddComponent<Hazel::BoxCollider2DComponent>();
+				entity.AddComponent<Hazel::TextComponent>().TextString = "Enemy";
+			}
+			addComponentTime = timer.ElapsedMillis();
+		}
+
+		float prefabTime = 0.0f;
+		{
+			Hazel::Scene scene;
+			Hazel::Timer timer;
+			scene.InstantiatePrefab(m_Prefab, translations.data(), entityCount);
+			prefabTime = timer.ElapsedMillis();
+		}
+
+		results.Rows.push_back({ std::to_string(entityCount), fmt::format("{0:.3f}", addComponentTime), fmt::format("{0:.3f}", prefabTime) });
+	}
+
+	return results;
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Times spawning waves of multi-component entities, once with CreateEntity/AddComponent per
+// entity and once as a single bulk prefab instantiation
+class PrefabBenchmark : public Benchmark
+{
+public:
+	PrefabBenchmark();
+	virtual ~PrefabBenchmark() = default;
+
+	virtual void OnAttach() override;
+	virtual void OnDetach() override;
+protected:
+	virtual BenchmarkResults Run() override;
+private:
+	Hazel::Ref<Hazel::Prefab> m_Prefab;
+};
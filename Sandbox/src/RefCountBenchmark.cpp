@@ -0,0 +1,126 @@
+#include "RefCountBenchmark.h"
+#include <imgui/imgui.h>
+
+#include "XingXing/Core/Timer.h"
+#include "XingXing/Core/ObjectPool.h"
+
+namespace {
+
+	struct SharedScriptClass
+	{
+		void* MonoClass = nullptr;
+	};
+
+	// ScriptInstance before it was pooled and intrusively counted
+	struct SharedScriptInstance
+	{
+		std::shared_ptr<SharedScriptClass> ScriptClass;
+		void* Methods[5] = {};
+	};
+
+	struct IntrusiveScriptClass : public Hazel::RefCounted
+	{
+		void* MonoClass = nullptr;
+	};
+
+	struct IntrusiveScriptInstance : public Hazel::RefCounted
+	{
+		Hazel::IntrusiveRef<IntrusiveScriptClass> ScriptClass;
+		void* Methods[5] = {};
+
+		static void* operator new(size_t size) { return Hazel::ObjectPool<IntrusiveScriptInstance>::Get().Allocate(); }
+		static void operator delete(void* instance) { Hazel::ObjectPool<IntrusiveScriptInstance>::Get().Free(instance); }
+	};
+
+	// Passed by value on purpose, like the Ref parameters it stands in for
+	template<typename RefType>
+	uint64_t Touch(RefType instance)
+	{
+		return (uint64_t)(uintptr_t)instance->Methods[0] + 1;
+	}
+
+}
+
+RefCountBenchmark::RefCountBenchmark()
+	: Benchmark("RefCountBenchmark", "Ref Count Benchmark")
+{
+}
+
+void RefCountBenchmark::OnSettingsImGuiRender()
+{
+	ImGui::DragInt("Instances", &m_InstanceCount, 1000.0f, 1000, 10000000);
+}
+
+BenchmarkResults RefCountBenchmark::Run()
+{
+	HZ_PROFILE_FUNCTION();
+
+	BenchmarkResults results;
+	results.Columns = { "Ref", "Create (ms)", "Copy x10 (ms)", "Destroy (ms)", "Heap allocations" };
+	uint64_t checksum = 0;
+
+	const uint32_t instanceCount = (uint32_t)m_InstanceCount;
+
+	// Create stores every instance by entity ID, Copy passes each by value ten times, Destroy erases them
+	auto measure = [&](const char* name, auto createInstance)
+	{
+		using RefType = decltype(createInstance());
+
+		Hazel::FlatHashMap<Hazel::UUID, RefType> instances;
+		std::vector<Hazel::UUID> ids(instanceCount);
+		instances.reserve(instanceCount);
+
+		uint64_t allocations = Hazel::AllocationTracker::GetAllocationCount();
+		Hazel::Timer timer;
+		for (uint32_t i = 0; i < instanceCount; i++)
+			instances[ids[i]] = createInstance();
+		float create = timer.ElapsedMillis();
+		uint64_t heapAllocations = Hazel::AllocationTracker::GetAllocationCount() - allocations;
+
+		timer.Reset();
+		for (uint32_t pass = 0; pass < 10; pass++)
+		{
+			for (Hazel::UUID id : ids)
+				checksum += Touch(instances[id]);
+		}
+		float copy = timer.ElapsedMillis();
+
+		timer.Reset();
+		for (Hazel::UUID id : ids)
+			instances.erase(id);
+		float destroy = timer.ElapsedMillis();
+
+		results.Rows.push_back({ name, fmt::format("{0:.3f}", create), fmt::format("{0:.3f}", copy), fmt::format("{0:.3f}", destroy),
+			std::to_string(heapAllocations) });
+	};
+
+	// A handful of classes shared by all instances, as in a typical scene
+	auto sharedClass = std::make_shared<SharedScriptClass>();
+	measure("std::make_shared", [&]()
+	{
+		auto instance = std::make_shared<SharedScriptInstance>();
+		instance->ScriptClass = sharedClass;
+		return instance;
+	});
+
+	Hazel::IntrusiveRef<IntrusiveScriptClass> intrusiveClass(new IntrusiveScriptClass());
+	measure("Pooled IntrusiveRef", [&]()
+	{
+		Hazel::IntrusiveRef<IntrusiveScriptInstance> instance(new IntrusiveScriptInstance());
+		instance->ScriptClass = intrusiveClass;
+		return instance;
+	});
+
+	// Second round reuses the pool slots freed by the first
+	measure("Pooled IntrusiveRef (warm)", [&]()
+	{
+		Hazel::IntrusiveRef<IntrusiveScriptInstance> instance(new IntrusiveScriptInstance());
+		instance->ScriptClass = intrusiveClass;
+		return instance;
+	});
+
+	if (!Hazel::AllocationTracker::IsEnabled())
+		results.Notes.push_back("Allocation tracking is disabled, heap allocation counts read 0");
+	results.Notes.push_back(fmt::format("Checksum: {0}", checksum));
+	return results;
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Benchmark.h"
+
+// Creates and destroys script instances the way ScriptEngine does on entity creation and destruction,
+// once as std::shared_ptr from std::make_shared and once as pooled IntrusiveRef. The instances are
+// stand-ins with the layout of ScriptInstance; the managed objects a real instance creates are not included.
+class RefCountBenchmark : public Benchmark
+{
+public:
+	RefCountBenchmark();
+	virtual ~RefCountBenchmark() = default;
+protected:
+	virtual BenchmarkResults Run() override;
+	virtual void OnSettingsImGuiRender() override;
+private:
+	int m_InstanceCount = 100000;
+};
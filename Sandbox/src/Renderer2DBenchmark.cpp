@@ -0,0 +1,144 @@
+#include "Renderer2DBenchmark.h"
+#include <imgui/imgui.h>
+
+#include "XingXing/Core/Timer.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+Renderer2DBenchmark::Renderer2DBenchmark()
+	: Layer("Renderer2DBenchmark"), m_CameraController(1280.0f / 720.0f)
+{
+}
+
+void Renderer2DBenchmark::OnAttach()
+{
+	HZ_PROFILE_FUNCTION();
+
+	m_CheckerboardTexture = Hazel::Texture2D::Create("assets/textures/Checkerboard.png");
+	m_Font = Hazel::Font::GetDefault();
+}
+
+void Renderer2DBenchmark::OnDetach()
+{
+	HZ_PROFILE_FUNCTION();
+
+	Hazel::Renderer2D::SetUnifiedPipelineEnabled(false);
+}
+
+void Renderer2DBenchmark::OnUpdate(Hazel::Timestep ts)
+{
+	HZ_PROFILE_FUNCTION();
+
+	m_CameraController.OnUpdate(ts);
+
+	Hazel::Renderer2D::ResetStats();
+	Hazel::RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
+	Hazel::RenderCommand::Clear();
+
+	Hazel::Renderer2D::SetUnifiedPipelineEnabled(m_Mode == Unified);
+
+	Hazel::Timer timer;
+	{
+		HZ_PROFILE_SCOPE("Renderer2DBenchmark Draw");
+
+		Hazel::Renderer2D::BeginScene(m_CameraController.GetCamera());
+
+		// Every cell cycles through sprite, circle and text, so each primitive type is interleaved
+		// with the others and depth increases in submission order
+		Hazel::Renderer2D::TextParams textParams;
+		const float cellSize = 2.0f / (float)m_GridSize;
+		const float depthStep = 0.5f / (float)(m_GridSize * m_GridSize);
+		for (int y = 0; y < m_GridSize; y++)
+		{
+			for (int x = 0; x < m_GridSize; x++)
+			{
+				int index = y * m_GridSize + x;
+				glm::vec3 position = { (x - m_GridSize * 0.5f) * cellSize, (y - m_GridSize * 0.5f) * cellSize, index * depthStep };
+				glm::vec4 color = { (float)x / m_GridSize, 0.4f, (float)y / m_GridSize, 1.0f };
+
+				glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
+					* glm::scale(glm::mat4(1.0f), { cellSize * 0.9f, cellSize * 0.9f, 1.0f });
+
+				switch (index % 3)
+				{
+					case 0: Hazel::Renderer2D::DrawQuad(transform, m_CheckerboardTexture, 1.0f, color); break;
+					case 1: Hazel::Renderer2D::DrawCircle(transform, color); break;
+					case 2:
+						textParams.Color = color;
+						Hazel::Renderer2D::DrawString("Hz", m_Font, transform, textParams);
+						break;
+				}
+			}
+		}
+
+		Hazel::Renderer2D::EndScene();
+	}
+
+	m_SubmitTimeAccumulator += timer.ElapsedMillis();
+	m_FrameTimeAccumulator += ts.GetMilliseconds();
+	m_FrameIndex++;
+
+	if (m_FrameIndex >= m_SampleFrames)
+	{
+		Result& result = m_Results[m_Mode];
+		result.SubmitTime = m_SubmitTimeAccumulator / (float)m_FrameIndex;
+		result.FrameTime = m_FrameTimeAccumulator / (float)m_FrameIndex;
+		result.DrawCalls = Hazel::Renderer2D::GetStats().DrawCalls;
+
+		// Measured frame by frame rather than in one run, so each sample is logged as it completes
+		HZ_INFO("Renderer2D Benchmark: {0} pipeline, {1} draw calls, submit {2:.3f} ms, frame {3:.3f} ms",
+			m_Mode == Unified ? "unified" : "separate", result.DrawCalls, result.SubmitTime, result.FrameTime);
+
+		m_FrameIndex = 0;
+		m_SubmitTimeAccumulator = 0.0f;
+		m_FrameTimeAccumulator = 0.0f;
+
+		if (m_AutoSwitch)
+			m_Mode = m_Mode == Separate ? Unified : Separate;
+	}
+}
+
+void Renderer2DBenchmark::OnImGuiRender()
+{
+	HZ_PROFILE_FUNCTION();
+
+	ImGui::Begin("Renderer2D Benchmark");
+
+	ImGui::SliderInt("Grid Size", &m_GridSize, 10, 200);
+	ImGui::SliderInt("Sample Frames", &m_SampleFrames, 10, 600);
+	ImGui::Checkbox("Alternate Pipelines", &m_AutoSwitch);
+	if (!m_AutoSwitch)
+	{
+		int mode = (int)m_Mode;
+		ImGui::RadioButton("Separate", &mode, Separate); ImGui::SameLine();
+		ImGui::RadioButton("Unified", &mode, Unified);
+		m_Mode = (Mode)mode;
+	}
+
+	auto stats = Hazel::Renderer2D::GetStats();
+	ImGui::Text("Current: %s, %d primitives", m_Mode == Unified ? "Unified" : "Separate", stats.QuadCount);
+
+	ImGui::Separator();
+	ImGui::Columns(4);
+	ImGui::Text("Pipeline");   ImGui::NextColumn();
+	ImGui::Text("Draw Calls"); ImGui::NextColumn();
+	ImGui::Text("Submit (ms)"); ImGui::NextColumn();
+	ImGui::Text("Frame (ms)"); ImGui::NextColumn();
+
+	const char* names[] = { "Separate", "Unified" };
+	for (int i = 0; i < 2; i++)
+	{
+		ImGui::Text("%s", names[i]); ImGui::NextColumn();
+		ImGui::Text("%d", m_Results[i].DrawCalls); ImGui::NextColumn();
+		ImGui::Text("%.3f", m_Results[i].SubmitTime); ImGui::NextColumn();
+		ImGui::Text("%.3f", m_Results[i].FrameTime); ImGui::NextColumn();
+	}
+	ImGui::Columns(1);
+
+	ImGui::End();
+}
+
+void Renderer2DBenchmark::OnEvent(Hazel::Event& e)
+{
+	m_CameraController.OnEvent(e);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "xingxing.h"
+
+// Draws interleaved sprites, circles and text and alternates between the per-primitive
+// pipelines and the unified pipeline, averaging the cost of each over a number of frames
+class Renderer2DBenchmark : public Hazel::Layer
+{
+public:
+	Renderer2DBenchmark();
+	virtual ~Renderer2DBenchmark() = default;
+
+	virtual void OnAttach() override;
+	virtual void OnDetach() override;
+
+	void OnUpdate(Hazel::Timestep ts) override;
+	virtual void OnImGuiRender() override;
+	void OnEvent(Hazel::Event& e) override;
+private:
+	struct Result
+	{
+		float SubmitTime = 0.0f; // ms, Renderer2D calls including Flush
+		float FrameTime = 0.0f; // ms
+		uint32_t DrawCalls = 0;
+	};
+
+	enum Mode { Separate = 0, Unified = 1 };
+private:
+	Hazel::OrthographicCameraController m_CameraController;
+	Hazel::Ref<Hazel::Texture2D> m_CheckerboardTexture;
+	Hazel::Ref<Hazel::Font> m_Font;
+
+	int m_GridSize = 60;
+	int m_SampleFrames = 120;
+	bool m_AutoSwitch = true;
+
+	Mode m_Mode = Separate;
+	int m_FrameIndex = 0;
+	float m_SubmitTimeAccumulator = 0.0f;
+	float m_FrameTimeAccumulator = 0.0f;
+	Result m_Results[2];
+};
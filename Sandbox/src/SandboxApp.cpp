@@ -3,6 +3,72 @@
 
 #include "Sandbox2D.h"
 #include "ExampleLayer.h"
+#include "Renderer2DBenchmark.h"
+#include "SpriteAtlasExample.h"
+#include "JobSystemBenchmark.h"
+#include "HashMapBenchmark.h"
+#include "EntityCommandBufferBenchmark.h"
+#include "PrefabBenchmark.h"
+#include "ComponentLayoutBenchmark.h"
+#include "FrameAllocatorBenchmark.h"
+#include "RefCountBenchmark.h"
+#include "NativeSystemBenchmark.h"
+
+namespace Utils {
+
+	template<typename T>
+	static Hazel::Layer* CreateBenchmark()
+	{
+		T* benchmark = new T();
+		if constexpr (std::is_base_of_v<Benchmark, T>)
+			benchmark->RequestRun();
+		return benchmark;
+	}
+
+	struct BenchmarkEntry
+	{
+		const char* Name;
+		Hazel::Layer* (*Create)();
+	};
+
+	static const BenchmarkEntry s_Benchmarks[] =
+	{
+		{ "Renderer2D",           CreateBenchmark<Renderer2DBenchmark> },
+		{ "JobSystem",            CreateBenchmark<JobSystemBenchmark> },
+		{ "HashMap",              CreateBenchmark<HashMapBenchmark> },
+		{ "EntityCommandBuffer",  CreateBenchmark<EntityCommandBufferBenchmark> },
+		{ "Prefab",               CreateBenchmark<PrefabBenchmark> },
+		{ "ComponentLayout",      CreateBenchmark<ComponentLayoutBenchmark> },
+		{ "FrameAllocator",       CreateBenchmark<FrameAllocatorBenchmark> },
+		{ "RefCount",             CreateBenchmark<RefCountBenchmark> },
+		{ "NativeSystem",         CreateBenchmark<NativeSystemBenchmark> },
+	};
+
+	// "--benchmark <name>" picks a benchmark to run instead of Sandbox2D. Returns nullptr without one.
+	static Hazel::Layer* CreateBenchmarkFromCommandLine(const Hazel::ApplicationCommandLineArgs& args)
+	{
+		for (int i = 1; i + 1 < args.Count; i++)
+		{
+			if (std::string_view(args[i]) != "--benchmark")
+				continue;
+
+			std::string_view name = args[i + 1];
+			for (const BenchmarkEntry& entry : s_Benchmarks)
+			{
+				if (name == entry.Name)
+					return entry.Create();
+			}
+
+			std::string names;
+			for (const BenchmarkEntry& entry : s_Benchmarks)
+				names += std::string(names.empty() ? "" : ", ") + entry.Name;
+			HZ_ERROR("Unknown benchmark '{0}', the benchmarks are: {1}", name, names);
+		}
+
+		return nullptr;
+	}
+
+}
 
 class Sandbox : public Hazel::Application
 {
@@ -11,7 +77,11 @@ public:
 		: Hazel::Application(specification)
 	{
 		// PushLayer(new ExampleLayer());
-		PushLayer(new Sandbox2D());
+		// PushLayer(new SpriteAtlasExample());
+		if (Hazel::Layer* benchmark = Utils::CreateBenchmarkFromCommandLine(specification.CommandLineArgs))
+			PushLayer(benchmark);
+		else
+			PushLayer(new Sandbox2D());
 	}
 
 	~Sandbox()
@@ -0,0 +1,105 @@
+#include "SpriteAtlasExample.h"
+#include <imgui/imgui.h>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+SpriteAtlasExample::SpriteAtlasExample()
+	: Layer("SpriteAtlasExample"), m_CameraController(1280.0f / 720.0f)
+{
+}
+
+void SpriteAtlasExample::OnAttach()
+{
+	HZ_PROFILE_FUNCTION();
+
+	Hazel::TextureAtlasSpecification atlasSpec;
+	atlasSpec.PageSize = 512;
+	m_Atlas = Hazel::CreateScope<Hazel::TextureAtlas>(atlasSpec);
+
+	// Every sprite gets its own small image with a distinct size and pattern
+	std::vector<uint32_t> pixels;
+	for (uint32_t i = 0; i < SpriteCount; i++)
+	{
+		uint32_t width = 8 + (i * 7) % 25;
+		uint32_t height = 8 + (i * 13) % 25;
+		pixels.resize(width * height);
+
+		uint8_t r = (uint8_t)(i * 37), g = (uint8_t)(i * 91), b = (uint8_t)(255 - i);
+		for (uint32_t y = 0; y < height; y++)
+		{
+			for (uint32_t x = 0; x < width; x++)
+			{
+				bool checker = ((x / 4) + (y / 4)) % 2 == 0;
+				uint8_t shade = checker ? 255 : 160;
+				pixels[y * width + x] = 0xff000000 | ((b * shade / 255) << 16) | ((g * shade / 255) << 8) | (r * shade / 255);
+			}
+		}
+
+		Hazel::TextureSpecification spec;
+		spec.Width = width;
+		spec.Height = height;
+		spec.GenerateMips = false;
+		Hazel::Ref<Hazel::Texture2D> texture = Hazel::Texture2D::Create(spec);
+		texture->SetData(pixels.data(), width * height * 4);
+		m_Textures.push_back(texture);
+
+		m_Atlas->Add("Sprite" + std::to_string(i), width, height, pixels.data());
+	}
+
+	m_Atlas->Build();
+	for (uint32_t i = 0; i < SpriteCount; i++)
+		m_SubTextures.push_back(m_Atlas->GetSubTexture("Sprite" + std::to_string(i)));
+}
+
+void SpriteAtlasExample::OnDetach()
+{
+	HZ_PROFILE_FUNCTION();
+}
+
+void SpriteAtlasExample::OnUpdate(Hazel::Timestep ts)
+{
+	HZ_PROFILE_FUNCTION();
+
+	m_CameraController.OnUpdate(ts);
+
+	Hazel::Renderer2D::ResetStats();
+	Hazel::RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
+	Hazel::RenderCommand::Clear();
+
+	Hazel::Renderer2D::BeginScene(m_CameraController.GetCamera());
+
+	const uint32_t columns = 20;
+	const float cellSize = 0.15f;
+	for (uint32_t i = 0; i < SpriteCount; i++)
+	{
+		glm::vec2 position = { ((i % columns) - columns * 0.5f) * cellSize, ((i / columns) - SpriteCount / columns * 0.5f) * cellSize };
+		glm::vec2 size = { cellSize * 0.9f, cellSize * 0.9f };
+
+		if (m_UseAtlas)
+			Hazel::Renderer2D::DrawQuad(position, size, m_SubTextures[i]);
+		else
+			Hazel::Renderer2D::DrawQuad(position, size, m_Textures[i]);
+	}
+
+	Hazel::Renderer2D::EndScene();
+
+	m_DrawCalls[m_UseAtlas ? 1 : 0] = Hazel::Renderer2D::GetStats().DrawCalls;
+}
+
+void SpriteAtlasExample::OnImGuiRender()
+{
+	HZ_PROFILE_FUNCTION();
+
+	ImGui::Begin("Sprite Atlas");
+	ImGui::Checkbox("Use Atlas", &m_UseAtlas);
+	ImGui::Text("Sprites: %d", SpriteCount);
+	ImGui::Text("Atlas Pages: %d", (int)m_Atlas->GetPages().size());
+	ImGui::Text("Draw Calls (separate textures): %d", m_DrawCalls[0]);
+	ImGui::Text("Draw Calls (atlas): %d", m_DrawCalls[1]);
+	ImGui::End();
+}
+
+void SpriteAtlasExample::OnEvent(Hazel::Event& e)
+{
+	m_CameraController.OnEvent(e);
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "xingxing.h"
+
+#include "XingXing/Renderer/TextureAtlas.h"
+
+// Draws 300 distinct small sprites either as separate textures or from a runtime atlas,
+// to compare the number of draw calls
+class SpriteAtlasExample : public Hazel::Layer
+{
+public:
+	SpriteAtlasExample();
+	virtual ~SpriteAtlasExample() = default;
+
+	virtual void OnAttach() override;
+	virtual void OnDetach() override;
+
+	void OnUpdate(Hazel::Timestep ts) override;
+	virtual void OnImGuiRender() override;
+	void OnEvent(Hazel::Event& e) override;
+private:
+	static constexpr uint32_t SpriteCount = 300;
+
+	Hazel::OrthographicCameraController m_CameraController;
+
+	std::vector<Hazel::Ref<Hazel::Texture2D>> m_Textures;
+	std::vector<Hazel::Ref<Hazel::SubTexture2D>> m_SubTextures;
+	Hazel::Scope<Hazel::TextureAtlas> m_Atlas;
+
+	bool m_UseAtlas = true;
+	uint32_t m_DrawCalls[2] = { 0, 0 };
+};
@@ -11,9 +11,26 @@ namespace Hazel
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
 		internal extern static ulong Entity_FindEntityByName(string name);
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static ulong Entity_Instantiate(ulong sourceID, ref Vector3 translation, bool overrideTranslation);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void Entity_Destroy(ulong entityID);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static bool Entity_IsActive(ulong entityID);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void Entity_SetActive(ulong entityID, bool active);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
 		internal extern static object GetScriptInstance(ulong entityID);
 		#endregion
 
+		#region Prefab
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static ulong Prefab_Load(string path);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static ulong Prefab_Instantiate(ulong prefabID, ref Vector3 translation, bool overrideTranslation);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static void Prefab_InstantiateMany(ulong prefabID, Vector3[] translations);
+		#endregion
+
 		#region TransformComponent
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
 		internal extern static void TransformComponent_GetTranslation(ulong entityID, out Vector3 translation);
@@ -75,6 +92,17 @@ namespace Hazel
 		internal extern static void TextComponent_SetLineSpacing(ulong entityID, float lineSpacing);
 		#endregion
 
+		#region Scene
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static ulong[] Scene_QueryAABB(ref Vector2 min, ref Vector2 max);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static ulong[] Scene_QueryRadius(ref Vector2 center, float radius);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static ulong[] Scene_QueryPoint(ref Vector2 point);
+		[MethodImplAttribute(MethodImplOptions.InternalCall)]
+		internal extern static ulong[] Scene_QueryNearest(ref Vector2 point, int count);
+		#endregion
+
 		#region Input
 		[MethodImplAttribute(MethodImplOptions.InternalCall)]
 		internal extern static bool Input_IsKeyDown(KeyCode keycode);
@@ -89,6 +89,11 @@ namespace Hazel
 		// C++ 原生脚本组件
 	}
 
+	public class UpdateLODComponent : Component
+	{
+		// Configured in the editor, scripts only check for it
+	}
+
 	// === 补全：物理碰撞体 ===
 	public class BoxCollider2DComponent : Component
 	{
@@ -27,6 +27,13 @@ namespace Hazel
 			}
 		}
 
+		// Disabled entities are not updated, rendered or simulated, but keep their state
+		public bool IsActive
+		{
+			get => InternalCalls.Entity_IsActive(ID);
+			set => InternalCalls.Entity_SetActive(ID, value);
+		}
+
 		public bool HasComponent<T>() where T : Component, new()
 		{
 			Type componentType = typeof(T);
@@ -51,6 +58,26 @@ namespace Hazel
 			return new Entity(entityID);
 		}
 
+		// The copy is created at the scene's next sync point, until then it can't be accessed.
+		public Entity Instantiate(Entity original)
+		{
+			Vector3 translation = Vector3.Zero;
+			ulong entityID = InternalCalls.Entity_Instantiate(original.ID, ref translation, false);
+			return new Entity(entityID);
+		}
+
+		public Entity Instantiate(Entity original, Vector3 translation)
+		{
+			ulong entityID = InternalCalls.Entity_Instantiate(original.ID, ref translation, true);
+			return new Entity(entityID);
+		}
+
+		// Destroyed at the scene's next sync point
+		public void Destroy(Entity entity)
+		{
+			InternalCalls.Entity_Destroy(entity.ID);
+		}
+
 		public T As<T>() where T : Entity, new()
 		{
 			object instance = InternalCalls.GetScriptInstance(ID);
@@ -0,0 +1,44 @@
+using System;
+
+namespace Hazel
+{
+	public class Prefab
+	{
+		internal Prefab(ulong id)
+		{
+			ID = id;
+		}
+
+		public readonly ulong ID;
+
+		// Path relative to the project's asset directory, loaded prefabs are cached
+		public static Prefab Load(string path)
+		{
+			ulong prefabID = InternalCalls.Prefab_Load(path);
+			if (prefabID == 0)
+				return null;
+
+			return new Prefab(prefabID);
+		}
+
+		// Instances are created at the scene's next sync point, like Entity.Instantiate
+		public Entity Instantiate()
+		{
+			Vector3 translation = Vector3.Zero;
+			ulong entityID = InternalCalls.Prefab_Instantiate(ID, ref translation, false);
+			return new Entity(entityID);
+		}
+
+		public Entity Instantiate(Vector3 translation)
+		{
+			ulong entityID = InternalCalls.Prefab_Instantiate(ID, ref translation, true);
+			return new Entity(entityID);
+		}
+
+		// One instance per translation, recorded in a single call
+		public void Instantiate(Vector3[] translations)
+		{
+			InternalCalls.Prefab_InstantiateMany(ID, translations);
+		}
+	}
+}
@@ -0,0 +1,38 @@
+using System;
+
+namespace Hazel
+{
+	// Spatial queries against the bounds of sprites, circles and colliders, in world space on the xy plane.
+	// Every query is a single call into the engine, no matter how many entities it finds.
+	public static class Scene
+	{
+		public static Entity[] QueryAABB(Vector2 min, Vector2 max)
+		{
+			return ToEntities(InternalCalls.Scene_QueryAABB(ref min, ref max));
+		}
+
+		public static Entity[] QueryRadius(Vector2 center, float radius)
+		{
+			return ToEntities(InternalCalls.Scene_QueryRadius(ref center, radius));
+		}
+
+		public static Entity[] QueryPoint(Vector2 point)
+		{
+			return ToEntities(InternalCalls.Scene_QueryPoint(ref point));
+		}
+
+		// Closest first
+		public static Entity[] QueryNearest(Vector2 point, int count)
+		{
+			return ToEntities(InternalCalls.Scene_QueryNearest(ref point, count));
+		}
+
+		private static Entity[] ToEntities(ulong[] entityIDs)
+		{
+			Entity[] entities = new Entity[entityIDs.Length];
+			for (int i = 0; i < entityIDs.Length; i++)
+				entities[i] = new Entity(entityIDs[i]);
+			return entities;
+		}
+	}
+}
@@ -1,6 +1,9 @@
 #include "hzpch.h"
 #include "Platform/OpenGL/OpenGLBuffer.h"
 
+#include "XingXing/Renderer/Renderer.h"
+#include "XingXing/Renderer/GPUResourceRegistry.h"
+
 #include <glad/glad.h>
 
 namespace Hazel {
@@ -13,18 +16,30 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glCreateBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, size, nullptr, GL_DYNAMIC_DRAW);
+		OpenGLVertexBuffer* instance = this;
+		Renderer::Submit([instance, size]()
+		{
+			glCreateBuffers(1, &instance->m_RendererID);
+			glNamedBufferData(instance->m_RendererID, size, nullptr, GL_DYNAMIC_DRAW);
+		});
+
+		GPUResourceRegistry::Track(GPUResourceCategory::VertexBuffer, this, size);
 	}
 
 	OpenGLVertexBuffer::OpenGLVertexBuffer(float* vertices, uint32_t size)
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glCreateBuffers(1, &m_RendererID);
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, size, vertices, GL_STATIC_DRAW);
+		Buffer data = Buffer::Copy(vertices, size);
+		OpenGLVertexBuffer* instance = this;
+		Renderer::Submit([instance, data]() mutable
+		{
+			glCreateBuffers(1, &instance->m_RendererID);
+			glNamedBufferData(instance->m_RendererID, data.Size, data.Data, GL_STATIC_DRAW);
+			data.Release();
+		});
+
+		GPUResourceRegistry::Track(GPUResourceCategory::VertexBuffer, this, size);
 	}
 
 	OpenGLVertexBuffer::~OpenGLVertexBuffer()
@@ -32,26 +47,41 @@ namespace Hazel {
 		HZ_PROFILE_FUNCTION();
 
 		glDeleteBuffers(1, &m_RendererID);
+
+		GPUResourceRegistry::Untrack(GPUResourceCategory::VertexBuffer, this);
 	}
 
 	void OpenGLVertexBuffer::Bind() const
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
+		const OpenGLVertexBuffer* instance = this;
+		Renderer::Submit([instance]()
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, instance->m_RendererID);
+		});
 	}
 
 	void OpenGLVertexBuffer::Unbind() const
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		Renderer::Submit([]()
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, 0);
+		});
 	}
 
 	void OpenGLVertexBuffer::SetData(const void* data, uint32_t size)
 	{
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferSubData(GL_ARRAY_BUFFER, 0, size, data);
+		// The caller's memory is reused for the next batch before the render thread gets to it
+		Buffer localData = Buffer::Copy(data, size);
+		OpenGLVertexBuffer* instance = this;
+		Renderer::Submit([instance, localData]() mutable
+		{
+			glNamedBufferSubData(instance->m_RendererID, 0, localData.Size, localData.Data);
+			localData.Release();
+		});
 	}
 
 	/////////////////////////////////////////////////////////////////////////////
@@ -63,12 +93,20 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glCreateBuffers(1, &m_RendererID);
-		
-		// GL_ELEMENT_ARRAY_BUFFER is not valid without an actively bound VAO
-		// Binding with GL_ARRAY_BUFFER allows the data to be loaded regardless of VAO state. 
-		glBindBuffer(GL_ARRAY_BUFFER, m_RendererID);
-		glBufferData(GL_ARRAY_BUFFER, count * sizeof(uint32_t), indices, GL_STATIC_DRAW);
+		Buffer data = Buffer::Copy(indices, count * sizeof(uint32_t));
+		OpenGLIndexBuffer* instance = this;
+		Renderer::Submit([instance, data]() mutable
+		{
+			glCreateBuffers(1, &instance->m_RendererID);
+
+			// GL_ELEMENT_ARRAY_BUFFER is not valid without an actively bound VAO
+			// Binding with GL_ARRAY_BUFFER allows the data to be loaded regardless of VAO state. 
+			glBindBuffer(GL_ARRAY_BUFFER, instance->m_RendererID);
+			glBufferData(GL_ARRAY_BUFFER, data.Size, data.Data, GL_STATIC_DRAW);
+			data.Release();
+		});
+
+		GPUResourceRegistry::Track(GPUResourceCategory::IndexBuffer, this, count * sizeof(uint32_t));
 	}
 
 	OpenGLIndexBuffer::~OpenGLIndexBuffer()
@@ -76,20 +114,29 @@ namespace Hazel {
 		HZ_PROFILE_FUNCTION();
 
 		glDeleteBuffers(1, &m_RendererID);
+
+		GPUResourceRegistry::Untrack(GPUResourceCategory::IndexBuffer, this);
 	}
 
 	void OpenGLIndexBuffer::Bind() const
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_RendererID);
+		const OpenGLIndexBuffer* instance = this;
+		Renderer::Submit([instance]()
+		{
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, instance->m_RendererID);
+		});
 	}
 
 	void OpenGLIndexBuffer::Unbind() const
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		Renderer::Submit([]()
+		{
+			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+		});
 	}
 
 }
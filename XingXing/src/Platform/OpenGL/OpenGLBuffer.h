@@ -19,7 +19,7 @@ namespace Hazel {
 		virtual const BufferLayout& GetLayout() const override { return m_Layout; }
 		virtual void SetLayout(const BufferLayout& layout) override { m_Layout = layout; }
 	private:
-		uint32_t m_RendererID;
+		uint32_t m_RendererID = 0;
 		BufferLayout m_Layout;
 	};
 
@@ -34,7 +34,7 @@ namespace Hazel {
 
 		virtual uint32_t GetCount() const { return m_Count; }
 	private:
-		uint32_t m_RendererID;
+		uint32_t m_RendererID = 0;
 		uint32_t m_Count;
 	};
 
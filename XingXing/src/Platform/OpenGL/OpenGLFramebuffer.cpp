@@ -1,6 +1,9 @@
 #include "hzpch.h"
 #include "Platform/OpenGL/OpenGLFramebuffer.h"
 
+#include "XingXing/Renderer/Renderer.h"
+#include "XingXing/Renderer/GPUResourceRegistry.h"
+
 #include <glad/glad.h>
 
 namespace Hazel {
@@ -76,6 +79,18 @@ namespace Hazel {
 			return false;
 		}
 
+		static uint32_t BytesPerPixel(FramebufferTextureFormat format)
+		{
+			switch (format)
+			{
+				case FramebufferTextureFormat::RGBA8:           return 4;
+				case FramebufferTextureFormat::RED_INTEGER:     return 4;
+				case FramebufferTextureFormat::DEPTH24STENCIL8: return 4;
+			}
+
+			return 0;
+		}
+
 		static GLenum HazelFBTextureFormatToGL(FramebufferTextureFormat format)
 		{
 			switch (format)
@@ -101,6 +116,9 @@ namespace Hazel {
 				m_DepthAttachmentSpecification = spec;
 		}
 
+		HZ_CORE_ASSERT(m_ColorAttachmentSpecifications.size() <= m_PublishedColorAttachments.size());
+		m_ColorAttachments.resize(m_ColorAttachmentSpecifications.size());
+
 		Invalidate();
 	}
 
@@ -109,9 +127,28 @@ namespace Hazel {
 		glDeleteFramebuffers(1, &m_RendererID);
 		glDeleteTextures(m_ColorAttachments.size(), m_ColorAttachments.data());
 		glDeleteTextures(1, &m_DepthAttachment);
+
+		GPUResourceRegistry::Untrack(GPUResourceCategory::Framebuffer, this);
 	}
 
 	void OpenGLFramebuffer::Invalidate()
+	{
+		OpenGLFramebuffer* instance = this;
+		uint32_t width = m_Specification.Width, height = m_Specification.Height;
+		Renderer::Submit([instance, width, height]()
+		{
+			instance->RT_Invalidate(width, height);
+		});
+
+		uint64_t bytesPerPixel = Utils::BytesPerPixel(m_DepthAttachmentSpecification.TextureFormat);
+		for (auto& spec : m_ColorAttachmentSpecifications)
+			bytesPerPixel += Utils::BytesPerPixel(spec.TextureFormat);
+
+		uint64_t samples = std::max(m_Specification.Samples, 1u);
+		GPUResourceRegistry::Track(GPUResourceCategory::Framebuffer, this, (uint64_t)width * height * bytesPerPixel * samples);
+	}
+
+	void OpenGLFramebuffer::RT_Invalidate(uint32_t width, uint32_t height)
 	{
 		if (m_RendererID)
 		{
@@ -119,7 +156,6 @@ namespace Hazel {
 			glDeleteTextures(m_ColorAttachments.size(), m_ColorAttachments.data());
 			glDeleteTextures(1, &m_DepthAttachment);
 			
-			m_ColorAttachments.clear();
 			m_DepthAttachment = 0;
 		}
 
@@ -131,7 +167,6 @@ namespace Hazel {
 		// Attachments
 		if (m_ColorAttachmentSpecifications.size())
 		{
-			m_ColorAttachments.resize(m_ColorAttachmentSpecifications.size());
 			Utils::CreateTextures(multisample, m_ColorAttachments.data(), m_ColorAttachments.size());
 
 			for (size_t i = 0; i < m_ColorAttachments.size(); i++)
@@ -140,10 +175,10 @@ namespace Hazel {
 				switch (m_ColorAttachmentSpecifications[i].TextureFormat)
 				{
 					case FramebufferTextureFormat::RGBA8:
-						Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_RGBA8, GL_RGBA, m_Specification.Width, m_Specification.Height, i);
+						Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_RGBA8, GL_RGBA, width, height, i);
 						break;
 					case FramebufferTextureFormat::RED_INTEGER:
-						Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_R32I, GL_RED_INTEGER, m_Specification.Width, m_Specification.Height, i);
+						Utils::AttachColorTexture(m_ColorAttachments[i], m_Specification.Samples, GL_R32I, GL_RED_INTEGER, width, height, i);
 						break;
 				}
 			}
@@ -156,7 +191,7 @@ namespace Hazel {
 			switch (m_DepthAttachmentSpecification.TextureFormat)
 			{
 				case FramebufferTextureFormat::DEPTH24STENCIL8:
-					Utils::AttachDepthTexture(m_DepthAttachment, m_Specification.Samples, GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL_ATTACHMENT, m_Specification.Width, m_Specification.Height);
+					Utils::AttachDepthTexture(m_DepthAttachment, m_Specification.Samples, GL_DEPTH24_STENCIL8, GL_DEPTH_STENCIL_ATTACHMENT, width, height);
 					break;
 			}
 		}
@@ -176,17 +211,28 @@ namespace Hazel {
 		HZ_CORE_ASSERT(glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE, "Framebuffer is incomplete!");
 
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+		for (size_t i = 0; i < m_ColorAttachments.size(); i++)
+			m_PublishedColorAttachments[i].store(m_ColorAttachments[i], std::memory_order_release);
 	}
 
 	void OpenGLFramebuffer::Bind()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, m_RendererID);
-		glViewport(0, 0, m_Specification.Width, m_Specification.Height);
+		OpenGLFramebuffer* instance = this;
+		uint32_t width = m_Specification.Width, height = m_Specification.Height;
+		Renderer::Submit([instance, width, height]()
+		{
+			glBindFramebuffer(GL_FRAMEBUFFER, instance->m_RendererID);
+			glViewport(0, 0, width, height);
+		});
 	}
 
 	void OpenGLFramebuffer::Unbind()
 	{
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		Renderer::Submit([]()
+		{
+			glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		});
 	}
 
 	void OpenGLFramebuffer::Resize(uint32_t width, uint32_t height)
@@ -204,22 +250,31 @@ namespace Hazel {
 
 	int OpenGLFramebuffer::ReadPixel(uint32_t attachmentIndex, int x, int y)
 	{
-		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size());
+		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachmentSpecifications.size());
 
-		glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
-		int pixelData;
-		glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, &pixelData);
-		return pixelData;
+		OpenGLFramebuffer* instance = this;
+		Renderer::Submit([instance, attachmentIndex, x, y]()
+		{
+			glReadBuffer(GL_COLOR_ATTACHMENT0 + attachmentIndex);
+			int pixelData;
+			glReadPixels(x, y, 1, 1, GL_RED_INTEGER, GL_INT, &pixelData);
+			instance->m_ReadPixelResult = pixelData;
+		});
 
+		return m_ReadPixelResult;
 	}
 
 	void OpenGLFramebuffer::ClearAttachment(uint32_t attachmentIndex, int value)
 	{
-		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachments.size());
+		HZ_CORE_ASSERT(attachmentIndex < m_ColorAttachmentSpecifications.size());
 
-		auto& spec = m_ColorAttachmentSpecifications[attachmentIndex];
-		glClearTexImage(m_ColorAttachments[attachmentIndex], 0,
-			Utils::HazelFBTextureFormatToGL(spec.TextureFormat), GL_INT, &value);
+		OpenGLFramebuffer* instance = this;
+		Renderer::Submit([instance, attachmentIndex, value]()
+		{
+			auto& spec = instance->m_ColorAttachmentSpecifications[attachmentIndex];
+			glClearTexImage(instance->m_ColorAttachments[attachmentIndex], 0,
+				Utils::HazelFBTextureFormatToGL(spec.TextureFormat), GL_INT, &value);
+		});
 	}
 
 }
@@ -2,6 +2,9 @@
 
 #include "XingXing/Renderer/Framebuffer.h"
 
+#include <array>
+#include <atomic>
+
 namespace Hazel {
 
 	class OpenGLFramebuffer : public Framebuffer
@@ -20,9 +23,15 @@ namespace Hazel {
 
 		virtual void ClearAttachment(uint32_t attachmentIndex, int value) override;
 
-		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override { HZ_CORE_ASSERT(index < m_ColorAttachments.size()); return m_ColorAttachments[index]; }
+		virtual uint32_t GetColorAttachmentRendererID(uint32_t index = 0) const override
+		{
+			HZ_CORE_ASSERT(index < m_ColorAttachments.size());
+			return m_PublishedColorAttachments[index].load(std::memory_order_acquire);
+		}
 
 		virtual const FramebufferSpecification& GetSpecification() const override { return m_Specification; }
+	private:
+		void RT_Invalidate(uint32_t width, uint32_t height);
 	private:
 		uint32_t m_RendererID = 0;
 		FramebufferSpecification m_Specification;
@@ -30,8 +39,13 @@ namespace Hazel {
 		std::vector<FramebufferTextureSpecification> m_ColorAttachmentSpecifications;
 		FramebufferTextureSpecification m_DepthAttachmentSpecification = FramebufferTextureFormat::None;
 
+		// Owned by the render thread
 		std::vector<uint32_t> m_ColorAttachments;
 		uint32_t m_DepthAttachment = 0;
+		// Copies of the attachment IDs for the main thread, written once the render thread has created them
+		std::array<std::atomic<uint32_t>, 4> m_PublishedColorAttachments = {};
+
+		std::atomic<int> m_ReadPixelResult = -1;
 	};
 
 }
@@ -1,6 +1,7 @@
 #include "hzpch.h"
 #include "Platform/OpenGL/OpenGLShader.h"
 #include "XingXing/Core/Timer.h"
+#include "XingXing/Renderer/Renderer.h"
 
 #include <fstream>
 #include <glad/glad.h>
@@ -191,8 +192,6 @@ namespace Hazel {
 
 	void OpenGLShader::CompileOrGetVulkanBinaries(const std::unordered_map<GLenum, std::string>& shaderSources)
 	{
-		GLuint program = glCreateProgram();
-
 		shaderc::Compiler compiler;
 		shaderc::CompileOptions options;
 		options.SetTargetEnvironment(shaderc_target_env_vulkan, shaderc_env_version_vulkan_1_2);
@@ -305,6 +304,16 @@ namespace Hazel {
 	}
 
 	void OpenGLShader::CreateProgram()
+	{
+		// Compilation to SPIR-V stays on the calling thread, only program creation is deferred
+		OpenGLShader* instance = this;
+		Renderer::Submit([instance]()
+		{
+			instance->RT_CreateProgram();
+		});
+	}
+
+	void OpenGLShader::RT_CreateProgram()
 	{
 		GLuint program = glCreateProgram();
 
@@ -373,61 +382,97 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glUseProgram(m_RendererID);
+		const OpenGLShader* instance = this;
+		Renderer::Submit([instance]()
+		{
+			glUseProgram(instance->m_RendererID);
+		});
 	}
 
 	void OpenGLShader::Unbind() const
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glUseProgram(0);
+		Renderer::Submit([]()
+		{
+			glUseProgram(0);
+		});
 	}
 
 	void OpenGLShader::SetInt(const std::string& name, int value)
 	{
 		HZ_PROFILE_FUNCTION();
 
-		UploadUniformInt(name, value);
+		OpenGLShader* instance = this;
+		Renderer::Submit([instance, name, value]()
+		{
+			instance->UploadUniformInt(name, value);
+		});
 	}
 
 	void OpenGLShader::SetIntArray(const std::string& name, int* values, uint32_t count)
 	{
-		UploadUniformIntArray(name, values, count);
+		OpenGLShader* instance = this;
+		std::vector<int> localValues(values, values + count);
+		Renderer::Submit([instance, name, localValues]() mutable
+		{
+			instance->UploadUniformIntArray(name, localValues.data(), (uint32_t)localValues.size());
+		});
 	}
 
 	void OpenGLShader::SetFloat(const std::string& name, float value)
 	{
 		HZ_PROFILE_FUNCTION();
 
-		UploadUniformFloat(name, value);
+		OpenGLShader* instance = this;
+		Renderer::Submit([instance, name, value]()
+		{
+			instance->UploadUniformFloat(name, value);
+		});
 	}
 
 	void OpenGLShader::SetFloat2(const std::string& name, const glm::vec2& value)
 	{
 		HZ_PROFILE_FUNCTION();
 
-		UploadUniformFloat2(name, value);
+		OpenGLShader* instance = this;
+		Renderer::Submit([instance, name, value]()
+		{
+			instance->UploadUniformFloat2(name, value);
+		});
 	}
 
 	void OpenGLShader::SetFloat3(const std::string& name, const glm::vec3& value)
 	{
 		HZ_PROFILE_FUNCTION();
 
-		UploadUniformFloat3(name, value);
+		OpenGLShader* instance = this;
+		Renderer::Submit([instance, name, value]()
+		{
+			instance->UploadUniformFloat3(name, value);
+		});
 	}
 
 	void OpenGLShader::SetFloat4(const std::string& name, const glm::vec4& value)
 	{
 		HZ_PROFILE_FUNCTION();
 
-		UploadUniformFloat4(name, value);
+		OpenGLShader* instance = this;
+		Renderer::Submit([instance, name, value]()
+		{
+			instance->UploadUniformFloat4(name, value);
+		});
 	}
 
 	void OpenGLShader::SetMat4(const std::string& name, const glm::mat4& value)
 	{
 		HZ_PROFILE_FUNCTION();
 
-		UploadUniformMat4(name, value);
+		OpenGLShader* instance = this;
+		Renderer::Submit([instance, name, value]()
+		{
+			instance->UploadUniformMat4(name, value);
+		});
 	}
 
 	void OpenGLShader::UploadUniformInt(const std::string& name, int value)
@@ -28,6 +28,7 @@ namespace Hazel {
 
 		virtual const std::string& GetName() const override { return m_Name; }
 
+		// Direct uniform uploads, only valid on the render thread
 		void UploadUniformInt(const std::string& name, int value);
 		void UploadUniformIntArray(const std::string& name, int* values, uint32_t count);
 
@@ -45,9 +46,10 @@ namespace Hazel {
 		void CompileOrGetVulkanBinaries(const std::unordered_map<GLenum, std::string>& shaderSources);
 		void CompileOrGetOpenGLBinaries();
 		void CreateProgram();
+		void RT_CreateProgram();
 		void Reflect(GLenum stage, const std::vector<uint32_t>& shaderData);
 	private:
-		uint32_t m_RendererID;
+		uint32_t m_RendererID = 0;
 		std::string m_FilePath;
 		std::string m_Name;
 
@@ -1,6 +1,9 @@
 #include "hzpch.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
 
+#include "XingXing/Renderer/Renderer.h"
+#include "XingXing/Renderer/GPUResourceRegistry.h"
+
 #include <stb_image.h>
 
 namespace Hazel {
@@ -41,14 +44,13 @@ namespace Hazel {
 		m_InternalFormat = Utils::HazelImageFormatToGLInternalFormat(m_Specification.Format);
 		m_DataFormat = Utils::HazelImageFormatToGLDataFormat(m_Specification.Format);
 
-		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-		glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
-
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		OpenGLTexture2D* instance = this;
+		Renderer::Submit([instance]()
+		{
+			instance->RT_CreateStorage();
+		});
 
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		GPUResourceRegistry::Track(GPUResourceCategory::Texture, this, (uint64_t)m_Width * m_Height * GetBytesPerPixel());
 	}
 
 	OpenGLTexture2D::OpenGLTexture2D(const std::string& path)
@@ -56,73 +58,208 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
+		TextureImage image;
+		m_IsLoaded = Decode(m_Path, image);
+		if (m_IsLoaded)
+			Upload(image);
+	}
+
+	OpenGLTexture2D::OpenGLTexture2D(const std::string& path, TextureImage image)
+		: m_Path(path)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		m_IsLoaded = image.Data != nullptr;
+		if (m_IsLoaded)
+			Upload(image);
+	}
+
+	OpenGLTexture2D::~OpenGLTexture2D()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		glDeleteTextures(1, &m_RendererID);
+
+		GPUResourceRegistry::Untrack(GPUResourceCategory::Texture, this);
+	}
+
+	bool OpenGLTexture2D::Decode(const std::string& path, TextureImage& outImage)
+	{
+		HZ_PROFILE_FUNCTION();
+
 		int width, height, channels;
 		stbi_set_flip_vertically_on_load(1);
 		stbi_uc* data = nullptr;
 		{
-			HZ_PROFILE_SCOPE("stbi_load - OpenGLTexture2D::OpenGLTexture2D(const std::string&)");
+			HZ_PROFILE_SCOPE("stbi_load - OpenGLTexture2D::Decode");
 			data = stbi_load(path.c_str(), &width, &height, &channels, 0);
 		}
-			
-		if (data)
-		{
-			m_IsLoaded = true;
 
-			m_Width = width;
-			m_Height = height;
+		if (!data)
+			return false;
 
-			GLenum internalFormat = 0, dataFormat = 0;
-			if (channels == 4)
-			{
-				internalFormat = GL_RGBA8;
-				dataFormat = GL_RGBA;
-			}
-			else if (channels == 3)
-			{
-				internalFormat = GL_RGB8;
-				dataFormat = GL_RGB;
-			}
+		outImage.Data = data;
+		outImage.Width = width;
+		outImage.Height = height;
+		outImage.Channels = channels;
+		return true;
+	}
 
-			m_InternalFormat = internalFormat;
-			m_DataFormat = dataFormat;
+	void OpenGLTexture2D::FreeImage(TextureImage& image)
+	{
+		stbi_image_free(image.Data);
+		image = {};
+	}
 
-			HZ_CORE_ASSERT(internalFormat & dataFormat, "Format not supported!");
+	void OpenGLTexture2D::Upload(TextureImage image)
+	{
+		HZ_PROFILE_FUNCTION();
 
-			glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
-			glTextureStorage2D(m_RendererID, 1, internalFormat, m_Width, m_Height);
+		m_Width = image.Width;
+		m_Height = image.Height;
 
-			glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-			glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+		GLenum internalFormat = 0, dataFormat = 0;
+		if (image.Channels == 4)
+		{
+			internalFormat = GL_RGBA8;
+			dataFormat = GL_RGBA;
+		}
+		else if (image.Channels == 3)
+		{
+			internalFormat = GL_RGB8;
+			dataFormat = GL_RGB;
+		}
 
-			glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
-			glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+		m_InternalFormat = internalFormat;
+		m_DataFormat = dataFormat;
 
-			glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, dataFormat, GL_UNSIGNED_BYTE, data);
+		HZ_CORE_ASSERT(internalFormat & dataFormat, "Format not supported!");
+
+		// The decoded image is handed to the render thread, which frees it after the upload
+		OpenGLTexture2D* instance = this;
+		stbi_uc* data = (stbi_uc*)image.Data;
+		Renderer::Submit([instance, data]()
+		{
+			instance->RT_CreateStorage();
+			glTextureSubImage2D(instance->m_RendererID, 0, 0, 0, instance->m_Width, instance->m_Height, instance->m_DataFormat, GL_UNSIGNED_BYTE, data);
 
 			stbi_image_free(data);
-		}
+		});
+
+		GPUResourceRegistry::Track(GPUResourceCategory::Texture, this, (uint64_t)m_Width * m_Height * GetBytesPerPixel());
 	}
 
-	OpenGLTexture2D::~OpenGLTexture2D()
+	bool OpenGLTexture2D::Evict()
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glDeleteTextures(1, &m_RendererID);
+		// Only textures loaded from a file can be brought back
+		if (m_Path.empty() || !m_IsLoaded || m_Evicted)
+			return false;
+
+		uint32_t width = std::max(m_Width / 8, 1u);
+		uint32_t height = std::max(m_Height / 8, 1u);
+
+		OpenGLTexture2D* instance = this;
+		Renderer::Submit([instance, width, height]()
+		{
+			instance->RT_Evict(width, height);
+		});
+
+		m_Evicted = true;
+		GPUResourceRegistry::Track(GPUResourceCategory::Texture, this, (uint64_t)width * height * GetBytesPerPixel());
+		return true;
+	}
+
+	bool OpenGLTexture2D::DecodeSource(TextureImage& outImage) const
+	{
+		return Decode(m_Path, outImage);
+	}
+
+	void OpenGLTexture2D::Restore(TextureImage image)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (!m_Evicted || !image.Data)
+		{
+			FreeImage(image);
+			return;
+		}
+
+		m_Evicted = false;
+		Upload(image);
 	}
 
 	void OpenGLTexture2D::SetData(void* data, uint32_t size)
 	{
 		HZ_PROFILE_FUNCTION();
 
-		uint32_t bpp = m_DataFormat == GL_RGBA ? 4 : 3;
+		uint32_t bpp = GetBytesPerPixel();
 		HZ_CORE_ASSERT(size == m_Width * m_Height * bpp, "Data must be entire texture!");
-		glTextureSubImage2D(m_RendererID, 0, 0, 0, m_Width, m_Height, m_DataFormat, GL_UNSIGNED_BYTE, data);
+
+		Buffer localData = Buffer::Copy(data, size);
+		OpenGLTexture2D* instance = this;
+		Renderer::Submit([instance, localData]() mutable
+		{
+			glTextureSubImage2D(instance->m_RendererID, 0, 0, 0, instance->m_Width, instance->m_Height, instance->m_DataFormat, GL_UNSIGNED_BYTE, localData.Data);
+			localData.Release();
+		});
 	}
 
 	void OpenGLTexture2D::Bind(uint32_t slot) const
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glBindTextureUnit(slot, m_RendererID);
+		GPUResourceRegistry::MarkUsed(this);
+
+		const OpenGLTexture2D* instance = this;
+		Renderer::Submit([instance, slot]()
+		{
+			glBindTextureUnit(slot, instance->m_RendererID);
+		});
+	}
+
+	void OpenGLTexture2D::RT_CreateStorage()
+	{
+		// Restoring an evicted texture replaces its low resolution copy
+		if (m_RendererID)
+			glDeleteTextures(1, &m_RendererID);
+
+		glCreateTextures(GL_TEXTURE_2D, 1, &m_RendererID);
+		glTextureStorage2D(m_RendererID, 1, m_InternalFormat, m_Width, m_Height);
+
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTextureParameteri(m_RendererID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+		m_PublishedRendererID.store(m_RendererID, std::memory_order_release);
 	}
+
+	void OpenGLTexture2D::RT_Evict(uint32_t width, uint32_t height)
+	{
+		uint32_t lowResolutionID;
+		glCreateTextures(GL_TEXTURE_2D, 1, &lowResolutionID);
+		glTextureStorage2D(lowResolutionID, 1, m_InternalFormat, width, height);
+
+		glTextureParameteri(lowResolutionID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+		glTextureParameteri(lowResolutionID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+		glTextureParameteri(lowResolutionID, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTextureParameteri(lowResolutionID, GL_TEXTURE_WRAP_T, GL_REPEAT);
+
+		// Downsample on the GPU, the image data is not kept on the CPU
+		uint32_t framebuffers[2];
+		glCreateFramebuffers(2, framebuffers);
+		glNamedFramebufferTexture(framebuffers[0], GL_COLOR_ATTACHMENT0, m_RendererID, 0);
+		glNamedFramebufferTexture(framebuffers[1], GL_COLOR_ATTACHMENT0, lowResolutionID, 0);
+		glBlitNamedFramebuffer(framebuffers[0], framebuffers[1], 0, 0, m_Width, m_Height, 0, 0, width, height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+		glDeleteFramebuffers(2, framebuffers);
+
+		glDeleteTextures(1, &m_RendererID);
+		m_RendererID = lowResolutionID;
+		m_PublishedRendererID.store(m_RendererID, std::memory_order_release);
+	}
+
 }
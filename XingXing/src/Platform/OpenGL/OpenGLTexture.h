@@ -4,6 +4,8 @@
 
 #include <glad/glad.h>
 
+#include <atomic>
+
 namespace Hazel {
 
 	class OpenGLTexture2D : public Texture2D
@@ -11,13 +13,15 @@ namespace Hazel {
 	public:
 		OpenGLTexture2D(const TextureSpecification& specification);
 		OpenGLTexture2D(const std::string& path);
+		// Takes ownership of the image, see Texture2D::Decode
+		OpenGLTexture2D(const std::string& path, TextureImage image);
 		virtual ~OpenGLTexture2D();
 
 		virtual const TextureSpecification& GetSpecification() const override { return m_Specification; }
 
 		virtual uint32_t GetWidth() const override { return m_Width;  }
 		virtual uint32_t GetHeight() const override { return m_Height; }
-		virtual uint32_t GetRendererID() const override { return m_RendererID; }
+		virtual uint32_t GetRendererID() const override { return m_PublishedRendererID.load(std::memory_order_acquire); }
 
 		virtual const std::string& GetPath() const override { return m_Path; }
 		
@@ -27,17 +31,36 @@ namespace Hazel {
 
 		virtual bool IsLoaded() const override { return m_IsLoaded; }
 
+		virtual bool Evict() override;
+		virtual bool DecodeSource(TextureImage& outImage) const override;
+		virtual void Restore(TextureImage image) override;
+
+		// The renderer ID is assigned on the render thread, so identity is the only thing
+		// that can be compared while recording
 		virtual bool operator==(const Texture& other) const override
 		{
-			return m_RendererID == other.GetRendererID();
+			return this == &other;
 		}
+
+		static bool Decode(const std::string& path, TextureImage& outImage);
+		static void FreeImage(TextureImage& image);
+	private:
+		// Takes ownership of the image
+		void Upload(TextureImage image);
+		uint32_t GetBytesPerPixel() const { return m_DataFormat == GL_RGBA ? 4 : 3; }
+
+		void RT_CreateStorage();
+		void RT_Evict(uint32_t width, uint32_t height);
 	private:
 		TextureSpecification m_Specification;
 
 		std::string m_Path;
 		bool m_IsLoaded = false;
+		bool m_Evicted = false;
 		uint32_t m_Width, m_Height;
-		uint32_t m_RendererID;
+		// Owned by the render thread, m_PublishedRendererID is the copy the main thread reads
+		uint32_t m_RendererID = 0;
+		std::atomic<uint32_t> m_PublishedRendererID = 0;
 		GLenum m_InternalFormat, m_DataFormat;
 	};
 
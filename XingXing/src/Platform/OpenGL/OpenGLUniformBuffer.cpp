@@ -1,15 +1,21 @@
 #include "hzpch.h"
 #include "OpenGLUniformBuffer.h"
 
+#include "XingXing/Renderer/Renderer.h"
+
 #include <glad/glad.h>
 
 namespace Hazel {
 
 	OpenGLUniformBuffer::OpenGLUniformBuffer(uint32_t size, uint32_t binding)
 	{
-		glCreateBuffers(1, &m_RendererID);
-		glNamedBufferData(m_RendererID, size, nullptr, GL_DYNAMIC_DRAW); // TODO: investigate usage hint
-		glBindBufferBase(GL_UNIFORM_BUFFER, binding, m_RendererID);
+		OpenGLUniformBuffer* instance = this;
+		Renderer::Submit([instance, size, binding]()
+		{
+			glCreateBuffers(1, &instance->m_RendererID);
+			glNamedBufferData(instance->m_RendererID, size, nullptr, GL_DYNAMIC_DRAW); // TODO: investigate usage hint
+			glBindBufferBase(GL_UNIFORM_BUFFER, binding, instance->m_RendererID);
+		});
 	}
 
 	OpenGLUniformBuffer::~OpenGLUniformBuffer()
@@ -20,7 +26,13 @@ namespace Hazel {
 
 	void OpenGLUniformBuffer::SetData(const void* data, uint32_t size, uint32_t offset)
 	{
-		glNamedBufferSubData(m_RendererID, offset, size, data);
+		Buffer localData = Buffer::Copy(data, size);
+		OpenGLUniformBuffer* instance = this;
+		Renderer::Submit([instance, localData, offset]() mutable
+		{
+			glNamedBufferSubData(instance->m_RendererID, offset, localData.Size, localData.Data);
+			localData.Release();
+		});
 	}
 
 }
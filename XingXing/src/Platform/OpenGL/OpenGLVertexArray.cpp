@@ -1,6 +1,8 @@
 #include "hzpch.h"
 #include "Platform/OpenGL/OpenGLVertexArray.h"
 
+#include "XingXing/Renderer/Renderer.h"
+
 #include <glad/glad.h>
 
 namespace Hazel {
@@ -30,7 +32,11 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glCreateVertexArrays(1, &m_RendererID);
+		OpenGLVertexArray* instance = this;
+		Renderer::Submit([instance]()
+		{
+			glCreateVertexArrays(1, &instance->m_RendererID);
+		});
 	}
 
 	OpenGLVertexArray::~OpenGLVertexArray()
@@ -44,14 +50,21 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glBindVertexArray(m_RendererID);
+		const OpenGLVertexArray* instance = this;
+		Renderer::Submit([instance]()
+		{
+			glBindVertexArray(instance->m_RendererID);
+		});
 	}
 
 	void OpenGLVertexArray::Unbind() const
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glBindVertexArray(0);
+		Renderer::Submit([]()
+		{
+			glBindVertexArray(0);
+		});
 	}
 
 	void OpenGLVertexArray::AddVertexBuffer(const Ref<VertexBuffer>& vertexBuffer)
@@ -60,66 +73,70 @@ namespace Hazel {
 
 		HZ_CORE_ASSERT(vertexBuffer->GetLayout().GetElements().size(), "Vertex Buffer has no layout!");
 
-		glBindVertexArray(m_RendererID);
-		vertexBuffer->Bind();
-
-		const auto& layout = vertexBuffer->GetLayout();
-		for (const auto& element : layout)
+		OpenGLVertexArray* instance = this;
+		Renderer::Submit([instance, vertexBuffer]()
 		{
-			switch (element.Type)
+			glBindVertexArray(instance->m_RendererID);
+			vertexBuffer->Bind();
+
+			const auto& layout = vertexBuffer->GetLayout();
+			for (const auto& element : layout)
 			{
-				case ShaderDataType::Float:
-				case ShaderDataType::Float2:
-				case ShaderDataType::Float3:
-				case ShaderDataType::Float4:
-				{
-					glEnableVertexAttribArray(m_VertexBufferIndex);
-					glVertexAttribPointer(m_VertexBufferIndex,
-						element.GetComponentCount(),
-						ShaderDataTypeToOpenGLBaseType(element.Type),
-						element.Normalized ? GL_TRUE : GL_FALSE,
-						layout.GetStride(),
-						(const void*)element.Offset);
-					m_VertexBufferIndex++;
-					break;
-				}
-				case ShaderDataType::Int:
-				case ShaderDataType::Int2:
-				case ShaderDataType::Int3:
-				case ShaderDataType::Int4:
-				case ShaderDataType::Bool:
-				{
-					glEnableVertexAttribArray(m_VertexBufferIndex);
-					glVertexAttribIPointer(m_VertexBufferIndex,
-						element.GetComponentCount(),
-						ShaderDataTypeToOpenGLBaseType(element.Type),
-						layout.GetStride(),
-						(const void*)element.Offset);
-					m_VertexBufferIndex++;
-					break;
-				}
-				case ShaderDataType::Mat3:
-				case ShaderDataType::Mat4:
+				switch (element.Type)
 				{
-					uint8_t count = element.GetComponentCount();
-					for (uint8_t i = 0; i < count; i++)
+					case ShaderDataType::Float:
+					case ShaderDataType::Float2:
+					case ShaderDataType::Float3:
+					case ShaderDataType::Float4:
 					{
-						glEnableVertexAttribArray(m_VertexBufferIndex);
-						glVertexAttribPointer(m_VertexBufferIndex,
-							count,
+						glEnableVertexAttribArray(instance->m_VertexBufferIndex);
+						glVertexAttribPointer(instance->m_VertexBufferIndex,
+							element.GetComponentCount(),
 							ShaderDataTypeToOpenGLBaseType(element.Type),
 							element.Normalized ? GL_TRUE : GL_FALSE,
 							layout.GetStride(),
-							(const void*)(element.Offset + sizeof(float) * count * i));
-						glVertexAttribDivisor(m_VertexBufferIndex, 1);
-						m_VertexBufferIndex++;
+							(const void*)element.Offset);
+						instance->m_VertexBufferIndex++;
+						break;
+					}
+					case ShaderDataType::Int:
+					case ShaderDataType::Int2:
+					case ShaderDataType::Int3:
+					case ShaderDataType::Int4:
+					case ShaderDataType::Bool:
+					{
+						glEnableVertexAttribArray(instance->m_VertexBufferIndex);
+						glVertexAttribIPointer(instance->m_VertexBufferIndex,
+							element.GetComponentCount(),
+							ShaderDataTypeToOpenGLBaseType(element.Type),
+							layout.GetStride(),
+							(const void*)element.Offset);
+						instance->m_VertexBufferIndex++;
+						break;
 					}
-					break;
+					case ShaderDataType::Mat3:
+					case ShaderDataType::Mat4:
+					{
+						uint8_t count = element.GetComponentCount();
+						for (uint8_t i = 0; i < count; i++)
+						{
+							glEnableVertexAttribArray(instance->m_VertexBufferIndex);
+							glVertexAttribPointer(instance->m_VertexBufferIndex,
+								count,
+								ShaderDataTypeToOpenGLBaseType(element.Type),
+								element.Normalized ? GL_TRUE : GL_FALSE,
+								layout.GetStride(),
+								(const void*)(element.Offset + sizeof(float) * count * i));
+							glVertexAttribDivisor(instance->m_VertexBufferIndex, 1);
+							instance->m_VertexBufferIndex++;
+						}
+						break;
+					}
+					default:
+						HZ_CORE_ASSERT(false, "Unknown ShaderDataType!");
 				}
-				default:
-					HZ_CORE_ASSERT(false, "Unknown ShaderDataType!");
 			}
-		}
+		});
 
 		m_VertexBuffers.push_back(vertexBuffer);
 	}
@@ -128,8 +145,12 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
-		glBindVertexArray(m_RendererID);
-		indexBuffer->Bind();
+		OpenGLVertexArray* instance = this;
+		Renderer::Submit([instance, indexBuffer]()
+		{
+			glBindVertexArray(instance->m_RendererID);
+			indexBuffer->Bind();
+		});
 
 		m_IndexBuffer = indexBuffer;
 	}
@@ -0,0 +1,145 @@
+#pragma once
+
+#include "XingXing/Core/Base.h"
+#include "XingXing/Core/FlatHashMap.h"
+
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace Hazel {
+
+	// 32-bit index into AssetTable<T>. Components store these instead of Ref<T>, so they stay trivially
+	// copyable and copying or drawing them never touches a reference count. The default handle is no asset.
+	template<typename T>
+	class AssetHandle
+	{
+	public:
+		AssetHandle() = default;
+		explicit AssetHandle(uint32_t index)
+			: m_Index(index) {}
+
+		uint32_t GetIndex() const { return m_Index; }
+
+		explicit operator bool() const { return m_Index != 0; }
+		bool operator==(AssetHandle other) const { return m_Index == other.m_Index; }
+		bool operator!=(AssetHandle other) const { return m_Index != other.m_Index; }
+	private:
+		uint32_t m_Index = 0;
+	};
+
+	// Owns the assets of one type that are referred to by handle. Adding an asset or path a second time
+	// returns the handle it already has. Handles don't count references, so slots are freed by Collect,
+	// which the scenes run when they are destroyed or unload entities (see Scene::ReleaseUnusedAssets);
+	// freed slots are reused by later adds. Handles kept outside of a scene's components don't keep their
+	// asset unless something else holds a Ref to it.
+	// Add and Collect on the main thread; Get is safe from any thread as long as neither is running.
+	template<typename T>
+	class AssetTable
+	{
+	public:
+		static AssetHandle<T> Add(const Ref<T>& asset, const std::string& path = std::string())
+		{
+			if (!asset)
+				return {};
+
+			Data& data = GetData();
+			auto [it, inserted] = data.Indices.try_emplace(asset.get(), 0);
+			if (inserted)
+			{
+				if (!data.FreeSlots.empty())
+				{
+					it->second = data.FreeSlots.back();
+					data.FreeSlots.pop_back();
+					data.Assets[it->second] = asset;
+				}
+				else
+				{
+					it->second = (uint32_t)data.Assets.size();
+					data.Assets.push_back(asset);
+				}
+			}
+
+			uint32_t index = it->second;
+			if (!path.empty())
+				data.Paths[path] = index;
+
+			return AssetHandle<T>(index);
+		}
+
+		// The asset previously added under path, or no asset
+		static AssetHandle<T> Find(const std::string& path)
+		{
+			Data& data = GetData();
+			auto it = data.Paths.find(path);
+			return it != data.Paths.end() ? AssetHandle<T>(it->second) : AssetHandle<T>();
+		}
+
+		static T* Get(AssetHandle<T> handle)
+		{
+			return GetData().Assets[handle.GetIndex()].get();
+		}
+
+		// For APIs taking a Ref, without copying it
+		static const Ref<T>& GetRef(AssetHandle<T> handle)
+		{
+			return GetData().Assets[handle.GetIndex()];
+		}
+
+		// Frees every slot that isn't marked as used and whose asset nobody else holds a Ref to.
+		// used is indexed by handle index, slots past its end count as unused. Returns the number freed.
+		static uint32_t Collect(const std::vector<bool>& used)
+		{
+			Data& data = GetData();
+
+			uint32_t freed = 0;
+			for (uint32_t index = 1; index < (uint32_t)data.Assets.size(); index++)
+			{
+				Ref<T>& asset = data.Assets[index];
+				if (!asset || (index < used.size() && used[index]) || asset.use_count() > 1)
+					continue;
+
+				data.Indices.erase(asset.get());
+				asset = nullptr;
+				data.FreeSlots.push_back(index);
+				freed++;
+			}
+
+			// An asset can have been added under several paths
+			if (freed > 0)
+			{
+				for (auto it = data.Paths.begin(); it != data.Paths.end();)
+				{
+					if (!data.Assets[it->second])
+						it = data.Paths.erase(it);
+					else
+						++it;
+				}
+			}
+
+			return freed;
+		}
+
+		// Highest handle index plus one, for sizing the marks passed to Collect
+		static uint32_t GetCapacity() { return (uint32_t)GetData().Assets.size(); }
+		static uint32_t GetCount() { return (uint32_t)(GetData().Assets.size() - GetData().FreeSlots.size()) - 1; }
+	private:
+		struct Data
+		{
+			// Slot 0 is the null asset
+			std::vector<Ref<T>> Assets = std::vector<Ref<T>>(1);
+			std::vector<uint32_t> FreeSlots;
+			FlatHashMap<const T*, uint32_t> Indices;
+			FlatHashMap<std::string, uint32_t> Paths;
+		};
+
+		static Data& GetData()
+		{
+			static Data s_Data;
+			return s_Data;
+		}
+	};
+
+	static_assert(std::is_trivially_copyable_v<AssetHandle<int>>);
+
+}
@@ -0,0 +1,78 @@
+#include "hzpch.h"
+#include "XingXing/Core/AllocationTracker.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace Hazel {
+
+	static std::atomic<uint64_t> s_AllocationCount = 0;
+	static std::atomic<uint64_t> s_AllocatedBytes = 0;
+
+	static AllocationTracker::Statistics s_Stats;
+	static uint64_t s_LastAllocationCount = 0;
+	static uint64_t s_LastAllocatedBytes = 0;
+
+	void AllocationTracker::NextFrame()
+	{
+		uint64_t allocationCount = s_AllocationCount.load(std::memory_order_relaxed);
+		uint64_t allocatedBytes = s_AllocatedBytes.load(std::memory_order_relaxed);
+
+		s_Stats.AllocationsLastFrame = allocationCount - s_LastAllocationCount;
+		s_Stats.BytesLastFrame = allocatedBytes - s_LastAllocatedBytes;
+		s_Stats.TotalAllocations = allocationCount;
+
+		s_LastAllocationCount = allocationCount;
+		s_LastAllocatedBytes = allocatedBytes;
+	}
+
+	AllocationTracker::Statistics AllocationTracker::GetStats()
+	{
+		return s_Stats;
+	}
+
+	uint64_t AllocationTracker::GetAllocationCount()
+	{
+		return s_AllocationCount.load(std::memory_order_relaxed);
+	}
+
+}
+
+#if HZ_TRACK_ALLOCATIONS
+
+// Array and aligned forms end up here or aren't counted; deletes only need to match the malloc
+void* operator new(size_t size)
+{
+	Hazel::s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	Hazel::s_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+	if (void* memory = std::malloc(size ? size : 1))
+		return memory;
+	throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	Hazel::s_AllocationCount.fetch_add(1, std::memory_order_relaxed);
+	Hazel::s_AllocatedBytes.fetch_add(size, std::memory_order_relaxed);
+
+	return std::malloc(size ? size : 1);
+}
+
+void operator delete(void* memory) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, [[maybe_unused]] size_t size) noexcept
+{
+	std::free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+	std::free(memory);
+}
+
+#endif
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <stdint.h>
+
+// Define HZ_TRACK_ALLOCATIONS as 1 for the whole workspace to count every allocation made through
+// the global operator new. It replaces the global operators, so it is off unless asked for.
+#ifndef HZ_TRACK_ALLOCATIONS
+	#define HZ_TRACK_ALLOCATIONS 0
+#endif
+
+namespace Hazel {
+
+	// Heap allocations of the whole process per frame, on any thread
+	class AllocationTracker
+	{
+	public:
+		struct Statistics
+		{
+			uint64_t AllocationsLastFrame = 0;
+			uint64_t BytesLastFrame = 0;
+			uint64_t TotalAllocations = 0;
+		};
+	public:
+		static bool IsEnabled() { return HZ_TRACK_ALLOCATIONS; }
+
+		// Call once per frame on the main thread
+		static void NextFrame();
+
+		static Statistics GetStats();
+		// Allocations since startup, up to date rather than as of the last frame
+		static uint64_t GetAllocationCount();
+	};
+
+}
@@ -2,8 +2,13 @@
 #include "XingXing/Core/Application.h"
 
 #include "XingXing/Core/Log.h"
+#include "XingXing/Core/JobSystem.h"
+#include "XingXing/Core/FrameAllocator.h"
+#include "XingXing/Core/AllocationTracker.h"
 
 #include "XingXing/Renderer/Renderer.h"
+#include "XingXing/Renderer/GraphicsContext.h"
+#include "XingXing/Renderer/GPUResourceRegistry.h"
 #include "XingXing/Scripting/ScriptEngine.h"
 
 #include "XingXing/Core/Input.h"
@@ -14,7 +19,7 @@ namespace Hazel {
 	Application* Application::s_Instance = nullptr;
 
 	Application::Application(const ApplicationSpecification& specification)
-		: m_Specification(specification)
+		: m_Specification(specification), m_RenderThread(specification.RenderThreadingPolicy)
 	{
 		HZ_PROFILE_FUNCTION();
 
@@ -25,7 +30,10 @@ namespace Hazel {
 		if (!m_Specification.WorkingDirectory.empty())
 			std::filesystem::current_path(m_Specification.WorkingDirectory);
 
-		m_Window = Window::Create(WindowProps(m_Specification.Name));
+		JobSystem::Init();
+		FrameAllocator::Init();
+
+		m_Window = Window::Create(WindowProps(m_Specification.Name, 1600, 900, m_Specification.WindowVisible));
 		m_Window->SetEventCallback(HZ_BIND_EVENT_FN(Application::OnEvent));
 
 		Renderer::Init();
@@ -38,8 +46,13 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
+		if (m_RenderThread.IsRunning())
+			m_RenderThread.Terminate();
+
 		ScriptEngine::Shutdown();
 		Renderer::Shutdown();
+		JobSystem::Shutdown();
+		FrameAllocator::Shutdown();
 	}
 
 	void Application::PushLayer(Layer* layer)
@@ -90,15 +103,39 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
+		// Resources created while the layers were attached are still recorded; create them while this thread owns the context
+		m_RenderThread.Pump();
+
+		GraphicsContext& context = m_Window->GetContext();
+		if (m_RenderThread.GetThreadingPolicy() == ThreadingPolicy::MultiThreaded)
+		{
+			context.ReleaseCurrent();
+			Renderer::Submit([&context]() { context.MakeCurrent(); });
+		}
+
+		m_RenderThread.Run();
+
 		while (m_Running)
 		{
 			HZ_PROFILE_SCOPE("RunLoop");
 
+			// Render the previous frame while this one is being recorded
+			m_RenderThread.BlockUntilRenderComplete();
+			m_RenderThread.NextFrame();
+			m_RenderThread.Kick();
+
+			GPUResourceRegistry::NextFrame();
+
+			// The render thread is done with the frame before last, so its arena can be reused
+			FrameAllocator::NextFrame();
+			AllocationTracker::NextFrame();
+
 			float time = Time::GetTime();
 			Timestep timestep = time - m_LastFrameTime;
 			m_LastFrameTime = time;
 
 			ExecuteMainThreadQueue();
+			JobSystem::ExecuteMainThreadJobs();
 
 			if (!m_Minimized)
 			{
@@ -121,6 +158,19 @@ namespace Hazel {
 
 			m_Window->OnUpdate();
 		}
+
+		// Execute the last frame and the frees deferred so far while the render thread still has the
+		// context, so releasing it is the last command there
+		m_RenderThread.Pump();
+		if (m_RenderThread.GetThreadingPolicy() == ThreadingPolicy::MultiThreaded)
+			Renderer::Submit([&context]() { context.ReleaseCurrent(); });
+
+		m_RenderThread.Terminate();
+		context.MakeCurrent();
+
+		// Frees deferred while the render thread shut down
+		Renderer::SwapQueues();
+		Renderer::ExecuteRenderCommandQueue();
 	}
 
 	bool Application::OnWindowClose(WindowCloseEvent& e)
@@ -11,6 +11,8 @@
 
 #include "XingXing/ImGui/ImGuiLayer.h"
 
+#include "XingXing/Renderer/RenderThread.h"
+
 int main(int argc, char** argv);
 
 namespace Hazel {
@@ -32,6 +34,8 @@ namespace Hazel {
 		std::string Name = "Hazel Application";
 		std::string WorkingDirectory;
 		ApplicationCommandLineArgs CommandLineArgs;
+		ThreadingPolicy RenderThreadingPolicy = ThreadingPolicy::SingleThreaded;
+		bool WindowVisible = true;
 	};
 
 	class Application
@@ -54,6 +58,7 @@ namespace Hazel {
 		static Application& Get() { return *s_Instance; }
 
 		const ApplicationSpecification& GetSpecification() const { return m_Specification; }
+		RenderThread& GetRenderThread() { return m_RenderThread; }
 
 		void SubmitToMainThread(const std::function<void()>& function);
 	private:
@@ -64,6 +69,7 @@ namespace Hazel {
 		void ExecuteMainThreadQueue();
 	private:
 		ApplicationSpecification m_Specification;
+		RenderThread m_RenderThread;
 		Scope<Window> m_Window;
 		ImGuiLayer* m_ImGuiLayer;
 		bool m_Running = true;
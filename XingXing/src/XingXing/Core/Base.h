@@ -1,6 +1,7 @@
 #pragma once
 
 #include "XingXing/Core/PlatformDetection.h"
+#include "XingXing/Core/RefCounted.h"
 
 #include <memory>
 
@@ -23,6 +24,9 @@
 
 #define BIT(x) (1 << x)
 
+// Lets types declared with HZ_INTRUSIVE_REF use IntrusiveRef as their Ref; 0 makes every Ref a std::shared_ptr
+#define HZ_INTRUSIVE_REFS 1
+
 #define HZ_BIND_EVENT_FN(fn) [this](auto&&... args) -> decltype(auto) { return this->fn(std::forward<decltype(args)>(args)...); }
 
 namespace Hazel {
@@ -36,14 +40,32 @@ namespace Hazel {
 	}
 
 	template<typename T>
-	using Ref = std::shared_ptr<T>;
+	struct RefTraits
+	{
+		using Type = std::shared_ptr<T>;
+		static constexpr bool Intrusive = false;
+	};
+
+	template<typename T>
+	using Ref = typename RefTraits<T>::Type;
 	template<typename T, typename ... Args>
 	constexpr Ref<T> CreateRef(Args&& ... args)
 	{
-		return std::make_shared<T>(std::forward<Args>(args)...);
+		if constexpr (RefTraits<T>::Intrusive)
+			return Ref<T>(new T(std::forward<Args>(args)...));
+		else
+			return std::make_shared<T>(std::forward<Args>(args)...);
 	}
 
 }
 
+// Makes Ref<type> an IntrusiveRef, type has to derive from RefCounted. Use in namespace Hazel,
+// after a declaration of type and before the first Ref<type>.
+#if HZ_INTRUSIVE_REFS
+	#define HZ_INTRUSIVE_REF(type) template<> struct RefTraits<type> { using Type = IntrusiveRef<type>; static constexpr bool Intrusive = true; };
+#else
+	#define HZ_INTRUSIVE_REF(type)
+#endif
+
 #include "XingXing/Core/Log.h"
 #include "XingXing/Core/Assert.h"
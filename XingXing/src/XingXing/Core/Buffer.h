@@ -18,6 +18,11 @@ namespace Hazel {
 			Allocate(size);
 		}
 
+		Buffer(const void* data, uint64_t size)
+			: Data((uint8_t*)data), Size(size)
+		{
+		}
+
 		Buffer(const Buffer&) = default;
 
 		static Buffer Copy(Buffer other)
@@ -27,6 +32,11 @@ namespace Hazel {
 			return result;
 		}
 
+		static Buffer Copy(const void* data, uint64_t size)
+		{
+			return Copy(Buffer(data, size));
+		}
+
 		void Allocate(uint64_t size)
 		{
 			Release();
@@ -0,0 +1,488 @@
+#pragma once
+
+#include "XingXing/Core/Base.h"
+
+#include <cstring>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define HZ_FLAT_HASH_MAP_SSE2 1
+	#include <emmintrin.h>
+#else
+	#define HZ_FLAT_HASH_MAP_SSE2 0
+#endif
+
+#ifdef _MSC_VER
+	#include <intrin.h>
+#endif
+
+namespace Hazel {
+
+	// Open addressing hash map storing its elements inline in one array. A parallel array of control
+	// bytes holds 7 bits of each element's hash, lookups compare a whole group of 16 control bytes at
+	// once (SSE2 where available) and only touch elements whose bits match.
+	//
+	// Unlike std::unordered_map, inserting or rehashing moves elements, so references and iterators
+	// are invalidated by any insertion.
+	template<typename Key, typename Value, typename Hash = std::hash<Key>, typename KeyEqual = std::equal_to<Key>>
+	class FlatHashMap
+	{
+	public:
+		using key_type = Key;
+		using mapped_type = Value;
+		using value_type = std::pair<const Key, Value>;
+		using size_type = size_t;
+
+		template<bool IsConst>
+		class Iterator
+		{
+		public:
+			using MapType = std::conditional_t<IsConst, const FlatHashMap, FlatHashMap>;
+			using Reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+			using Pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+
+			Iterator() = default;
+			Iterator(MapType* map, size_t index)
+				: m_Map(map), m_Index(index) { SkipEmpty(); }
+			// iterator -> const_iterator
+			template<bool OtherConst, typename = std::enable_if_t<IsConst && !OtherConst>>
+			Iterator(const Iterator<OtherConst>& other)
+				: m_Map(other.m_Map), m_Index(other.m_Index) {}
+
+			Reference operator*() const { return m_Map->m_Slots[m_Index]; }
+			Pointer operator->() const { return &m_Map->m_Slots[m_Index]; }
+
+			Iterator& operator++() { m_Index++; SkipEmpty(); return *this; }
+			Iterator operator++(int) { Iterator result = *this; ++(*this); return result; }
+
+			bool operator==(const Iterator& other) const { return m_Index == other.m_Index; }
+			bool operator!=(const Iterator& other) const { return m_Index != other.m_Index; }
+		private:
+			void SkipEmpty()
+			{
+				while (m_Index < m_Map->m_Capacity && !IsFull(m_Map->m_Control[m_Index]))
+					m_Index++;
+			}
+		private:
+			MapType* m_Map = nullptr;
+			size_t m_Index = 0;
+
+			friend class FlatHashMap;
+			friend class Iterator<!IsConst>;
+		};
+
+		using iterator = Iterator<false>;
+		using const_iterator = Iterator<true>;
+	public:
+		FlatHashMap() = default;
+
+		FlatHashMap(const FlatHashMap& other)
+		{
+			CopyFrom(other);
+		}
+
+		FlatHashMap(FlatHashMap&& other) noexcept
+		{
+			Swap(other);
+		}
+
+		~FlatHashMap()
+		{
+			Release();
+		}
+
+		FlatHashMap& operator=(const FlatHashMap& other)
+		{
+			if (this != &other)
+			{
+				Release();
+				CopyFrom(other);
+			}
+			return *this;
+		}
+
+		FlatHashMap& operator=(FlatHashMap&& other) noexcept
+		{
+			if (this != &other)
+			{
+				Release();
+				Swap(other);
+			}
+			return *this;
+		}
+
+		iterator begin() { return iterator(this, 0); }
+		iterator end() { return iterator(this, m_Capacity); }
+		const_iterator begin() const { return const_iterator(this, 0); }
+		const_iterator end() const { return const_iterator(this, m_Capacity); }
+
+		size_t size() const { return m_Size; }
+		bool empty() const { return m_Size == 0; }
+		size_t capacity() const { return m_Capacity; }
+
+		iterator find(const Key& key)
+		{
+			return iterator(this, FindIndex(key));
+		}
+
+		const_iterator find(const Key& key) const
+		{
+			return const_iterator(this, FindIndex(key));
+		}
+
+		bool contains(const Key& key) const { return FindIndex(key) != m_Capacity; }
+		size_t count(const Key& key) const { return contains(key) ? 1 : 0; }
+
+		Value& at(const Key& key)
+		{
+			size_t index = FindIndex(key);
+			HZ_CORE_ASSERT(index != m_Capacity, "Key not found!");
+			return m_Slots[index].second;
+		}
+
+		const Value& at(const Key& key) const
+		{
+			size_t index = FindIndex(key);
+			HZ_CORE_ASSERT(index != m_Capacity, "Key not found!");
+			return m_Slots[index].second;
+		}
+
+		Value& operator[](const Key& key)
+		{
+			return try_emplace(key).first->second;
+		}
+
+		template<typename... Args>
+		std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+		{
+			size_t hash = HashKey(key);
+			size_t index = FindIndex(key, hash);
+			if (index != m_Capacity)
+				return { iterator(this, index), false };
+
+			index = PrepareInsert(hash);
+			new (&m_Slots[index]) value_type(std::piecewise_construct, std::forward_as_tuple(key), std::forward_as_tuple(std::forward<Args>(args)...));
+			return { iterator(this, index), true };
+		}
+
+		std::pair<iterator, bool> insert(const value_type& value)
+		{
+			return try_emplace(value.first, value.second);
+		}
+
+		template<typename... Args>
+		std::pair<iterator, bool> emplace(const Key& key, Args&&... args)
+		{
+			return try_emplace(key, std::forward<Args>(args)...);
+		}
+
+		template<typename V>
+		std::pair<iterator, bool> insert_or_assign(const Key& key, V&& value)
+		{
+			auto result = try_emplace(key, std::forward<V>(value));
+			if (!result.second)
+				result.first->second = std::forward<V>(value);
+			return result;
+		}
+
+		size_t erase(const Key& key)
+		{
+			size_t index = FindIndex(key);
+			if (index == m_Capacity)
+				return 0;
+
+			EraseIndex(index);
+			return 1;
+		}
+
+		iterator erase(const_iterator it)
+		{
+			EraseIndex(it.m_Index);
+			return iterator(this, it.m_Index + 1);
+		}
+
+		void clear()
+		{
+			DestroySlots();
+			if (m_Capacity)
+				ResetControl();
+			m_Size = 0;
+			m_GrowthLeft = MaxLoad(m_Capacity);
+		}
+
+		void reserve(size_t count)
+		{
+			size_t capacity = GroupWidth;
+			while (MaxLoad(capacity) < count)
+				capacity *= 2;
+
+			if (capacity > m_Capacity)
+				Rehash(capacity);
+		}
+	private:
+		// Control bytes: negative for empty or deleted slots, the low 7 hash bits for full ones
+		static constexpr int8_t Empty = -128;
+		static constexpr int8_t Deleted = -2;
+		static constexpr size_t GroupWidth = 16;
+
+		static bool IsFull(int8_t control) { return control >= 0; }
+
+		// Max load factor is 7/8
+		static size_t MaxLoad(size_t capacity) { return capacity - capacity / 8; }
+
+		static size_t HashKey(const Key& key)
+		{
+			// Mix so the low and high bits both depend on the whole hash, std::hash is often the identity
+			uint64_t hash = (uint64_t)Hash()(key);
+			hash ^= hash >> 33;
+			hash *= 0xff51afd7ed558ccdull;
+			hash ^= hash >> 33;
+			return (size_t)hash;
+		}
+
+		static int8_t H2(size_t hash) { return (int8_t)(hash & 0x7F); }
+		static size_t H1(size_t hash) { return hash >> 7; }
+
+		static uint32_t CountTrailingZeros(uint32_t mask)
+		{
+#ifdef _MSC_VER
+			unsigned long index;
+			_BitScanForward(&index, mask);
+			return (uint32_t)index;
+#else
+			return (uint32_t)__builtin_ctz(mask);
+#endif
+		}
+
+		// Bit i is set if control byte i of the group equals value
+		static uint32_t MatchByte(const int8_t* group, int8_t value)
+		{
+#if HZ_FLAT_HASH_MAP_SSE2
+			__m128i controls = _mm_loadu_si128((const __m128i*)group);
+			return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(controls, _mm_set1_epi8(value)));
+#else
+			uint32_t mask = 0;
+			for (uint32_t i = 0; i < GroupWidth; i++)
+			{
+				if (group[i] == value)
+					mask |= 1u << i;
+			}
+			return mask;
+#endif
+		}
+
+		static uint32_t MatchEmptyOrDeleted(const int8_t* group)
+		{
+#if HZ_FLAT_HASH_MAP_SSE2
+			return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#else
+			uint32_t mask = 0;
+			for (uint32_t i = 0; i < GroupWidth; i++)
+			{
+				if (!IsFull(group[i]))
+					mask |= 1u << i;
+			}
+			return mask;
+#endif
+		}
+
+		size_t FindIndex(const Key& key) const
+		{
+			return FindIndex(key, HashKey(key));
+		}
+
+		// m_Capacity if the key isn't present
+		size_t FindIndex(const Key& key, size_t hash) const
+		{
+			if (m_Capacity == 0)
+				return m_Capacity;
+
+			const size_t mask = m_Capacity - 1;
+			const int8_t h2 = H2(hash);
+
+			// Triangular probing over groups visits every group once for power of two capacities
+			size_t position = H1(hash) & mask;
+			size_t step = 0;
+			while (true)
+			{
+				const int8_t* group = m_Control + position;
+				for (uint32_t match = MatchByte(group, h2); match; match &= match - 1)
+				{
+					size_t index = (position + CountTrailingZeros(match)) & mask;
+					if (KeyEqual()(m_Slots[index].first, key))
+						return index;
+				}
+
+				if (MatchByte(group, Empty))
+					return m_Capacity;
+
+				step += GroupWidth;
+				position = (position + step) & mask;
+			}
+		}
+
+		size_t FindInsertIndex(size_t hash) const
+		{
+			const size_t mask = m_Capacity - 1;
+
+			size_t position = H1(hash) & mask;
+			size_t step = 0;
+			while (true)
+			{
+				if (uint32_t match = MatchEmptyOrDeleted(m_Control + position))
+					return (position + CountTrailingZeros(match)) & mask;
+
+				step += GroupWidth;
+				position = (position + step) & mask;
+			}
+		}
+
+		// Claims a slot for a key known not to be present, growing the table if needed
+		size_t PrepareInsert(size_t hash)
+		{
+			size_t index = m_Capacity ? FindInsertIndex(hash) : 0;
+			if (m_Capacity == 0 || (m_GrowthLeft == 0 && m_Control[index] != Deleted))
+			{
+				// Deleted slots count against the load, rehashing in place is enough if they make up most of it
+				Rehash(m_Capacity == 0 ? GroupWidth : (m_Size + 1 > MaxLoad(m_Capacity) / 2 ? m_Capacity * 2 : m_Capacity));
+				index = FindInsertIndex(hash);
+			}
+
+			if (m_Control[index] == Empty)
+				m_GrowthLeft--;
+
+			SetControl(index, H2(hash));
+			m_Size++;
+			return index;
+		}
+
+		void EraseIndex(size_t index)
+		{
+			m_Slots[index].~value_type();
+			SetControl(index, Deleted);
+			m_Size--;
+		}
+
+		// The first group is mirrored behind the end, so groups starting near the end can be loaded in one go
+		void SetControl(size_t index, int8_t control)
+		{
+			m_Control[index] = control;
+			if (index < GroupWidth - 1)
+				m_Control[m_Capacity + index] = control;
+		}
+
+		void ResetControl()
+		{
+			std::memset(m_Control, (uint8_t)Empty, m_Capacity + GroupWidth);
+		}
+
+		void Rehash(size_t newCapacity)
+		{
+			int8_t* oldControl = m_Control;
+			value_type* oldSlots = m_Slots;
+			size_t oldCapacity = m_Capacity;
+
+			Allocate(newCapacity);
+			m_GrowthLeft = MaxLoad(m_Capacity) - m_Size;
+
+			for (size_t i = 0; i < oldCapacity; i++)
+			{
+				if (!IsFull(oldControl[i]))
+					continue;
+
+				size_t hash = HashKey(oldSlots[i].first);
+				size_t index = FindInsertIndex(hash);
+				SetControl(index, H2(hash));
+				new (&m_Slots[index]) value_type(std::move(const_cast<Key&>(oldSlots[i].first)), std::move(oldSlots[i].second));
+				oldSlots[i].~value_type();
+			}
+
+			Deallocate(oldControl, oldSlots, oldCapacity);
+		}
+
+		void Allocate(size_t capacity)
+		{
+			m_Capacity = capacity;
+			m_Control = new int8_t[capacity + GroupWidth];
+			m_Slots = std::allocator<value_type>().allocate(capacity);
+			ResetControl();
+		}
+
+		static void Deallocate(int8_t* control, value_type* slots, size_t capacity)
+		{
+			if (capacity == 0)
+				return;
+
+			delete[] control;
+			std::allocator<value_type>().deallocate(slots, capacity);
+		}
+
+		void DestroySlots()
+		{
+			if constexpr (!std::is_trivially_destructible_v<value_type>)
+			{
+				for (size_t i = 0; i < m_Capacity; i++)
+				{
+					if (IsFull(m_Control[i]))
+						m_Slots[i].~value_type();
+				}
+			}
+		}
+
+		void Release()
+		{
+			DestroySlots();
+			Deallocate(m_Control, m_Slots, m_Capacity);
+			m_Control = nullptr;
+			m_Slots = nullptr;
+			m_Capacity = 0;
+			m_Size = 0;
+			m_GrowthLeft = 0;
+		}
+
+		void CopyFrom(const FlatHashMap& other)
+		{
+			if (other.m_Capacity == 0)
+				return;
+
+			Allocate(other.m_Capacity);
+			std::memcpy(m_Control, other.m_Control, m_Capacity + GroupWidth);
+			m_Size = other.m_Size;
+			m_GrowthLeft = other.m_GrowthLeft;
+
+			// Same capacity and hashes, so every element keeps its slot
+			if constexpr (std::is_trivially_copy_constructible_v<Key> && std::is_trivially_copy_constructible_v<Value>)
+			{
+				std::memcpy((void*)m_Slots, other.m_Slots, m_Capacity * sizeof(value_type));
+			}
+			else
+			{
+				for (size_t i = 0; i < m_Capacity; i++)
+				{
+					if (IsFull(m_Control[i]))
+						new (&m_Slots[i]) value_type(other.m_Slots[i]);
+				}
+			}
+		}
+
+		void Swap(FlatHashMap& other)
+		{
+			std::swap(m_Control, other.m_Control);
+			std::swap(m_Slots, other.m_Slots);
+			std::swap(m_Capacity, other.m_Capacity);
+			std::swap(m_Size, other.m_Size);
+			std::swap(m_GrowthLeft, other.m_GrowthLeft);
+		}
+	private:
+		int8_t* m_Control = nullptr;
+		value_type* m_Slots = nullptr;
+		size_t m_Capacity = 0; // 0 or a power of two, at least GroupWidth
+		size_t m_Size = 0;
+		// Empty slots that can still be filled before the max load is reached
+		size_t m_GrowthLeft = 0;
+	};
+
+}
@@ -0,0 +1,185 @@
+#include "hzpch.h"
+#include "XingXing/Core/FrameAllocator.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace Hazel {
+
+	namespace Utils {
+
+		static uint64_t AlignUp(uint64_t value, uint64_t alignment)
+		{
+			return (value + alignment - 1) & ~(alignment - 1);
+		}
+
+		// Returns the block to free later in block and the aligned address within it
+		static void* AllocateOverflow(uint64_t size, uint64_t alignment, void*& block)
+		{
+			block = ::operator new((size_t)(size + alignment));
+			return (void*)AlignUp((uint64_t)(uintptr_t)block, alignment);
+		}
+
+		static void FreeOverflow(void* block)
+		{
+			::operator delete(block);
+		}
+
+	}
+
+	LinearAllocator::LinearAllocator(uint64_t capacity)
+		: m_Data(new uint8_t[capacity]), m_Capacity(capacity)
+	{
+	}
+
+	LinearAllocator::~LinearAllocator()
+	{
+		Reset();
+		delete[] m_Data;
+	}
+
+	void* LinearAllocator::Allocate(uint64_t size, uint64_t alignment)
+	{
+		HZ_CORE_ASSERT((alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+		uint64_t offset = Utils::AlignUp((uint64_t)(uintptr_t)(m_Data + m_Offset), alignment) - (uint64_t)(uintptr_t)m_Data;
+		if (offset + size <= m_Capacity)
+		{
+			m_Offset = offset + size;
+			return m_Data + offset;
+		}
+
+		void* block;
+		void* data = Utils::AllocateOverflow(size, alignment, block);
+		m_Overflow.push_back(block);
+		return data;
+	}
+
+	void LinearAllocator::Rewind(Marker marker)
+	{
+		HZ_CORE_ASSERT(marker.Offset <= m_Offset && marker.OverflowCount <= m_Overflow.size());
+
+		for (size_t i = marker.OverflowCount; i < m_Overflow.size(); i++)
+			Utils::FreeOverflow(m_Overflow[i]);
+		m_Overflow.resize(marker.OverflowCount);
+		m_Offset = marker.Offset;
+	}
+
+	struct FrameArena
+	{
+		Scope<uint8_t[]> Data;
+		std::atomic<uint64_t> Offset = 0;
+
+		std::mutex OverflowMutex;
+		std::vector<void*> Overflow;
+
+		void Reset()
+		{
+			for (void* data : Overflow)
+				Utils::FreeOverflow(data);
+			Overflow.clear();
+			Offset.store(0, std::memory_order_relaxed);
+		}
+	};
+
+	class FrameMemoryResource : public std::pmr::memory_resource
+	{
+	private:
+		virtual void* do_allocate(size_t bytes, size_t alignment) override { return FrameAllocator::Allocate(bytes, alignment); }
+		virtual void do_deallocate([[maybe_unused]] void* p, [[maybe_unused]] size_t bytes, [[maybe_unused]] size_t alignment) override {}
+		virtual bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	};
+
+	struct FrameAllocatorData
+	{
+		uint64_t Capacity = 0;
+		FrameArena Arenas[2];
+		uint32_t CurrentArena = 0;
+
+		FrameMemoryResource MemoryResource;
+		FrameAllocator::Statistics Stats;
+	};
+
+	static FrameAllocatorData* s_Data = nullptr;
+
+	void FrameAllocator::Init(uint64_t capacity)
+	{
+		HZ_CORE_ASSERT(!s_Data, "FrameAllocator already initialized!");
+
+		s_Data = new FrameAllocatorData();
+		s_Data->Capacity = capacity;
+		for (FrameArena& arena : s_Data->Arenas)
+			arena.Data = CreateScope<uint8_t[]>(capacity);
+		s_Data->Stats.Capacity = capacity;
+	}
+
+	void FrameAllocator::Shutdown()
+	{
+		if (!s_Data)
+			return;
+
+		for (FrameArena& arena : s_Data->Arenas)
+			arena.Reset();
+
+		delete s_Data;
+		s_Data = nullptr;
+	}
+
+	void* FrameAllocator::Allocate(uint64_t size, uint64_t alignment)
+	{
+		HZ_CORE_ASSERT(s_Data, "FrameAllocator not initialized!");
+		HZ_CORE_ASSERT((alignment & (alignment - 1)) == 0, "Alignment must be a power of two");
+
+		FrameArena& arena = s_Data->Arenas[s_Data->CurrentArena];
+
+		// Reserve enough to align any start, the arena itself is aligned for std::max_align_t
+		uint64_t reserved = size + (alignment > alignof(std::max_align_t) ? alignment : 0);
+		uint64_t offset = arena.Offset.fetch_add(Utils::AlignUp(reserved, alignof(std::max_align_t)), std::memory_order_relaxed);
+		if (offset + reserved <= s_Data->Capacity)
+		{
+			uint8_t* data = arena.Data.get() + offset;
+			return (void*)Utils::AlignUp((uint64_t)(uintptr_t)data, alignment);
+		}
+
+		void* block;
+		void* data = Utils::AllocateOverflow(size, alignment, block);
+		std::lock_guard lock(arena.OverflowMutex);
+		arena.Overflow.push_back(block);
+		return data;
+	}
+
+	std::pmr::memory_resource* FrameAllocator::GetMemoryResource()
+	{
+		return &s_Data->MemoryResource;
+	}
+
+	void FrameAllocator::NextFrame()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		FrameArena& finished = s_Data->Arenas[s_Data->CurrentArena];
+		s_Data->Stats.UsedLastFrame = std::min(finished.Offset.load(std::memory_order_relaxed), s_Data->Capacity);
+		s_Data->Stats.OverflowsLastFrame = (uint32_t)finished.Overflow.size();
+
+		s_Data->CurrentArena = 1 - s_Data->CurrentArena;
+		s_Data->Arenas[s_Data->CurrentArena].Reset();
+	}
+
+	FrameAllocator::Statistics FrameAllocator::GetStats()
+	{
+		return s_Data ? s_Data->Stats : Statistics();
+	}
+
+	LinearAllocator& ScratchAllocator::Get()
+	{
+		static thread_local LinearAllocator s_Allocator(1024 * 1024);
+		return s_Allocator;
+	}
+
+	std::pmr::memory_resource* ScratchAllocator::GetMemoryResource()
+	{
+		static thread_local LinearMemoryResource s_MemoryResource(Get());
+		return &s_MemoryResource;
+	}
+
+}
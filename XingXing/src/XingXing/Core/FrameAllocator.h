@@ -0,0 +1,123 @@
+#pragma once
+
+#include "XingXing/Core/Base.h"
+
+#include <cstddef>
+#include <memory_resource>
+#include <vector>
+
+namespace Hazel {
+
+	// Bump allocator over one block. Individual allocations are never freed, the allocator is
+	// rewound to a marker or reset as a whole. Once the block is full allocations fall back to
+	// the heap until the next rewind or reset. Not thread safe.
+	class LinearAllocator
+	{
+	public:
+		struct Marker
+		{
+			uint64_t Offset = 0;
+			uint32_t OverflowCount = 0;
+		};
+	public:
+		LinearAllocator(uint64_t capacity);
+		~LinearAllocator();
+
+		LinearAllocator(const LinearAllocator&) = delete;
+		LinearAllocator& operator=(const LinearAllocator&) = delete;
+
+		void* Allocate(uint64_t size, uint64_t alignment = alignof(std::max_align_t));
+
+		// Uninitialized storage for count objects
+		template<typename T>
+		T* Allocate(uint64_t count = 1)
+		{
+			return (T*)Allocate(sizeof(T) * count, alignof(T));
+		}
+
+		Marker GetMarker() const { return { m_Offset, (uint32_t)m_Overflow.size() }; }
+		// Frees everything allocated after the marker was taken
+		void Rewind(Marker marker);
+		void Reset() { Rewind({}); }
+
+		uint64_t GetCapacity() const { return m_Capacity; }
+		uint64_t GetUsed() const { return m_Offset; }
+		uint32_t GetOverflowCount() const { return (uint32_t)m_Overflow.size(); }
+	private:
+		uint8_t* m_Data = nullptr;
+		uint64_t m_Capacity = 0;
+		uint64_t m_Offset = 0;
+		std::vector<void*> m_Overflow;
+	};
+
+	// std::pmr adapter, so standard containers can allocate from a LinearAllocator.
+	// Deallocation does nothing, the memory comes back when the allocator is rewound.
+	class LinearMemoryResource : public std::pmr::memory_resource
+	{
+	public:
+		LinearMemoryResource(LinearAllocator& allocator)
+			: m_Allocator(allocator) {}
+	private:
+		virtual void* do_allocate(size_t bytes, size_t alignment) override { return m_Allocator.Allocate(bytes, alignment); }
+		virtual void do_deallocate([[maybe_unused]] void* p, [[maybe_unused]] size_t bytes, [[maybe_unused]] size_t alignment) override {}
+		virtual bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+	private:
+		LinearAllocator& m_Allocator;
+	};
+
+	// Memory for data that lives no longer than a frame. There are two arenas; NextFrame switches
+	// between them and resets the one it switches to, so an allocation stays valid until the end of
+	// the following frame and can be handed to the render thread. Allocating is thread safe.
+	class FrameAllocator
+	{
+	public:
+		struct Statistics
+		{
+			uint64_t Capacity = 0; // Bytes per arena
+			uint64_t UsedLastFrame = 0;
+			uint32_t OverflowsLastFrame = 0; // Allocations that didn't fit and went to the heap
+		};
+	public:
+		static void Init(uint64_t capacity = 4 * 1024 * 1024);
+		static void Shutdown();
+
+		static void* Allocate(uint64_t size, uint64_t alignment = alignof(std::max_align_t));
+
+		template<typename T>
+		static T* Allocate(uint64_t count = 1)
+		{
+			return (T*)Allocate(sizeof(T) * count, alignof(T));
+		}
+
+		static std::pmr::memory_resource* GetMemoryResource();
+
+		// Call once per frame on the main thread, after the render thread has finished the frame before last
+		static void NextFrame();
+
+		static Statistics GetStats();
+	};
+
+	// Per-thread scratch memory for temporaries that don't leave the function using them.
+	// Take a ScratchScope first, it gives the memory back when it goes out of scope.
+	class ScratchAllocator
+	{
+	public:
+		static LinearAllocator& Get();
+		static std::pmr::memory_resource* GetMemoryResource();
+	};
+
+	class ScratchScope
+	{
+	public:
+		ScratchScope()
+			: m_Allocator(ScratchAllocator::Get()), m_Marker(m_Allocator.GetMarker()) {}
+		~ScratchScope() { m_Allocator.Rewind(m_Marker); }
+
+		ScratchScope(const ScratchScope&) = delete;
+		ScratchScope& operator=(const ScratchScope&) = delete;
+	private:
+		LinearAllocator& m_Allocator;
+		LinearAllocator::Marker m_Marker;
+	};
+
+}
@@ -0,0 +1,313 @@
+#include "hzpch.h"
+#include "XingXing/Core/JobSystem.h"
+
+#include <condition_variable>
+#include <deque>
+#include <thread>
+
+namespace Hazel {
+
+	struct WorkerQueue
+	{
+		std::mutex Mutex;
+		std::deque<Job> Jobs;
+	};
+
+	struct JobSystemData
+	{
+		std::vector<std::thread> Workers;
+		std::vector<Scope<WorkerQueue>> WorkerQueues;
+
+		// Jobs submitted from threads outside the pool
+		WorkerQueue GlobalQueue;
+
+		std::mutex MainThreadMutex;
+		std::vector<Job> MainThreadJobs;
+		std::thread::id MainThreadID;
+
+		std::atomic<uint32_t> QueuedJobCount = 0;
+		std::atomic<bool> Running = false;
+		std::mutex SleepMutex;
+		std::condition_variable WakeCondition;
+	};
+
+	static JobSystemData s_Data;
+
+	// Index into WorkerQueues for pool threads, -1 everywhere else
+	static thread_local int32_t s_WorkerIndex = -1;
+
+	void JobSystem::Init(uint32_t workerCount)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		HZ_CORE_ASSERT(!s_Data.Running, "JobSystem already initialized!");
+
+		s_Data.MainThreadID = std::this_thread::get_id();
+		HZ_PROFILE_THREAD("Main Thread");
+
+		if (workerCount == 0)
+		{
+			uint32_t hardwareThreads = std::thread::hardware_concurrency();
+			workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+		}
+
+		s_Data.Running = true;
+		s_Data.WorkerQueues.resize(workerCount);
+		for (uint32_t i = 0; i < workerCount; i++)
+			s_Data.WorkerQueues[i] = CreateScope<WorkerQueue>();
+
+		for (uint32_t i = 0; i < workerCount; i++)
+			s_Data.Workers.emplace_back(&JobSystem::WorkerLoop, i);
+
+		HZ_CORE_INFO("JobSystem: {0} worker threads", workerCount);
+	}
+
+	void JobSystem::Shutdown()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		{
+			std::scoped_lock<std::mutex> lock(s_Data.SleepMutex);
+			s_Data.Running = false;
+		}
+		s_Data.WakeCondition.notify_all();
+
+		for (std::thread& worker : s_Data.Workers)
+			worker.join();
+
+		s_Data.Workers.clear();
+		s_Data.WorkerQueues.clear();
+		s_Data.QueuedJobCount = 0;
+
+		// Jobs still queued here were never waited for, run them so their counters are released
+		ExecuteMainThreadJobs();
+	}
+
+	void JobSystem::Execute(JobFunction job, JobCounter* counter, JobCounter* dependency)
+	{
+		if (counter)
+			counter->m_Count.fetch_add(1, std::memory_order_relaxed);
+
+		Job entry = { std::move(job), counter };
+
+		if (dependency)
+		{
+			std::scoped_lock<std::mutex> lock(dependency->m_Mutex);
+			if (dependency->m_Count.load(std::memory_order_acquire) > 0)
+			{
+				dependency->m_Continuations.push_back(std::move(entry));
+				return;
+			}
+		}
+
+		Schedule(std::move(entry));
+	}
+
+	void JobSystem::ExecuteOnMainThread(JobFunction job, JobCounter* counter)
+	{
+		if (counter)
+			counter->m_Count.fetch_add(1, std::memory_order_relaxed);
+
+		std::scoped_lock<std::mutex> lock(s_Data.MainThreadMutex);
+		s_Data.MainThreadJobs.push_back({ std::move(job), counter });
+	}
+
+	void JobSystem::ExecuteMainThreadJobs()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		HZ_CORE_ASSERT(IsMainThread());
+
+		std::vector<Job> jobs;
+		{
+			std::scoped_lock<std::mutex> lock(s_Data.MainThreadMutex);
+			jobs.swap(s_Data.MainThreadJobs);
+		}
+
+		for (Job& job : jobs)
+			RunJob(job);
+	}
+
+	void JobSystem::Wait(JobCounter& counter)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		bool isMainThread = IsMainThread();
+		while (!counter.IsDone())
+		{
+			Job job;
+			if (TryGetJob(job))
+				RunJob(job);
+			else if (isMainThread)
+				ExecuteMainThreadJobs();
+			else
+				std::this_thread::yield();
+		}
+
+		// The last job may still be releasing the counter's lock
+		std::scoped_lock<std::mutex> lock(counter.m_Mutex);
+	}
+
+	void JobSystem::ParallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t, uint32_t)>& func)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (count == 0)
+			return;
+
+		grainSize = std::max(grainSize, 1u);
+		uint32_t rangeCount = (count + grainSize - 1) / grainSize;
+		if (rangeCount == 1 || s_Data.Workers.empty())
+		{
+			func(0, count);
+			return;
+		}
+
+		// The calling thread takes the first range itself
+		JobCounter counter;
+		for (uint32_t range = 1; range < rangeCount; range++)
+		{
+			uint32_t begin = range * grainSize;
+			uint32_t end = std::min(begin + grainSize, count);
+			Execute([&func, begin, end]() { func(begin, end); }, &counter);
+		}
+
+		func(0, std::min(grainSize, count));
+		Wait(counter);
+	}
+
+	uint32_t JobSystem::GetWorkerCount()
+	{
+		return (uint32_t)s_Data.Workers.size();
+	}
+
+	int32_t JobSystem::GetWorkerIndex()
+	{
+		return s_WorkerIndex;
+	}
+
+	bool JobSystem::IsMainThread()
+	{
+		return std::this_thread::get_id() == s_Data.MainThreadID;
+	}
+
+	void JobSystem::Schedule(Job&& job)
+	{
+		if (!s_Data.Running)
+		{
+			RunJob(job);
+			return;
+		}
+
+		WorkerQueue& queue = s_WorkerIndex >= 0 ? *s_Data.WorkerQueues[s_WorkerIndex] : s_Data.GlobalQueue;
+		{
+			std::scoped_lock<std::mutex> lock(queue.Mutex);
+			queue.Jobs.push_back(std::move(job));
+		}
+
+		s_Data.QueuedJobCount.fetch_add(1, std::memory_order_release);
+
+		// Taking the lock orders this wake-up after a worker's check of the queued job count
+		{
+			std::scoped_lock<std::mutex> lock(s_Data.SleepMutex);
+		}
+		s_Data.WakeCondition.notify_one();
+	}
+
+	bool JobSystem::TryGetJob(Job& outJob)
+	{
+		if (s_Data.QueuedJobCount.load(std::memory_order_acquire) == 0)
+			return false;
+
+		auto tryPop = [&outJob](WorkerQueue& queue, bool back)
+		{
+			std::scoped_lock<std::mutex> lock(queue.Mutex);
+			if (queue.Jobs.empty())
+				return false;
+
+			if (back)
+			{
+				outJob = std::move(queue.Jobs.back());
+				queue.Jobs.pop_back();
+			}
+			else
+			{
+				outJob = std::move(queue.Jobs.front());
+				queue.Jobs.pop_front();
+			}
+
+			s_Data.QueuedJobCount.fetch_sub(1, std::memory_order_relaxed);
+			return true;
+		};
+
+		// Own work first, newest first, while it is still in cache
+		int32_t workerIndex = s_WorkerIndex;
+		if (workerIndex >= 0 && tryPop(*s_Data.WorkerQueues[workerIndex], true))
+			return true;
+
+		if (tryPop(s_Data.GlobalQueue, false))
+			return true;
+
+		// Steal the oldest job of another worker, starting next to this one so thieves spread out
+		uint32_t queueCount = (uint32_t)s_Data.WorkerQueues.size();
+		uint32_t start = workerIndex >= 0 ? (uint32_t)workerIndex + 1 : 0;
+		for (uint32_t i = 0; i < queueCount; i++)
+		{
+			uint32_t victim = (start + i) % queueCount;
+			if ((int32_t)victim != workerIndex && tryPop(*s_Data.WorkerQueues[victim], false))
+				return true;
+		}
+
+		return false;
+	}
+
+	void JobSystem::RunJob(Job& job)
+	{
+		job.Function();
+		FinishJob(job.Counter);
+	}
+
+	void JobSystem::FinishJob(JobCounter* counter)
+	{
+		if (!counter)
+			return;
+
+		std::vector<Job> continuations;
+		{
+			std::scoped_lock<std::mutex> lock(counter->m_Mutex);
+			if (counter->m_Count.fetch_sub(1, std::memory_order_acq_rel) == 1)
+				continuations.swap(counter->m_Continuations);
+		}
+
+		for (Job& job : continuations)
+			Schedule(std::move(job));
+	}
+
+	void JobSystem::WorkerLoop(uint32_t workerIndex)
+	{
+		s_WorkerIndex = (int32_t)workerIndex;
+
+		std::string name = "Worker " + std::to_string(workerIndex);
+		HZ_PROFILE_THREAD(name);
+
+		while (true)
+		{
+			Job job;
+			if (TryGetJob(job))
+			{
+				RunJob(job);
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(s_Data.SleepMutex);
+			s_Data.WakeCondition.wait(lock, []()
+			{
+				return s_Data.QueuedJobCount.load(std::memory_order_acquire) > 0 || !s_Data.Running;
+			});
+
+			if (!s_Data.Running && s_Data.QueuedJobCount.load(std::memory_order_acquire) == 0)
+				break;
+		}
+	}
+
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "XingXing/Core/Base.h"
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace Hazel {
+
+	using JobFunction = std::function<void()>;
+
+	class JobCounter;
+
+	struct Job
+	{
+		JobFunction Function;
+		JobCounter* Counter = nullptr;
+	};
+
+	// Counts the unfinished jobs of a group. Jobs can be made to depend on a counter,
+	// they are scheduled once it drops to zero. Must outlive the jobs counted against it.
+	class JobCounter
+	{
+	public:
+		JobCounter() = default;
+		JobCounter(const JobCounter&) = delete;
+		JobCounter& operator=(const JobCounter&) = delete;
+
+		bool IsDone() const { return m_Count.load(std::memory_order_acquire) == 0; }
+		uint32_t GetCount() const { return m_Count.load(std::memory_order_acquire); }
+	private:
+		std::atomic<uint32_t> m_Count = 0;
+		std::mutex m_Mutex;
+		std::vector<Job> m_Continuations;
+
+		friend class JobSystem;
+	};
+
+	// Pool of worker threads, one per hardware thread besides the main thread. Every worker owns a
+	// deque it pushes to and pops from at the back; idle workers steal from the front of the others.
+	// Jobs submitted from outside the pool go through a shared queue.
+	class JobSystem
+	{
+	public:
+		// 0 sizes the pool from the hardware concurrency
+		static void Init(uint32_t workerCount = 0);
+		static void Shutdown();
+
+		// Runs the job on a worker. The counter is incremented right away and decremented when the job
+		// has finished; with a dependency the job is only scheduled once that counter reaches zero.
+		// Without workers the job runs immediately on the calling thread.
+		static void Execute(JobFunction job, JobCounter* counter = nullptr, JobCounter* dependency = nullptr);
+
+		// For work that has to happen on the main thread, e.g. anything touching the graphics context
+		// when there is no render thread. Runs in ExecuteMainThreadJobs or while the main thread waits.
+		static void ExecuteOnMainThread(JobFunction job, JobCounter* counter = nullptr);
+		static void ExecuteMainThreadJobs();
+
+		// Blocks until the counter reaches zero, executing queued jobs in the meantime
+		static void Wait(JobCounter& counter);
+
+		// Splits [0, count) into ranges of at most grainSize and calls func(begin, end) for each in parallel.
+		// Returns once every range has been processed; the calling thread takes part.
+		static void ParallelFor(uint32_t count, uint32_t grainSize, const std::function<void(uint32_t, uint32_t)>& func);
+
+		static uint32_t GetWorkerCount();
+		// Index of the calling pool thread, -1 for threads outside the pool
+		static int32_t GetWorkerIndex();
+		static bool IsMainThread();
+	private:
+		static void Schedule(Job&& job);
+		static bool TryGetJob(Job& outJob);
+		static void RunJob(Job& job);
+		static void FinishJob(JobCounter* counter);
+		static void WorkerLoop(uint32_t workerIndex);
+	};
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "XingXing/Core/Base.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace Hazel {
+
+	// Storage for objects of one type that are created and destroyed often. Slots are allocated
+	// BlockSize at a time and never go back to the heap, freed slots are reused first. Types use it
+	// by defining class-specific operator new and delete on top of Get(). Not thread safe.
+	template<typename T, uint32_t BlockSize = 256>
+	class ObjectPool
+	{
+	public:
+		ObjectPool() = default;
+		~ObjectPool()
+		{
+			for (void* block : m_Blocks)
+				::operator delete(block);
+		}
+
+		ObjectPool(const ObjectPool&) = delete;
+		ObjectPool& operator=(const ObjectPool&) = delete;
+
+		// Uninitialized storage for one T
+		void* Allocate()
+		{
+			if (!m_FreeList)
+				AllocateBlock();
+
+			Slot* slot = m_FreeList;
+			m_FreeList = slot->Next;
+			m_LiveCount++;
+			return slot;
+		}
+
+		void Free(void* object)
+		{
+			if (!object)
+				return;
+
+			Slot* slot = (Slot*)object;
+			slot->Next = m_FreeList;
+			m_FreeList = slot;
+			m_LiveCount--;
+		}
+
+		uint32_t GetLiveCount() const { return m_LiveCount; }
+		uint32_t GetCapacity() const { return (uint32_t)m_Blocks.size() * BlockSize; }
+
+		static ObjectPool& Get()
+		{
+			static ObjectPool s_Pool;
+			return s_Pool;
+		}
+	private:
+		union Slot
+		{
+			Slot* Next;
+			alignas(T) uint8_t Storage[sizeof(T)];
+		};
+		static_assert(alignof(T) <= alignof(std::max_align_t), "Blocks are only aligned for std::max_align_t");
+
+		void AllocateBlock()
+		{
+			Slot* block = (Slot*)::operator new(sizeof(Slot) * BlockSize);
+			m_Blocks.push_back(block);
+
+			// Linked in address order, so consecutive allocations are adjacent
+			for (uint32_t i = 0; i < BlockSize; i++)
+				block[i].Next = i + 1 < BlockSize ? &block[i + 1] : m_FreeList;
+			m_FreeList = block;
+		}
+	private:
+		std::vector<void*> m_Blocks;
+		Slot* m_FreeList = nullptr;
+		uint32_t m_LiveCount = 0;
+	};
+
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <stdint.h>
+#include <utility>
+
+namespace Hazel {
+
+	// Base for types that keep their own reference count, for use with IntrusiveRef. The count is not
+	// atomic: only take and drop references on one thread, in practice the main thread.
+	class RefCounted
+	{
+	public:
+		RefCounted() = default;
+		// A copy is a new object, it starts without references
+		RefCounted(const RefCounted&) {}
+		RefCounted& operator=(const RefCounted&) { return *this; }
+
+		uint32_t GetRefCount() const { return m_RefCount; }
+	private:
+		mutable uint32_t m_RefCount = 0;
+
+		template<typename T>
+		friend class IntrusiveRef;
+	};
+
+	// Smart pointer to a RefCounted object, the object is deleted with the last reference. The count
+	// lives in the object, so there is no separate control block and copies don't touch atomics.
+	// Named like std::shared_ptr so code written against Ref<T> compiles with either. Converting to
+	// a base type requires that base to have a virtual destructor.
+	template<typename T>
+	class IntrusiveRef
+	{
+	public:
+		IntrusiveRef() = default;
+		IntrusiveRef(std::nullptr_t) {}
+
+		explicit IntrusiveRef(T* instance)
+			: m_Instance(instance)
+		{
+			IncRef();
+		}
+
+		IntrusiveRef(const IntrusiveRef& other)
+			: m_Instance(other.m_Instance)
+		{
+			IncRef();
+		}
+
+		IntrusiveRef(IntrusiveRef&& other) noexcept
+			: m_Instance(other.m_Instance)
+		{
+			other.m_Instance = nullptr;
+		}
+
+		template<typename U>
+		IntrusiveRef(const IntrusiveRef<U>& other)
+			: m_Instance(other.get())
+		{
+			IncRef();
+		}
+
+		~IntrusiveRef()
+		{
+			DecRef();
+		}
+
+		IntrusiveRef& operator=(const IntrusiveRef& other)
+		{
+			// Taken first, so assigning a reference to itself keeps the object alive
+			other.IncRef();
+			DecRef();
+			m_Instance = other.m_Instance;
+			return *this;
+		}
+
+		IntrusiveRef& operator=(IntrusiveRef&& other) noexcept
+		{
+			if (this != &other)
+			{
+				DecRef();
+				m_Instance = other.m_Instance;
+				other.m_Instance = nullptr;
+			}
+			return *this;
+		}
+
+		IntrusiveRef& operator=(std::nullptr_t)
+		{
+			reset();
+			return *this;
+		}
+
+		void reset()
+		{
+			DecRef();
+			m_Instance = nullptr;
+		}
+
+		T* get() const { return m_Instance; }
+		T* operator->() const { return m_Instance; }
+		T& operator*() const { return *m_Instance; }
+
+		uint32_t use_count() const { return m_Instance ? m_Instance->m_RefCount : 0; }
+
+		explicit operator bool() const { return m_Instance != nullptr; }
+
+		template<typename U>
+		bool operator==(const IntrusiveRef<U>& other) const { return m_Instance == other.get(); }
+		template<typename U>
+		bool operator!=(const IntrusiveRef<U>& other) const { return m_Instance != other.get(); }
+		bool operator==(std::nullptr_t) const { return m_Instance == nullptr; }
+		bool operator!=(std::nullptr_t) const { return m_Instance != nullptr; }
+	private:
+		void IncRef() const
+		{
+			if (m_Instance)
+				m_Instance->m_RefCount++;
+		}
+
+		void DecRef()
+		{
+			if (m_Instance && --m_Instance->m_RefCount == 0)
+				delete m_Instance;
+		}
+	private:
+		T* m_Instance = nullptr;
+	};
+
+}
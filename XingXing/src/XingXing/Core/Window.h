@@ -7,16 +7,20 @@
 
 namespace Hazel {
 
+	class GraphicsContext;
+
 	struct WindowProps
 	{
 		std::string Title;
 		uint32_t Width;
 		uint32_t Height;
+		bool Visible;
 
 		WindowProps(const std::string& title = "Hazel Engine",
 			        uint32_t width = 1600,
-			        uint32_t height = 900)
-			: Title(title), Width(width), Height(height)
+			        uint32_t height = 900,
+			        bool visible = true)
+			: Title(title), Width(width), Height(height), Visible(visible)
 		{
 		}
 	};
@@ -40,6 +44,7 @@ namespace Hazel {
 		virtual bool IsVSync() const = 0;
 
 		virtual void* GetNativeWindow() const = 0;
+		virtual GraphicsContext& GetContext() = 0;
 
 		static Scope<Window> Create(const WindowProps& props = WindowProps());
 	};
@@ -9,7 +9,7 @@
 #include <string>
 #include <thread>
 #include <mutex>
-#include <sstream>
+#include <unordered_map>
 
 namespace Hazel {
 
@@ -17,7 +17,8 @@ namespace Hazel {
 
 	struct ProfileResult
 	{
-		std::string Name;
+		// Owned by the timer that wrote the result, copying it would allocate for every scope
+		const char* Name;
 
 		FloatingPointMicroseconds Start;
 		std::chrono::microseconds ElapsedTime;
@@ -74,27 +75,28 @@ namespace Hazel {
 
 		void WriteProfile(const ProfileResult& result)
 		{
-			std::stringstream json;
-
-			json << std::setprecision(3) << std::fixed;
-			json << ",{";
-			json << "\"cat\":\"function\",";
-			json << "\"dur\":" << (result.ElapsedTime.count()) << ',';
-			json << "\"name\":\"" << result.Name << "\",";
-			json << "\"ph\":\"X\",";
-			json << "\"pid\":0,";
-			json << "\"tid\":" << result.ThreadID << ",";
-			json << "\"ts\":" << result.Start.count();
-			json << "}";
+			// Formatted on the stack, only names longer than the inline buffer allocate
+			fmt::memory_buffer json;
+			fmt::format_to(json, ",{{\"cat\":\"function\",\"dur\":{},\"name\":\"{}\",\"ph\":\"X\",\"pid\":0,\"tid\":{},\"ts\":{:.3f}}}",
+				result.ElapsedTime.count(), result.Name, GetThreadID(result.ThreadID), result.Start.count());
 
 			std::lock_guard lock(m_Mutex);
 			if (m_CurrentSession)
 			{
-				m_OutputStream << json.str();
+				m_OutputStream.write(json.data(), json.size());
 				m_OutputStream.flush();
 			}
 		}
 
+		// Names show up in the trace viewer instead of the thread ID; kept across sessions
+		void SetThreadName(const std::string& name)
+		{
+			std::lock_guard lock(m_Mutex);
+			m_ThreadNames[std::this_thread::get_id()] = name;
+			if (m_CurrentSession)
+				WriteThreadName(std::this_thread::get_id(), name);
+		}
+
 		static Instrumentor& Get()
 		{
 			static Instrumentor instance;
@@ -114,9 +116,31 @@ namespace Hazel {
 		void WriteHeader()
 		{
 			m_OutputStream << "{\"otherData\": {},\"traceEvents\":[{}";
+			for (auto& [threadID, name] : m_ThreadNames)
+				WriteThreadName(threadID, name);
 			m_OutputStream.flush();
 		}
 
+		// Note: you must already own lock on m_Mutex before
+		// calling WriteThreadName()
+		void WriteThreadName(std::thread::id threadID, const std::string& name)
+		{
+			m_OutputStream << ",{";
+			m_OutputStream << "\"args\":{\"name\":\"" << name << "\"},";
+			m_OutputStream << "\"name\":\"thread_name\",";
+			m_OutputStream << "\"ph\":\"M\",";
+			m_OutputStream << "\"pid\":0,";
+			m_OutputStream << "\"tid\":" << GetThreadID(threadID);
+			m_OutputStream << "}";
+			m_OutputStream.flush();
+		}
+
+		// Numeric, so the trace events and thread names can be written without a stream
+		static size_t GetThreadID(std::thread::id threadID)
+		{
+			return std::hash<std::thread::id>()(threadID);
+		}
+
 		void WriteFooter()
 		{
 			m_OutputStream << "]}";
@@ -139,6 +163,7 @@ namespace Hazel {
 		std::mutex m_Mutex;
 		InstrumentationSession* m_CurrentSession;
 		std::ofstream m_OutputStream;
+		std::unordered_map<std::thread::id, std::string> m_ThreadNames;
 	};
 
 	class InstrumentationTimer
@@ -202,7 +227,10 @@ namespace Hazel {
 	}
 }
 
-#define HZ_PROFILE 0
+// Define HZ_PROFILE as 1 for the whole workspace to record the engine's scopes
+#ifndef HZ_PROFILE
+	#define HZ_PROFILE 0
+#endif
 #if HZ_PROFILE
 	// Resolve which function signature macro will be used. Note that this only
 	// is resolved when the (pre)compiler starts, so the syntax highlighting
@@ -232,9 +260,14 @@ namespace Hazel {
 	#define HZ_PROFILE_SCOPE_LINE(name, line) HZ_PROFILE_SCOPE_LINE2(name, line)
 	#define HZ_PROFILE_SCOPE(name) HZ_PROFILE_SCOPE_LINE(name, __LINE__)
 	#define HZ_PROFILE_FUNCTION() HZ_PROFILE_SCOPE(HZ_FUNC_SIG)
+	// For names only known at runtime, the string has to outlive the scope
+	#define HZ_PROFILE_SCOPE_DYNAMIC(name) ::Hazel::InstrumentationTimer timer##__LINE__(name)
+	#define HZ_PROFILE_THREAD(name) ::Hazel::Instrumentor::Get().SetThreadName(name)
 #else
 	#define HZ_PROFILE_BEGIN_SESSION(name, filepath)
 	#define HZ_PROFILE_END_SESSION()
 	#define HZ_PROFILE_SCOPE(name)
 	#define HZ_PROFILE_FUNCTION()
+	#define HZ_PROFILE_SCOPE_DYNAMIC(name)
+	#define HZ_PROFILE_THREAD(name)
 #endif
\ No newline at end of file
@@ -8,6 +8,7 @@
 #include <examples/imgui_impl_opengl3.h>
 
 #include "XingXing/Core/Application.h"
+#include "XingXing/Renderer/Renderer.h"
 
 // TEMPORARY
 #include <GLFW/glfw3.h>
@@ -17,6 +18,43 @@
 
 namespace Hazel {
 
+	// ImGui rebuilds its draw lists every frame, so the render thread is handed its own copy of them.
+	// Two copies are enough because the render thread runs at most one frame behind.
+	struct ImGuiFrameDrawData
+	{
+		ImDrawData DrawData;
+		std::vector<ImDrawList*> DrawLists;
+	};
+
+	static ImGuiFrameDrawData s_FrameDrawData[2];
+	static uint32_t s_FrameDrawDataIndex = 0;
+
+	static ImDrawData* CaptureDrawData(ImDrawData* drawData)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		ImGuiFrameDrawData& frame = s_FrameDrawData[s_FrameDrawDataIndex];
+		s_FrameDrawDataIndex = (s_FrameDrawDataIndex + 1) % 2;
+
+		while (frame.DrawLists.size() < (size_t)drawData->CmdListsCount)
+			frame.DrawLists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+
+		// Swapping keeps both sides' allocations alive, ImGui resets its lists at the start of the next frame anyway
+		for (int i = 0; i < drawData->CmdListsCount; i++)
+		{
+			ImDrawList* source = drawData->CmdLists[i];
+			ImDrawList* destination = frame.DrawLists[i];
+			destination->CmdBuffer.swap(source->CmdBuffer);
+			destination->IdxBuffer.swap(source->IdxBuffer);
+			destination->VtxBuffer.swap(source->VtxBuffer);
+			destination->Flags = source->Flags;
+		}
+
+		frame.DrawData = *drawData;
+		frame.DrawData.CmdLists = frame.DrawLists.data();
+		return &frame.DrawData;
+	}
+
 	ImGuiLayer::ImGuiLayer()
 		: Layer("ImGuiLayer")
 	{
@@ -33,7 +71,10 @@ namespace Hazel {
 		io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;       // Enable Keyboard Controls
 		//io.ConfigFlags |= ImGuiConfigFlags_NavEnableGamepad;      // Enable Gamepad Controls
 		io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;           // Enable Docking
-		io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;         // Enable Multi-Viewport / Platform Windows
+		Application& app = Application::Get();
+		// Platform windows render on the thread that owns their context, which only works when rendering stays on the main thread
+		if (app.GetSpecification().RenderThreadingPolicy != ThreadingPolicy::MultiThreaded)
+			io.ConfigFlags |= ImGuiConfigFlags_ViewportsEnable;     // Enable Multi-Viewport / Platform Windows
 		//io.ConfigFlags |= ImGuiConfigFlags_ViewportsNoTaskBarIcons;
 		//io.ConfigFlags |= ImGuiConfigFlags_ViewportsNoMerge;
 
@@ -55,20 +96,40 @@ namespace Hazel {
 
 		SetDarkThemeColors();
 
-		Application& app = Application::Get();
 		GLFWwindow* window = static_cast<GLFWwindow*>(app.GetWindow().GetNativeWindow());
 
 		// Setup Platform/Renderer bindings
 		ImGui_ImplGlfw_InitForOpenGL(window, true);
-		ImGui_ImplOpenGL3_Init("#version 410");
+
+		// The font atlas is built here so that only the upload happens on the render thread
+		unsigned char* pixels;
+		int width, height;
+		io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+		Renderer::Submit([]()
+		{
+			ImGui_ImplOpenGL3_Init("#version 410");
+			ImGui_ImplOpenGL3_CreateDeviceObjects();
+		});
 	}
 
 	void ImGuiLayer::OnDetach()
 	{
 		HZ_PROFILE_FUNCTION();
 
-		ImGui_ImplOpenGL3_Shutdown();
+		Renderer::Submit([]()
+		{
+			ImGui_ImplOpenGL3_Shutdown();
+		});
 		ImGui_ImplGlfw_Shutdown();
+
+		for (ImGuiFrameDrawData& frame : s_FrameDrawData)
+		{
+			for (ImDrawList* drawList : frame.DrawLists)
+				IM_DELETE(drawList);
+			frame.DrawLists.clear();
+		}
+
 		ImGui::DestroyContext();
 	}
 
@@ -86,7 +147,10 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
-		ImGui_ImplOpenGL3_NewFrame();
+		Renderer::Submit([]()
+		{
+			ImGui_ImplOpenGL3_NewFrame();
+		});
 		ImGui_ImplGlfw_NewFrame();
 		ImGui::NewFrame();
 		ImGuizmo::BeginFrame();
@@ -102,14 +166,25 @@ namespace Hazel {
 
 		// Rendering
 		ImGui::Render();
-		ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
+		ImDrawData* drawData = CaptureDrawData(ImGui::GetDrawData());
+		Renderer::Submit([drawData]()
+		{
+			ImGui_ImplOpenGL3_RenderDrawData(drawData);
+		});
 
 		if (io.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
 		{
+			// Creating platform windows switches the current context on this thread
 			GLFWwindow* backup_current_context = glfwGetCurrentContext();
 			ImGui::UpdatePlatformWindows();
-			ImGui::RenderPlatformWindowsDefault();
 			glfwMakeContextCurrent(backup_current_context);
+
+			Renderer::Submit([]()
+			{
+				GLFWwindow* backup_current_context = glfwGetCurrentContext();
+				ImGui::RenderPlatformWindowsDefault();
+				glfwMakeContextCurrent(backup_current_context);
+			});
 		}
 	}
 
@@ -3,6 +3,8 @@
 
 #include "ProjectSerializer.h"
 
+#include "XingXing/Renderer/TextureAtlas.h"
+
 namespace Hazel {
 
 	Ref<Project> Project::New()
@@ -20,6 +22,15 @@ namespace Hazel {
 		{
 			project->m_ProjectDirectory = path.parent_path();
 			s_ActiveProject = project;
+
+			const auto& spriteAtlasDirectory = project->m_Config.SpriteAtlasDirectory;
+			if (!spriteAtlasDirectory.empty())
+			{
+				project->m_SpriteAtlas = CreateRef<TextureAtlas>();
+				project->m_SpriteAtlas->AddDirectory(GetAssetFileSystemPath(spriteAtlasDirectory));
+				project->m_SpriteAtlas->Build();
+			}
+
 			return s_ActiveProject;
 		}
 
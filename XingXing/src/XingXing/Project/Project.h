@@ -15,8 +15,13 @@ namespace Hazel {
 
 		std::filesystem::path AssetDirectory;
 		std::filesystem::path ScriptModulePath;
+
+		// Relative to the asset directory; small images below it are packed into a sprite atlas on load
+		std::filesystem::path SpriteAtlasDirectory;
 	};
 
+	class TextureAtlas;
+
 	class Project
 	{
 	public:
@@ -41,6 +46,13 @@ namespace Hazel {
 
 		ProjectConfig& GetConfig() { return m_Config; }
 
+		// Null if the project has no sprite atlas directory
+		static Ref<TextureAtlas> GetSpriteAtlas()
+		{
+			HZ_CORE_ASSERT(s_ActiveProject);
+			return s_ActiveProject->m_SpriteAtlas;
+		}
+
 		static Ref<Project> GetActive() { return s_ActiveProject; }
 
 		static Ref<Project> New();
@@ -49,6 +61,7 @@ namespace Hazel {
 	private:
 		ProjectConfig m_Config;
 		std::filesystem::path m_ProjectDirectory;
+		Ref<TextureAtlas> m_SpriteAtlas;
 
 		inline static Ref<Project> s_ActiveProject;
 	};
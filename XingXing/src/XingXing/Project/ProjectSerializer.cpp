@@ -25,6 +25,8 @@ namespace Hazel {
 				out << YAML::Key << "StartScene" << YAML::Value << config.StartScene.string();
 				out << YAML::Key << "AssetDirectory" << YAML::Value << config.AssetDirectory.string();
 				out << YAML::Key << "ScriptModulePath" << YAML::Value << config.ScriptModulePath.string();
+				if (!config.SpriteAtlasDirectory.empty())
+					out << YAML::Key << "SpriteAtlasDirectory" << YAML::Value << config.SpriteAtlasDirectory.string();
 				out << YAML::EndMap; // Project
 			}
 			out << YAML::EndMap; // Root
@@ -59,6 +61,8 @@ namespace Hazel {
 		config.StartScene = projectNode["StartScene"].as<std::string>();
 		config.AssetDirectory = projectNode["AssetDirectory"].as<std::string>();
 		config.ScriptModulePath = projectNode["ScriptModulePath"].as<std::string>();
+		if (projectNode["SpriteAtlasDirectory"])
+			config.SpriteAtlasDirectory = projectNode["SpriteAtlasDirectory"].as<std::string>();
 		return true;
 	}
 
@@ -145,7 +145,7 @@ namespace Hazel {
 	}
 
 
-	Ref<Font> Font::GetDefault()
+	const Ref<Font>& Font::GetDefault()
 	{
 		static Ref<Font> DefaultFont;
 		if (!DefaultFont)
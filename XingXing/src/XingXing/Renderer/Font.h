@@ -16,9 +16,9 @@ namespace Hazel {
 		~Font();
 
 		const MSDFData* GetMSDFData() const { return m_Data; }
-		Ref<Texture2D> GetAtlasTexture() const { return m_AtlasTexture; }
+		const Ref<Texture2D>& GetAtlasTexture() const { return m_AtlasTexture; }
 
-		static Ref<Font> GetDefault();
+		static const Ref<Font>& GetDefault();
 	private:
 		MSDFData* m_Data;
 		Ref<Texture2D> m_AtlasTexture;
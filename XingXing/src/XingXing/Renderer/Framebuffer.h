@@ -56,6 +56,8 @@ namespace Hazel {
 		virtual void Unbind() = 0;
 
 		virtual void Resize(uint32_t width, uint32_t height) = 0;
+		// Queues a read of the pixel and returns the result of the previous request,
+		// since the read itself happens on the render thread
 		virtual int ReadPixel(uint32_t attachmentIndex, int x, int y) = 0;
 
 		virtual void ClearAttachment(uint32_t attachmentIndex, int value) = 0;
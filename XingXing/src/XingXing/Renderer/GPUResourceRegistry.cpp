@@ -0,0 +1,247 @@
+#include "hzpch.h"
+#include "XingXing/Renderer/GPUResourceRegistry.h"
+
+#include "XingXing/Core/JobSystem.h"
+
+namespace Hazel {
+
+	struct EvictableTexture
+	{
+		std::weak_ptr<Texture2D> Texture;
+		uint64_t LastUsedFrame = 0;
+		bool Evicted = false;
+		bool Restoring = false; // Bound while evicted, the source is being decoded
+	};
+
+	struct GPUResourceRegistryData
+	{
+		// Resources are created on the main thread but destroyed on the render thread
+		std::mutex Mutex;
+
+		std::unordered_map<const void*, uint64_t> Allocations[(size_t)GPUResourceCategory::Count];
+		std::unordered_map<const Texture*, EvictableTexture> EvictableTextures;
+		std::vector<Ref<Texture2D>> PendingRestores;
+
+		uint64_t Budget = 0;
+		uint64_t FrameIndex = 1;
+
+		GPUResourceRegistry::Statistics Stats;
+	};
+
+	static GPUResourceRegistryData* s_Data = new GPUResourceRegistryData(); // Leaked so that resources destroyed during static destruction can still untrack
+
+	const char* GPUResourceCategoryToString(GPUResourceCategory category)
+	{
+		switch (category)
+		{
+			case GPUResourceCategory::Texture:      return "Textures";
+			case GPUResourceCategory::Framebuffer:  return "Framebuffers";
+			case GPUResourceCategory::VertexBuffer: return "Vertex Buffers";
+			case GPUResourceCategory::IndexBuffer:  return "Index Buffers";
+			case GPUResourceCategory::Count:        break;
+		}
+
+		HZ_CORE_ASSERT(false, "Unknown GPUResourceCategory!");
+		return "";
+	}
+
+	void GPUResourceRegistry::Track(GPUResourceCategory category, const void* resource, uint64_t size)
+	{
+		std::scoped_lock<std::mutex> lock(s_Data->Mutex);
+
+		size_t index = (size_t)category;
+		auto [it, inserted] = s_Data->Allocations[index].try_emplace(resource, size);
+		if (inserted)
+		{
+			s_Data->Stats.ResourceCount[index]++;
+		}
+		else
+		{
+			s_Data->Stats.Usage[index] -= it->second;
+			it->second = size;
+		}
+
+		s_Data->Stats.Usage[index] += size;
+	}
+
+	void GPUResourceRegistry::Untrack(GPUResourceCategory category, const void* resource)
+	{
+		std::scoped_lock<std::mutex> lock(s_Data->Mutex);
+
+		size_t index = (size_t)category;
+		auto it = s_Data->Allocations[index].find(resource);
+		if (it != s_Data->Allocations[index].end())
+		{
+			s_Data->Stats.Usage[index] -= it->second;
+			s_Data->Stats.ResourceCount[index]--;
+			s_Data->Allocations[index].erase(it);
+		}
+
+		if (category == GPUResourceCategory::Texture)
+		{
+			auto evictable = s_Data->EvictableTextures.find((const Texture*)resource);
+			if (evictable != s_Data->EvictableTextures.end())
+			{
+				if (evictable->second.Evicted)
+					s_Data->Stats.EvictedTextureCount--;
+				s_Data->EvictableTextures.erase(evictable);
+			}
+		}
+	}
+
+	void GPUResourceRegistry::RegisterEvictable(const Ref<Texture2D>& texture)
+	{
+		std::scoped_lock<std::mutex> lock(s_Data->Mutex);
+
+		// Last used frame 0 means never bound; those are left alone since they may be displayed
+		// through their renderer ID (e.g. ImGui icons), which does not go through MarkUsed
+		s_Data->EvictableTextures[texture.get()] = { texture, 0, false, false };
+	}
+
+	void GPUResourceRegistry::MarkUsed(const Texture* texture)
+	{
+		std::scoped_lock<std::mutex> lock(s_Data->Mutex);
+
+		auto it = s_Data->EvictableTextures.find(texture);
+		if (it == s_Data->EvictableTextures.end())
+			return;
+
+		EvictableTexture& entry = it->second;
+		entry.LastUsedFrame = s_Data->FrameIndex;
+
+		// Bound while rendering, reading the file here would stall the frame. The low resolution
+		// copy is drawn until NextFrame has had the source decoded and uploaded.
+		if (entry.Evicted && !entry.Restoring)
+		{
+			if (Ref<Texture2D> restore = entry.Texture.lock())
+			{
+				entry.Restoring = true;
+				s_Data->PendingRestores.push_back(restore);
+			}
+		}
+	}
+
+	static void FinishRestore(const Ref<Texture2D>& texture, TextureImage image, bool decoded)
+	{
+		// Restoring tracks the new size, so it must not happen under the lock
+		if (decoded)
+			texture->Restore(image);
+		else
+			HZ_CORE_WARN("Could not restore evicted texture '{0}', it keeps its low resolution copy", texture->GetPath());
+
+		std::scoped_lock<std::mutex> lock(s_Data->Mutex);
+		auto it = s_Data->EvictableTextures.find(texture.get());
+		if (it == s_Data->EvictableTextures.end())
+			return;
+
+		s_Data->Stats.EvictedTextureCount--;
+		if (decoded)
+		{
+			it->second.Evicted = false;
+			it->second.Restoring = false;
+		}
+		else
+		{
+			// Left alone from now on rather than retried every time it is bound
+			s_Data->EvictableTextures.erase(it);
+		}
+	}
+
+	static void StartRestores(std::vector<Ref<Texture2D>>& textures)
+	{
+		for (Ref<Texture2D>& texture : textures)
+		{
+			JobSystem::Execute([texture = std::move(texture)]()
+			{
+				TextureImage image;
+				bool decoded = texture->DecodeSource(image);
+
+				// Uploads go through the main thread, which owns the render command queue
+				JobSystem::ExecuteOnMainThread([texture, image, decoded]()
+				{
+					FinishRestore(texture, image, decoded);
+				});
+			});
+		}
+	}
+
+	// Least recently used first, called under the lock
+	static void CollectEvictionCandidates(std::vector<Ref<Texture2D>>& outCandidates)
+	{
+		// Anything bound in this or the previous frame is still in use; evicted textures, including those
+		// being restored, already are as small as they get
+		std::vector<std::pair<uint64_t, Ref<Texture2D>>> lru;
+		for (auto& [key, entry] : s_Data->EvictableTextures)
+		{
+			if (entry.Evicted || entry.LastUsedFrame == 0 || entry.LastUsedFrame + 1 >= s_Data->FrameIndex)
+				continue;
+
+			// Textures whose last reference is gone are waiting for the render thread to destroy them
+			if (Ref<Texture2D> texture = entry.Texture.lock())
+				lru.emplace_back(entry.LastUsedFrame, texture);
+		}
+
+		std::sort(lru.begin(), lru.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+		for (auto& [frame, texture] : lru)
+			outCandidates.push_back(texture);
+	}
+
+	void GPUResourceRegistry::NextFrame()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		std::vector<Ref<Texture2D>> restores;
+		std::vector<Ref<Texture2D>> candidates;
+		uint64_t budget;
+		{
+			std::scoped_lock<std::mutex> lock(s_Data->Mutex);
+
+			s_Data->FrameIndex++;
+			s_Data->Stats.EvictionsLastFrame = 0;
+			restores.swap(s_Data->PendingRestores);
+
+			budget = s_Data->Budget;
+			if (budget > 0 && s_Data->Stats.GetTotalUsage() > budget)
+				CollectEvictionCandidates(candidates);
+		}
+
+		StartRestores(restores);
+
+		for (Ref<Texture2D>& texture : candidates)
+		{
+			if (GetStats().GetTotalUsage() <= budget)
+				break;
+
+			if (!texture->Evict())
+				continue;
+
+			std::scoped_lock<std::mutex> lock(s_Data->Mutex);
+			auto it = s_Data->EvictableTextures.find(texture.get());
+			if (it != s_Data->EvictableTextures.end())
+			{
+				it->second.Evicted = true;
+				s_Data->Stats.EvictedTextureCount++;
+				s_Data->Stats.EvictionsLastFrame++;
+			}
+		}
+	}
+
+	uint64_t GPUResourceRegistry::GetBudget()
+	{
+		std::scoped_lock<std::mutex> lock(s_Data->Mutex);
+		return s_Data->Budget;
+	}
+
+	void GPUResourceRegistry::SetBudget(uint64_t budget)
+	{
+		std::scoped_lock<std::mutex> lock(s_Data->Mutex);
+		s_Data->Budget = budget;
+	}
+
+	GPUResourceRegistry::Statistics GPUResourceRegistry::GetStats()
+	{
+		std::scoped_lock<std::mutex> lock(s_Data->Mutex);
+		return s_Data->Stats;
+	}
+
+}
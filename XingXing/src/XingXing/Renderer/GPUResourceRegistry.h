@@ -0,0 +1,59 @@
+#pragma once
+
+#include "XingXing/Renderer/Texture.h"
+
+namespace Hazel {
+
+	enum class GPUResourceCategory
+	{
+		Texture = 0,
+		Framebuffer,
+		VertexBuffer,
+		IndexBuffer,
+		Count
+	};
+
+	const char* GPUResourceCategoryToString(GPUResourceCategory category);
+
+	// Keeps track of how much GPU memory every API object uses and enforces a memory budget by
+	// evicting the least recently bound textures. Evicted textures keep a low resolution copy. Binding
+	// one queues its restore: the source is decoded on a worker and uploaded a few frames later.
+	class GPUResourceRegistry
+	{
+	public:
+		// Records or updates the size of an allocation owned by resource
+		static void Track(GPUResourceCategory category, const void* resource, uint64_t size);
+		static void Untrack(GPUResourceCategory category, const void* resource);
+
+		// Textures that can be reloaded from their source can be evicted under memory pressure
+		static void RegisterEvictable(const Ref<Texture2D>& texture);
+		// Called whenever a texture is bound for rendering, queues its restore if it was evicted
+		static void MarkUsed(const Texture* texture);
+
+		// Advances the LRU clock, starts the queued restores and evicts textures until usage fits the budget.
+		// Call once per frame on the main thread.
+		static void NextFrame();
+
+		// Budget in bytes across all categories, 0 disables eviction
+		static uint64_t GetBudget();
+		static void SetBudget(uint64_t budget);
+
+		struct Statistics
+		{
+			uint64_t Usage[(size_t)GPUResourceCategory::Count] = {};
+			uint32_t ResourceCount[(size_t)GPUResourceCategory::Count] = {};
+			uint32_t EvictedTextureCount = 0;
+			uint32_t EvictionsLastFrame = 0;
+
+			uint64_t GetTotalUsage() const
+			{
+				uint64_t total = 0;
+				for (uint64_t usage : Usage)
+					total += usage;
+				return total;
+			}
+		};
+		static Statistics GetStats();
+	};
+
+}
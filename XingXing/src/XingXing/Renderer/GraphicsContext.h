@@ -10,6 +10,10 @@ namespace Hazel {
 		virtual void Init() = 0;
 		virtual void SwapBuffers() = 0;
 
+		// Moves ownership of the context between the main thread and the render thread
+		virtual void MakeCurrent() = 0;
+		virtual void ReleaseCurrent() = 0;
+
 		static Scope<GraphicsContext> Create(void* window);
 	};
 
@@ -1,8 +1,66 @@
 #include "hzpch.h"
 #include "XingXing/Renderer/RenderCommand.h"
 
+#include "XingXing/Renderer/Renderer.h"
+
 namespace Hazel {
 
 	Scope<RendererAPI> RenderCommand::s_RendererAPI = RendererAPI::Create();
 
-}
\ No newline at end of file
+	void RenderCommand::Init()
+	{
+		Renderer::Submit([]()
+		{
+			s_RendererAPI->Init();
+		});
+	}
+
+	void RenderCommand::SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
+	{
+		Renderer::Submit([x, y, width, height]()
+		{
+			s_RendererAPI->SetViewport(x, y, width, height);
+		});
+	}
+
+	void RenderCommand::SetClearColor(const glm::vec4& color)
+	{
+		Renderer::Submit([color]()
+		{
+			s_RendererAPI->SetClearColor(color);
+		});
+	}
+
+	void RenderCommand::Clear()
+	{
+		Renderer::Submit([]()
+		{
+			s_RendererAPI->Clear();
+		});
+	}
+
+	void RenderCommand::DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount)
+	{
+		Renderer::Submit([vertexArray, indexCount]()
+		{
+			s_RendererAPI->DrawIndexed(vertexArray, indexCount);
+		});
+	}
+
+	void RenderCommand::DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount)
+	{
+		Renderer::Submit([vertexArray, vertexCount]()
+		{
+			s_RendererAPI->DrawLines(vertexArray, vertexCount);
+		});
+	}
+
+	void RenderCommand::SetLineWidth(float width)
+	{
+		Renderer::Submit([width]()
+		{
+			s_RendererAPI->SetLineWidth(width);
+		});
+	}
+
+}
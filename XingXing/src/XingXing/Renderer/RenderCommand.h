@@ -4,43 +4,20 @@
 
 namespace Hazel {
 
+	// Every call is recorded and executed on the render thread, see Renderer::Submit
 	class RenderCommand
 	{
 	public:
-		static void Init()
-		{
-			s_RendererAPI->Init();
-		}
+		static void Init();
 
-		static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height)
-		{
-			s_RendererAPI->SetViewport(x, y, width, height);
-		}
+		static void SetViewport(uint32_t x, uint32_t y, uint32_t width, uint32_t height);
+		static void SetClearColor(const glm::vec4& color);
+		static void Clear();
 
-		static void SetClearColor(const glm::vec4& color)
-		{
-			s_RendererAPI->SetClearColor(color);
-		}
+		static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0);
+		static void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount);
 
-		static void Clear()
-		{
-			s_RendererAPI->Clear();
-		}
-
-		static void DrawIndexed(const Ref<VertexArray>& vertexArray, uint32_t indexCount = 0)
-		{
-			s_RendererAPI->DrawIndexed(vertexArray, indexCount);
-		}
-
-		static void DrawLines(const Ref<VertexArray>& vertexArray, uint32_t vertexCount)
-		{
-			s_RendererAPI->DrawLines(vertexArray, vertexCount);
-		}
-
-		static void SetLineWidth(float width)
-		{
-			s_RendererAPI->SetLineWidth(width);
-		}
+		static void SetLineWidth(float width);
 	private:
 		static Scope<RendererAPI> s_RendererAPI;
 	};
@@ -0,0 +1,87 @@
+#include "hzpch.h"
+#include "XingXing/Renderer/RenderCommandQueue.h"
+
+namespace Hazel {
+
+	static constexpr uint64_t s_PageSize = 1024 * 1024;
+
+	struct alignas(RenderCommandQueue::CommandAlignment) RenderCommandHeader
+	{
+		RenderCommandQueue::RenderCommandFn Func;
+		uint32_t Size;
+	};
+
+	static uint64_t AlignCommandSize(uint64_t size)
+	{
+		return (size + RenderCommandQueue::CommandAlignment - 1) & ~(uint64_t)(RenderCommandQueue::CommandAlignment - 1);
+	}
+
+	RenderCommandQueue::RenderCommandQueue()
+	{
+		Page& page = m_Pages.emplace_back();
+		page.Storage.Allocate(s_PageSize);
+	}
+
+	RenderCommandQueue::~RenderCommandQueue()
+	{
+		for (Page& page : m_Pages)
+			page.Storage.Release();
+	}
+
+	void* RenderCommandQueue::Allocate(RenderCommandFn func, uint32_t size)
+	{
+		uint64_t requiredSize = sizeof(RenderCommandHeader) + AlignCommandSize(size);
+
+		Page* page = &m_Pages[m_CurrentPage];
+		if (page->Offset + requiredSize > page->Storage.Size)
+		{
+			m_CurrentPage++;
+			if (m_CurrentPage == m_Pages.size())
+				m_Pages.emplace_back();
+
+			page = &m_Pages[m_CurrentPage];
+			if (page->Storage.Size < requiredSize)
+				page->Storage.Allocate(std::max(s_PageSize, requiredSize));
+		}
+
+		RenderCommandHeader* header = (RenderCommandHeader*)(page->Storage.Data + page->Offset);
+		header->Func = func;
+		header->Size = size;
+		page->Offset += requiredSize;
+
+		m_CommandCount++;
+		return header + 1;
+	}
+
+	void RenderCommandQueue::Execute()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		for (uint32_t pageIndex = 0; pageIndex <= m_CurrentPage; pageIndex++)
+		{
+			Page& page = m_Pages[pageIndex];
+
+			uint64_t offset = 0;
+			while (offset < page.Offset)
+			{
+				RenderCommandHeader* header = (RenderCommandHeader*)(page.Storage.Data + offset);
+				header->Func(header + 1);
+				offset += sizeof(RenderCommandHeader) + AlignCommandSize(header->Size);
+			}
+
+			page.Offset = 0;
+		}
+
+		m_CurrentPage = 0;
+		m_CommandCount = 0;
+	}
+
+	uint64_t RenderCommandQueue::GetCapacity() const
+	{
+		uint64_t capacity = 0;
+		for (const Page& page : m_Pages)
+			capacity += page.Storage.Size;
+		return capacity;
+	}
+
+}
@@ -0,0 +1,44 @@
+#pragma once
+
+#include "XingXing/Core/Buffer.h"
+
+#include <vector>
+
+namespace Hazel {
+
+	// Linear command buffer that records type-erased render commands and replays them in submission order.
+	// Storage is split into pages that are kept between frames, so recording a frame does not allocate
+	// once the queue has grown to its working size and recorded commands never have to be relocated.
+	class RenderCommandQueue
+	{
+	public:
+		typedef void(*RenderCommandFn)(void*);
+
+		RenderCommandQueue();
+		~RenderCommandQueue();
+
+		RenderCommandQueue(const RenderCommandQueue&) = delete;
+		RenderCommandQueue& operator=(const RenderCommandQueue&) = delete;
+
+		// Returns storage for a command payload of the given size, aligned to CommandAlignment
+		void* Allocate(RenderCommandFn func, uint32_t size);
+
+		void Execute();
+
+		uint32_t GetCommandCount() const { return m_CommandCount; }
+		uint64_t GetCapacity() const;
+	public:
+		static constexpr uint32_t CommandAlignment = 16;
+	private:
+		struct Page
+		{
+			Buffer Storage;
+			uint64_t Offset = 0;
+		};
+
+		std::vector<Page> m_Pages;
+		uint32_t m_CurrentPage = 0;
+		uint32_t m_CommandCount = 0;
+	};
+
+}
@@ -0,0 +1,138 @@
+#include "hzpch.h"
+#include "XingXing/Renderer/RenderThread.h"
+
+#include "XingXing/Renderer/Renderer.h"
+
+namespace Hazel {
+
+	static thread_local bool s_IsRenderThread = false;
+
+	RenderThread::RenderThread(ThreadingPolicy policy)
+		: m_ThreadingPolicy(policy)
+	{
+		if (m_ThreadingPolicy == ThreadingPolicy::None)
+			s_IsRenderThread = true;
+	}
+
+	RenderThread::~RenderThread()
+	{
+		if (m_Running)
+			Terminate();
+	}
+
+	void RenderThread::Run()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		m_Running = true;
+
+		if (m_ThreadingPolicy != ThreadingPolicy::MultiThreaded)
+			return;
+
+		m_Thread = std::thread([this]()
+		{
+			HZ_PROFILE_THREAD("Render Thread");
+			HZ_PROFILE_FUNCTION();
+
+			s_IsRenderThread = true;
+
+			while (true)
+			{
+				WaitAndSet(State::Kick, State::Busy);
+				Renderer::ExecuteRenderCommandQueue();
+
+				// Checked after executing, so the queue handed over by Terminate always runs
+				bool running = m_Running;
+				Set(State::Idle);
+				if (!running)
+					break;
+			}
+		});
+	}
+
+	void RenderThread::Terminate()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		// Hand over what was recorded last, like releasing the context, and let the loop leave after
+		// executing it. Frees deferred from other threads stay pending instead of being recorded after
+		// it; the calling thread executes them once it owns the API
+		BlockUntilRenderComplete();
+		m_Running = false;
+		Renderer::SwapQueues(false);
+		Kick();
+
+		if (m_Thread.joinable())
+			m_Thread.join();
+
+		// From here on the calling thread owns the API, so late submissions (resource frees during
+		// shutdown) execute immediately
+		s_IsRenderThread = true;
+	}
+
+	void RenderThread::Wait(State waitForState)
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_ConditionVariable.wait(lock, [&]() { return m_State == waitForState; });
+	}
+
+	void RenderThread::WaitAndSet(State waitForState, State setToState)
+	{
+		std::unique_lock<std::mutex> lock(m_Mutex);
+		m_ConditionVariable.wait(lock, [&]() { return m_State == waitForState; });
+		m_State = setToState;
+		m_ConditionVariable.notify_all();
+	}
+
+	void RenderThread::Set(State setToState)
+	{
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+		m_State = setToState;
+		m_ConditionVariable.notify_all();
+	}
+
+	void RenderThread::NextFrame()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		Renderer::SwapQueues();
+	}
+
+	void RenderThread::Kick()
+	{
+		if (m_ThreadingPolicy == ThreadingPolicy::MultiThreaded && m_Thread.joinable())
+			Set(State::Kick);
+		else
+			ExecuteOnCallingThread();
+	}
+
+	void RenderThread::BlockUntilRenderComplete()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (m_ThreadingPolicy == ThreadingPolicy::MultiThreaded && m_Thread.joinable())
+			Wait(State::Idle);
+	}
+
+	void RenderThread::Pump()
+	{
+		BlockUntilRenderComplete();
+		NextFrame();
+		Kick();
+		BlockUntilRenderComplete();
+	}
+
+	bool RenderThread::IsCurrentThreadRT()
+	{
+		return s_IsRenderThread;
+	}
+
+	void RenderThread::ExecuteOnCallingThread()
+	{
+		bool wasRenderThread = s_IsRenderThread;
+		s_IsRenderThread = true;
+		Renderer::ExecuteRenderCommandQueue();
+		s_IsRenderThread = wasRenderThread;
+	}
+
+}
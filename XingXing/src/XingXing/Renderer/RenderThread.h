@@ -0,0 +1,64 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace Hazel {
+
+	enum class ThreadingPolicy
+	{
+		// Render commands execute as soon as they are submitted
+		None = 0,
+		// Render commands are recorded and replayed on the main thread at the frame boundary
+		SingleThreaded,
+		// Render commands are recorded and replayed on a dedicated render thread, one frame behind the main thread
+		MultiThreaded
+	};
+
+	class RenderThread
+	{
+	public:
+		enum class State
+		{
+			Idle = 0,
+			Busy,
+			Kick
+		};
+	public:
+		RenderThread(ThreadingPolicy policy);
+		~RenderThread();
+
+		void Run();
+		void Terminate();
+		bool IsRunning() const { return m_Running; }
+
+		void Wait(State waitForState);
+		void WaitAndSet(State waitForState, State setToState);
+		void Set(State setToState);
+
+		// Hands the commands recorded this frame over to the render thread
+		void NextFrame();
+		void Kick();
+		void BlockUntilRenderComplete();
+		// Executes everything recorded so far and waits for it to finish
+		void Pump();
+
+		ThreadingPolicy GetThreadingPolicy() const { return m_ThreadingPolicy; }
+
+		// True while executing render commands, or always when commands execute immediately
+		static bool IsCurrentThreadRT();
+	private:
+		void ExecuteOnCallingThread();
+	private:
+		ThreadingPolicy m_ThreadingPolicy;
+		std::thread m_Thread;
+		std::atomic<bool> m_Running = false;
+
+		std::mutex m_Mutex;
+		std::condition_variable m_ConditionVariable;
+		State m_State = State::Idle;
+	};
+
+}
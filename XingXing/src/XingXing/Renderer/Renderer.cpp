@@ -6,6 +6,13 @@ namespace Hazel {
 
 	Scope<Renderer::SceneData> Renderer::s_SceneData = CreateScope<Renderer::SceneData>();
 
+	static constexpr uint32_t s_RenderCommandQueueCount = 2;
+	static RenderCommandQueue s_CommandQueue[s_RenderCommandQueueCount];
+	static std::atomic<uint32_t> s_RenderCommandQueueSubmissionIndex = 0;
+
+	static std::mutex s_DeferredFreeMutex;
+	static std::vector<std::function<void()>> s_DeferredFrees;
+
 	void Renderer::Init()
 	{
 		HZ_PROFILE_FUNCTION();
@@ -17,6 +24,10 @@ namespace Hazel {
 	void Renderer::Shutdown()
 	{
 		Renderer2D::Shutdown();
+
+		// Flush whatever was recorded after the last frame
+		SwapQueues();
+		ExecuteRenderCommandQueue();
 	}
 
 	void Renderer::OnWindowResize(uint32_t width, uint32_t height)
@@ -43,4 +54,49 @@ namespace Hazel {
 		RenderCommand::DrawIndexed(vertexArray);
 	}
 
+	RenderCommandQueue& Renderer::GetRenderCommandQueue()
+	{
+		return s_CommandQueue[s_RenderCommandQueueSubmissionIndex];
+	}
+
+	void Renderer::DeferResourceFree(std::function<void()> func)
+	{
+		std::scoped_lock<std::mutex> lock(s_DeferredFreeMutex);
+		s_DeferredFrees.push_back(std::move(func));
+	}
+
+	void Renderer::SwapQueues(bool submitDeferredFrees)
+	{
+		// Recorded into the frame that is handed over, after every command that could still use the resources
+		if (submitDeferredFrees)
+		{
+			std::vector<std::function<void()>> frees;
+			{
+				std::scoped_lock<std::mutex> lock(s_DeferredFreeMutex);
+				frees.swap(s_DeferredFrees);
+			}
+			for (auto& free : frees)
+				Submit(std::move(free));
+		}
+
+		s_RenderCommandQueueSubmissionIndex = (s_RenderCommandQueueSubmissionIndex + 1) % s_RenderCommandQueueCount;
+	}
+
+	void Renderer::ExecuteRenderCommandQueue()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		s_CommandQueue[GetRenderQueueIndex()].Execute();
+	}
+
+	uint32_t Renderer::GetRenderQueueIndex()
+	{
+		return (s_RenderCommandQueueSubmissionIndex + 1) % s_RenderCommandQueueCount;
+	}
+
+	uint32_t Renderer::GetRenderQueueSubmissionIndex()
+	{
+		return s_RenderCommandQueueSubmissionIndex;
+	}
+
 }
@@ -1,6 +1,9 @@
 #pragma once
 
 #include "XingXing/Renderer/RenderCommand.h"
+#include "XingXing/Renderer/RenderCommandQueue.h"
+#include "XingXing/Renderer/RenderThread.h"
+#include "XingXing/Core/JobSystem.h"
 
 #include "XingXing/Renderer/OrthographicCamera.h"
 #include "XingXing/Renderer/Shader.h"
@@ -21,6 +24,64 @@ namespace Hazel {
 		static void Submit(const Ref<Shader>& shader, const Ref<VertexArray>& vertexArray, const glm::mat4& transform = glm::mat4(1.0f));
 
 		static RendererAPI::API GetAPI() { return RendererAPI::GetAPI(); }
+
+		// Records a command for the render thread. Must be called from the main thread; the command runs
+		// after the submitting code has moved on, so everything it touches has to be captured by value
+		template<typename FuncT>
+		static void Submit(FuncT&& func)
+		{
+			if (RenderThread::IsCurrentThreadRT())
+			{
+				func();
+				return;
+			}
+
+			HZ_CORE_ASSERT(JobSystem::IsMainThread(), "Render commands can only be recorded on the main thread!");
+
+			using CommandT = std::decay_t<FuncT>;
+			static_assert(alignof(CommandT) <= RenderCommandQueue::CommandAlignment, "Render command is over-aligned!");
+
+			auto renderCmd = [](void* ptr)
+			{
+				auto pFunc = (CommandT*)ptr;
+				(*pFunc)();
+				pFunc->~CommandT();
+			};
+
+			void* storageBuffer = GetRenderCommandQueue().Allocate(renderCmd, sizeof(CommandT));
+			new (storageBuffer) CommandT(std::forward<FuncT>(func));
+		}
+
+		// Resources that own API objects are created through here so that they are destroyed on the
+		// render thread, after every command recorded while they were still referenced
+		template<typename T, typename... Args>
+		static Ref<T> CreateResource(Args&&... args)
+		{
+			return Ref<T>(new T(std::forward<Args>(args)...), [](T* resource)
+			{
+				Renderer::SubmitResourceFree([resource]() { delete resource; });
+			});
+		}
+
+		// The last reference to a resource can be dropped on any thread. Frees from other threads than
+		// the main thread are queued and recorded at the next frame boundary.
+		template<typename FuncT>
+		static void SubmitResourceFree(FuncT&& func)
+		{
+			if (RenderThread::IsCurrentThreadRT() || JobSystem::IsMainThread())
+				Submit(std::forward<FuncT>(func));
+			else
+				DeferResourceFree(std::forward<FuncT>(func));
+		}
+
+		static void DeferResourceFree(std::function<void()> func);
+
+		static RenderCommandQueue& GetRenderCommandQueue();
+		static void SwapQueues(bool submitDeferredFrees = true);
+		static void ExecuteRenderCommandQueue();
+
+		static uint32_t GetRenderQueueIndex();
+		static uint32_t GetRenderQueueSubmissionIndex();
 	private:
 		struct SceneData
 		{
@@ -8,6 +8,7 @@
 
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <glm/gtc/constants.hpp>
 
 #include "MSDFData.h"
 
@@ -37,10 +38,16 @@ namespace Hazel {
 		int EntityID;
 	};
 
+	// Lines are expanded into quads in the vertex shader, so every vertex carries the whole segment
 	struct LineVertex
 	{
 		glm::vec3 Position;
+		glm::vec3 OtherPosition;
+		glm::vec3 JoinPosition; // Neighbouring polyline point, equal to Position at a free end
 		glm::vec4 Color;
+		glm::vec2 Corner; // x: side of the segment (-1/1), y: segment start (0) or end (1)
+		float Width;
+		int Cap;
 
 		// Editor-only
 		int EntityID;
@@ -58,6 +65,26 @@ namespace Hazel {
 		int EntityID;
 	};
 
+	// Must match the PrimitiveKind constants in Renderer2D_Unified.glsl
+	enum class UnifiedPrimitiveKind : int
+	{
+		Quad = 0, Circle, Text
+	};
+
+	// Single vertex format for quads, circles and text so they can share one batch in submission order
+	struct UnifiedVertex
+	{
+		glm::vec3 Position;
+		glm::vec4 Color;
+		glm::vec2 TexCoord; // Circles: local position
+		glm::vec2 Params; // Quads: tiling factor, circles: thickness and fade
+		float TexIndex;
+		int Kind;
+
+		// Editor-only
+		int EntityID;
+	};
+
 	struct Renderer2DData
 	{
 		static const uint32_t MaxQuads = 20000;
@@ -82,6 +109,10 @@ namespace Hazel {
 		Ref<VertexBuffer> TextVertexBuffer;
 		Ref<Shader> TextShader;
 
+		Ref<VertexArray> UnifiedVertexArray;
+		Ref<VertexBuffer> UnifiedVertexBuffer;
+		Ref<Shader> UnifiedShader;
+
 		uint32_t QuadIndexCount = 0;
 		QuadVertex* QuadVertexBufferBase = nullptr;
 		QuadVertex* QuadVertexBufferPtr = nullptr;
@@ -90,7 +121,7 @@ namespace Hazel {
 		CircleVertex* CircleVertexBufferBase = nullptr;
 		CircleVertex* CircleVertexBufferPtr = nullptr;
 
-		uint32_t LineVertexCount = 0;
+		uint32_t LineIndexCount = 0;
 		LineVertex* LineVertexBufferBase = nullptr;
 		LineVertex* LineVertexBufferPtr = nullptr;
 
@@ -98,7 +129,14 @@ namespace Hazel {
 		TextVertex* TextVertexBufferBase = nullptr;
 		TextVertex* TextVertexBufferPtr = nullptr;
 
+		uint32_t UnifiedIndexCount = 0;
+		UnifiedVertex* UnifiedVertexBufferBase = nullptr;
+		UnifiedVertex* UnifiedVertexBufferPtr = nullptr;
+
+		bool UseUnifiedPipeline = false;
+
 		float LineWidth = 2.0f;
+		glm::vec2 ViewportSize = { 1280.0f, 720.0f };
 
 		std::array<Ref<Texture2D>, MaxTextureSlots> TextureSlots;
 		uint32_t TextureSlotIndex = 1; // 0 = white texture
@@ -112,6 +150,8 @@ namespace Hazel {
 		struct CameraData
 		{
 			glm::mat4 ViewProjection;
+			glm::vec2 ViewportSize;
+			glm::vec2 Padding;
 		};
 		CameraData CameraBuffer;
 		Ref<UniformBuffer> CameraUniformBuffer;
@@ -179,11 +219,17 @@ namespace Hazel {
 
 		s_Data.LineVertexBuffer = VertexBuffer::Create(s_Data.MaxVertices * sizeof(LineVertex));
 		s_Data.LineVertexBuffer->SetLayout({
-			{ ShaderDataType::Float3, "a_Position" },
-			{ ShaderDataType::Float4, "a_Color"    },
-			{ ShaderDataType::Int,    "a_EntityID" }
+			{ ShaderDataType::Float3, "a_Position"      },
+			{ ShaderDataType::Float3, "a_OtherPosition" },
+			{ ShaderDataType::Float3, "a_JoinPosition"  },
+			{ ShaderDataType::Float4, "a_Color"         },
+			{ ShaderDataType::Float2, "a_Corner"        },
+			{ ShaderDataType::Float,  "a_Width"         },
+			{ ShaderDataType::Int,    "a_Cap"           },
+			{ ShaderDataType::Int,    "a_EntityID"      }
 		});
 		s_Data.LineVertexArray->AddVertexBuffer(s_Data.LineVertexBuffer);
+		s_Data.LineVertexArray->SetIndexBuffer(quadIB); // Use quad IB
 		s_Data.LineVertexBufferBase = new LineVertex[s_Data.MaxVertices];
 
 		// Text
@@ -200,6 +246,23 @@ namespace Hazel {
 		s_Data.TextVertexArray->SetIndexBuffer(quadIB);
 		s_Data.TextVertexBufferBase = new TextVertex[s_Data.MaxVertices];
 
+		// Unified
+		s_Data.UnifiedVertexArray = VertexArray::Create();
+
+		s_Data.UnifiedVertexBuffer = VertexBuffer::Create(s_Data.MaxVertices * sizeof(UnifiedVertex));
+		s_Data.UnifiedVertexBuffer->SetLayout({
+			{ ShaderDataType::Float3, "a_Position" },
+			{ ShaderDataType::Float4, "a_Color"    },
+			{ ShaderDataType::Float2, "a_TexCoord" },
+			{ ShaderDataType::Float2, "a_Params"   },
+			{ ShaderDataType::Float,  "a_TexIndex" },
+			{ ShaderDataType::Int,    "a_Kind"     },
+			{ ShaderDataType::Int,    "a_EntityID" }
+		});
+		s_Data.UnifiedVertexArray->AddVertexBuffer(s_Data.UnifiedVertexBuffer);
+		s_Data.UnifiedVertexArray->SetIndexBuffer(quadIB);
+		s_Data.UnifiedVertexBufferBase = new UnifiedVertex[s_Data.MaxVertices];
+
 		s_Data.WhiteTexture = Texture2D::Create(TextureSpecification());
 		uint32_t whiteTextureData = 0xffffffff;
 		s_Data.WhiteTexture->SetData(&whiteTextureData, sizeof(uint32_t));
@@ -212,6 +275,7 @@ namespace Hazel {
 		s_Data.CircleShader = Shader::Create("assets/shaders/Renderer2D_Circle.glsl");
 		s_Data.LineShader = Shader::Create("assets/shaders/Renderer2D_Line.glsl");
 		s_Data.TextShader = Shader::Create("assets/shaders/Renderer2D_Text.glsl");
+		s_Data.UnifiedShader = Shader::Create("assets/shaders/Renderer2D_Unified.glsl");
 
 		// Set first texture slot to 0
 		s_Data.TextureSlots[0] = s_Data.WhiteTexture;
@@ -229,6 +293,7 @@ namespace Hazel {
 		HZ_PROFILE_FUNCTION();
 
 		delete[] s_Data.QuadVertexBufferBase;
+		delete[] s_Data.UnifiedVertexBufferBase;
 	}
 
 	void Renderer2D::BeginScene(const OrthographicCamera& camera)
@@ -236,6 +301,7 @@ namespace Hazel {
 		HZ_PROFILE_FUNCTION();
 
 		s_Data.CameraBuffer.ViewProjection = camera.GetViewProjectionMatrix();
+		s_Data.CameraBuffer.ViewportSize = s_Data.ViewportSize;
 		s_Data.CameraUniformBuffer->SetData(&s_Data.CameraBuffer, sizeof(Renderer2DData::CameraData));
 
 		StartBatch();
@@ -246,6 +312,7 @@ namespace Hazel {
 		HZ_PROFILE_FUNCTION();
 
 		s_Data.CameraBuffer.ViewProjection = camera.GetProjection() * glm::inverse(transform);
+		s_Data.CameraBuffer.ViewportSize = s_Data.ViewportSize;
 		s_Data.CameraUniformBuffer->SetData(&s_Data.CameraBuffer, sizeof(Renderer2DData::CameraData));
 
 		StartBatch();
@@ -256,6 +323,7 @@ namespace Hazel {
 		HZ_PROFILE_FUNCTION();
 
 		s_Data.CameraBuffer.ViewProjection = camera.GetViewProjection();
+		s_Data.CameraBuffer.ViewportSize = s_Data.ViewportSize;
 		s_Data.CameraUniformBuffer->SetData(&s_Data.CameraBuffer, sizeof(Renderer2DData::CameraData));
 
 		StartBatch();
@@ -276,17 +344,34 @@ namespace Hazel {
 		s_Data.CircleIndexCount = 0;
 		s_Data.CircleVertexBufferPtr = s_Data.CircleVertexBufferBase;
 
-		s_Data.LineVertexCount = 0;
+		s_Data.LineIndexCount = 0;
 		s_Data.LineVertexBufferPtr = s_Data.LineVertexBufferBase;	
 		
 		s_Data.TextIndexCount = 0;
 		s_Data.TextVertexBufferPtr = s_Data.TextVertexBufferBase;
 
+		s_Data.UnifiedIndexCount = 0;
+		s_Data.UnifiedVertexBufferPtr = s_Data.UnifiedVertexBufferBase;
+
 		s_Data.TextureSlotIndex = 1;
 	}
 
 	void Renderer2D::Flush()
 	{
+		if (s_Data.UnifiedIndexCount)
+		{
+			uint32_t dataSize = (uint32_t)((uint8_t*)s_Data.UnifiedVertexBufferPtr - (uint8_t*)s_Data.UnifiedVertexBufferBase);
+			s_Data.UnifiedVertexBuffer->SetData(s_Data.UnifiedVertexBufferBase, dataSize);
+
+			// Bind textures
+			for (uint32_t i = 0; i < s_Data.TextureSlotIndex; i++)
+				s_Data.TextureSlots[i]->Bind(i);
+
+			s_Data.UnifiedShader->Bind();
+			RenderCommand::DrawIndexed(s_Data.UnifiedVertexArray, s_Data.UnifiedIndexCount);
+			s_Data.Stats.DrawCalls++;
+		}
+
 		if (s_Data.QuadIndexCount)
 		{
 			uint32_t dataSize = (uint32_t)((uint8_t*)s_Data.QuadVertexBufferPtr - (uint8_t*)s_Data.QuadVertexBufferBase);
@@ -311,14 +396,13 @@ namespace Hazel {
 			s_Data.Stats.DrawCalls++;
 		}
 
-		if (s_Data.LineVertexCount)
+		if (s_Data.LineIndexCount)
 		{
 			uint32_t dataSize = (uint32_t)((uint8_t*)s_Data.LineVertexBufferPtr - (uint8_t*)s_Data.LineVertexBufferBase);
 			s_Data.LineVertexBuffer->SetData(s_Data.LineVertexBufferBase, dataSize);
 
 			s_Data.LineShader->Bind();
-			RenderCommand::SetLineWidth(s_Data.LineWidth);
-			RenderCommand::DrawLines(s_Data.LineVertexArray, s_Data.LineVertexCount);
+			RenderCommand::DrawIndexed(s_Data.LineVertexArray, s_Data.LineIndexCount);
 			s_Data.Stats.DrawCalls++;
 		}
 		
@@ -342,6 +426,41 @@ namespace Hazel {
 		StartBatch();
 	}
 
+	float Renderer2D::GetTextureIndex(const Ref<Texture2D>& texture)
+	{
+		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
+		{
+			if (*s_Data.TextureSlots[i] == *texture)
+				return (float)i;
+		}
+
+		if (s_Data.TextureSlotIndex >= Renderer2DData::MaxTextureSlots)
+			NextBatch();
+
+		float textureIndex = (float)s_Data.TextureSlotIndex;
+		s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
+		s_Data.TextureSlotIndex++;
+		return textureIndex;
+	}
+
+	static void WriteUnifiedQuad(const glm::vec3* positions, const glm::vec2* texCoords, const glm::vec4& color,
+		const glm::vec2& params, float textureIndex, UnifiedPrimitiveKind kind, int entityID)
+	{
+		for (size_t i = 0; i < 4; i++)
+		{
+			s_Data.UnifiedVertexBufferPtr->Position = positions[i];
+			s_Data.UnifiedVertexBufferPtr->Color = color;
+			s_Data.UnifiedVertexBufferPtr->TexCoord = texCoords[i];
+			s_Data.UnifiedVertexBufferPtr->Params = params;
+			s_Data.UnifiedVertexBufferPtr->TexIndex = textureIndex;
+			s_Data.UnifiedVertexBufferPtr->Kind = (int)kind;
+			s_Data.UnifiedVertexBufferPtr->EntityID = entityID;
+			s_Data.UnifiedVertexBufferPtr++;
+		}
+
+		s_Data.UnifiedIndexCount += 6;
+	}
+
 	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const glm::vec4& color)
 	{
 		DrawQuad({ position.x, position.y, 0.0f }, size, color);
@@ -381,6 +500,20 @@ namespace Hazel {
 		constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
 		const float tilingFactor = 1.0f;
 
+		if (s_Data.UseUnifiedPipeline)
+		{
+			if (s_Data.UnifiedIndexCount >= Renderer2DData::MaxIndices)
+				NextBatch();
+
+			glm::vec3 positions[quadVertexCount];
+			for (size_t i = 0; i < quadVertexCount; i++)
+				positions[i] = transform * s_Data.QuadVertexPositions[i];
+
+			WriteUnifiedQuad(positions, textureCoords, color, { tilingFactor, 0.0f }, textureIndex, UnifiedPrimitiveKind::Quad, entityID);
+			s_Data.Stats.QuadCount++;
+			return;
+		}
+
 		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
 			NextBatch();
 
@@ -401,35 +534,60 @@ namespace Hazel {
 	}
 
 	void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor, const glm::vec4& tintColor, int entityID)
+	{
+		constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+
+		DrawTexturedQuad(transform, texture, textureCoords, tilingFactor, tintColor, entityID);
+	}
+
+	void Renderer2D::DrawQuad(const glm::vec2& position, const glm::vec2& size, const Ref<SubTexture2D>& subtexture, const glm::vec4& tintColor)
+	{
+		DrawQuad({ position.x, position.y, 0.0f }, size, subtexture, tintColor);
+	}
+
+	void Renderer2D::DrawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<SubTexture2D>& subtexture, const glm::vec4& tintColor)
 	{
 		HZ_PROFILE_FUNCTION();
 
-		constexpr size_t quadVertexCount = 4;
-		constexpr glm::vec2 textureCoords[] = { { 0.0f, 0.0f }, { 1.0f, 0.0f }, { 1.0f, 1.0f }, { 0.0f, 1.0f } };
+		glm::mat4 transform = glm::translate(glm::mat4(1.0f), position)
+			* glm::scale(glm::mat4(1.0f), { size.x, size.y, 1.0f });
 
-		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
-			NextBatch();
+		DrawQuad(transform, subtexture, tintColor);
+	}
 
-		float textureIndex = 0.0f;
-		for (uint32_t i = 1; i < s_Data.TextureSlotIndex; i++)
-		{
-			if (*s_Data.TextureSlots[i] == *texture)
-			{
-				textureIndex = (float)i;
-				break;
-			}
-		}
+	void Renderer2D::DrawQuad(const glm::mat4& transform, const Ref<SubTexture2D>& subtexture, const glm::vec4& tintColor, int entityID)
+	{
+		// Tiling would sample outside of the sub-texture's rect
+		DrawTexturedQuad(transform, subtexture->GetTexture(), subtexture->GetTexCoords(), 1.0f, tintColor, entityID);
+	}
 
-		if (textureIndex == 0.0f)
+	void Renderer2D::DrawTexturedQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, const glm::vec2* textureCoords, float tilingFactor, const glm::vec4& tintColor, int entityID)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		constexpr size_t quadVertexCount = 4;
+
+		if (s_Data.UseUnifiedPipeline)
 		{
-			if (s_Data.TextureSlotIndex >= Renderer2DData::MaxTextureSlots)
+			if (s_Data.UnifiedIndexCount >= Renderer2DData::MaxIndices)
 				NextBatch();
 
-			textureIndex = (float)s_Data.TextureSlotIndex;
-			s_Data.TextureSlots[s_Data.TextureSlotIndex] = texture;
-			s_Data.TextureSlotIndex++;
+			float textureIndex = GetTextureIndex(texture);
+
+			glm::vec3 positions[quadVertexCount];
+			for (size_t i = 0; i < quadVertexCount; i++)
+				positions[i] = transform * s_Data.QuadVertexPositions[i];
+
+			WriteUnifiedQuad(positions, textureCoords, tintColor, { tilingFactor, 0.0f }, textureIndex, UnifiedPrimitiveKind::Quad, entityID);
+			s_Data.Stats.QuadCount++;
+			return;
 		}
 
+		if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
+			NextBatch();
+
+		float textureIndex = GetTextureIndex(texture);
+
 		for (size_t i = 0; i < quadVertexCount; i++)
 		{
 			s_Data.QuadVertexBufferPtr->Position = transform * s_Data.QuadVertexPositions[i];
@@ -482,6 +640,24 @@ namespace Hazel {
 	{
 		HZ_PROFILE_FUNCTION();
 
+		if (s_Data.UseUnifiedPipeline)
+		{
+			if (s_Data.UnifiedIndexCount >= Renderer2DData::MaxIndices)
+				NextBatch();
+
+			glm::vec3 positions[4];
+			glm::vec2 localPositions[4];
+			for (size_t i = 0; i < 4; i++)
+			{
+				positions[i] = transform * s_Data.QuadVertexPositions[i];
+				localPositions[i] = s_Data.QuadVertexPositions[i] * 2.0f;
+			}
+
+			WriteUnifiedQuad(positions, localPositions, color, { thickness, fade }, 0.0f, UnifiedPrimitiveKind::Circle, entityID);
+			s_Data.Stats.QuadCount++;
+			return;
+		}
+
 		// TODO: implement for circles
 		// if (s_Data.QuadIndexCount >= Renderer2DData::MaxIndices)
 		// 	NextBatch();
@@ -502,32 +678,78 @@ namespace Hazel {
 		s_Data.Stats.QuadCount++;
 	}
 
-	void Renderer2D::DrawLine(const glm::vec3& p0, glm::vec3& p1, const glm::vec4& color, int entityID)
+	void Renderer2D::DrawLine(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, int entityID)
 	{
-		s_Data.LineVertexBufferPtr->Position = p0;
-		s_Data.LineVertexBufferPtr->Color = color;
-		s_Data.LineVertexBufferPtr->EntityID = entityID;
-		s_Data.LineVertexBufferPtr++;
+		DrawLineSegment(p0, p1, p0, p1, color, s_Data.LineWidth, s_Data.LineWidth, LineCap::Butt, entityID);
+	}
 
-		s_Data.LineVertexBufferPtr->Position = p1;
-		s_Data.LineVertexBufferPtr->Color = color;
-		s_Data.LineVertexBufferPtr->EntityID = entityID;
-		s_Data.LineVertexBufferPtr++;
+	void Renderer2D::DrawLine(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, float startWidth, float endWidth, LineCap cap, int entityID)
+	{
+		DrawLineSegment(p0, p1, p0, p1, color, startWidth, endWidth, cap, entityID);
+	}
+
+	void Renderer2D::DrawPolyline(const glm::vec3* points, uint32_t count, const glm::vec4& color, bool closed, LineCap cap, const float* widths, int entityID)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (count < 2)
+			return;
+
+		uint32_t segmentCount = closed ? count : count - 1;
+		for (uint32_t i = 0; i < segmentCount; i++)
+		{
+			uint32_t start = i;
+			uint32_t end = (i + 1) % count;
 
-		s_Data.LineVertexCount += 2;
+			bool hasPrevious = closed || start > 0;
+			bool hasNext = closed || end < count - 1;
+			const glm::vec3& startJoin = hasPrevious ? points[(start + count - 1) % count] : points[start];
+			const glm::vec3& endJoin = hasNext ? points[(end + 1) % count] : points[end];
+
+			float startWidth = widths ? widths[start] : s_Data.LineWidth;
+			float endWidth = widths ? widths[end] : s_Data.LineWidth;
+
+			DrawLineSegment(points[start], points[end], startJoin, endJoin, color, startWidth, endWidth, cap, entityID);
+		}
+	}
+
+	void Renderer2D::DrawLineSegment(const glm::vec3& start, const glm::vec3& end, const glm::vec3& startJoin, const glm::vec3& endJoin,
+		const glm::vec4& color, float startWidth, float endWidth, LineCap cap, int entityID)
+	{
+		// Same winding as the quad index buffer: start and end on one side, then end and start on the other
+		constexpr glm::vec2 corners[] = { { -1.0f, 0.0f }, { -1.0f, 1.0f }, { 1.0f, 1.0f }, { 1.0f, 0.0f } };
+
+		if (s_Data.LineIndexCount >= Renderer2DData::MaxIndices)
+			NextBatch();
+
+		for (size_t i = 0; i < 4; i++)
+		{
+			bool isEnd = corners[i].y > 0.0f;
+			s_Data.LineVertexBufferPtr->Position = isEnd ? end : start;
+			s_Data.LineVertexBufferPtr->OtherPosition = isEnd ? start : end;
+			s_Data.LineVertexBufferPtr->JoinPosition = isEnd ? endJoin : startJoin;
+			s_Data.LineVertexBufferPtr->Color = color;
+			s_Data.LineVertexBufferPtr->Corner = corners[i];
+			s_Data.LineVertexBufferPtr->Width = isEnd ? endWidth : startWidth;
+			s_Data.LineVertexBufferPtr->Cap = (int)cap;
+			s_Data.LineVertexBufferPtr->EntityID = entityID;
+			s_Data.LineVertexBufferPtr++;
+		}
+
+		s_Data.LineIndexCount += 6;
+
+		s_Data.Stats.LineCount++;
 	}
 
 	void Renderer2D::DrawRect(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color, int entityID)
 	{
-		glm::vec3 p0 = glm::vec3(position.x - size.x * 0.5f, position.y - size.y * 0.5f, position.z);
-		glm::vec3 p1 = glm::vec3(position.x + size.x * 0.5f, position.y - size.y * 0.5f, position.z);
-		glm::vec3 p2 = glm::vec3(position.x + size.x * 0.5f, position.y + size.y * 0.5f, position.z);
-		glm::vec3 p3 = glm::vec3(position.x - size.x * 0.5f, position.y + size.y * 0.5f, position.z);
+		glm::vec3 lineVertices[4];
+		lineVertices[0] = glm::vec3(position.x - size.x * 0.5f, position.y - size.y * 0.5f, position.z);
+		lineVertices[1] = glm::vec3(position.x + size.x * 0.5f, position.y - size.y * 0.5f, position.z);
+		lineVertices[2] = glm::vec3(position.x + size.x * 0.5f, position.y + size.y * 0.5f, position.z);
+		lineVertices[3] = glm::vec3(position.x - size.x * 0.5f, position.y + size.y * 0.5f, position.z);
 
-		DrawLine(p0, p1, color, entityID);
-		DrawLine(p1, p2, color, entityID);
-		DrawLine(p2, p3, color, entityID);
-		DrawLine(p3, p0, color, entityID);
+		DrawPolyline(lineVertices, 4, color, true, LineCap::Butt, nullptr, entityID);
 	}
 
 	void Renderer2D::DrawRect(const glm::mat4& transform, const glm::vec4& color, int entityID)
@@ -536,21 +758,34 @@ namespace Hazel {
 		for (size_t i = 0; i < 4; i++)
 			lineVertices[i] = transform * s_Data.QuadVertexPositions[i];
 
-		DrawLine(lineVertices[0], lineVertices[1], color, entityID);
-		DrawLine(lineVertices[1], lineVertices[2], color, entityID);
-		DrawLine(lineVertices[2], lineVertices[3], color, entityID);
-		DrawLine(lineVertices[3], lineVertices[0], color, entityID);
+		DrawPolyline(lineVertices, 4, color, true, LineCap::Butt, nullptr, entityID);
 	}
 
-	void Renderer2D::DrawSprite(const glm::mat4& transform, SpriteRendererComponent& src, int entityID)
+	void Renderer2D::DrawCircleOutline(const glm::mat4& transform, const glm::vec4& color, int entityID)
 	{
-		if (src.Texture)
-			DrawQuad(transform, src.Texture, src.TilingFactor, src.Color, entityID);
+		constexpr uint32_t segmentCount = 48;
+
+		glm::vec3 lineVertices[segmentCount];
+		for (uint32_t i = 0; i < segmentCount; i++)
+		{
+			float angle = glm::two_pi<float>() * (float)i / (float)segmentCount;
+			lineVertices[i] = transform * glm::vec4(glm::cos(angle) * 0.5f, glm::sin(angle) * 0.5f, 0.0f, 1.0f);
+		}
+
+		DrawPolyline(lineVertices, segmentCount, color, true, LineCap::Butt, nullptr, entityID);
+	}
+
+	void Renderer2D::DrawSprite(const glm::mat4& transform, const SpriteRendererComponent& src, int entityID)
+	{
+		if (src.SubTexture)
+			DrawQuad(transform, AssetTable<SubTexture2D>::GetRef(src.SubTexture), src.Color, entityID);
+		else if (src.Texture)
+			DrawQuad(transform, AssetTable<Texture2D>::GetRef(src.Texture), src.TilingFactor, src.Color, entityID);
 		else
 			DrawQuad(transform, src.Color, entityID);
 	}
 
-	void Renderer2D::DrawString(const std::string& string, Ref<Font> font, const glm::mat4& transform, const TextParams& textParams, int entityID)
+	void Renderer2D::DrawString(const std::string& string, const Ref<Font>& font, const glm::mat4& transform, const TextParams& textParams, int entityID)
 	{
 		const auto& fontGeometry = font->GetMSDFData()->FontGeometry;
 		const auto& metrics = fontGeometry.getMetrics();
@@ -625,32 +860,58 @@ namespace Hazel {
 			texCoordMax *= glm::vec2(texelWidth, texelHeight);
 
 			// render here
-			s_Data.TextVertexBufferPtr->Position = transform * glm::vec4(quadMin, 0.0f, 1.0f);
-			s_Data.TextVertexBufferPtr->Color = textParams.Color;
-			s_Data.TextVertexBufferPtr->TexCoord = texCoordMin;
-			s_Data.TextVertexBufferPtr->EntityID = entityID;
-			s_Data.TextVertexBufferPtr++;
-
-			s_Data.TextVertexBufferPtr->Position = transform * glm::vec4(quadMin.x, quadMax.y, 0.0f, 1.0f);
-			s_Data.TextVertexBufferPtr->Color = textParams.Color;
-			s_Data.TextVertexBufferPtr->TexCoord = { texCoordMin.x, texCoordMax.y };
-			s_Data.TextVertexBufferPtr->EntityID = entityID;
-			s_Data.TextVertexBufferPtr++;
-
-			s_Data.TextVertexBufferPtr->Position = transform * glm::vec4(quadMax, 0.0f, 1.0f);
-			s_Data.TextVertexBufferPtr->Color = textParams.Color;
-			s_Data.TextVertexBufferPtr->TexCoord = texCoordMax;
-			s_Data.TextVertexBufferPtr->EntityID = entityID;
-			s_Data.TextVertexBufferPtr++;
-
-			s_Data.TextVertexBufferPtr->Position = transform * glm::vec4(quadMax.x, quadMin.y, 0.0f, 1.0f);
-			s_Data.TextVertexBufferPtr->Color = textParams.Color;
-			s_Data.TextVertexBufferPtr->TexCoord = { texCoordMax.x, texCoordMin.y };
-			s_Data.TextVertexBufferPtr->EntityID = entityID;
-			s_Data.TextVertexBufferPtr++;
-
-			s_Data.TextIndexCount += 6;
-			s_Data.Stats.QuadCount++;
+			if (s_Data.UseUnifiedPipeline)
+			{
+				if (s_Data.UnifiedIndexCount >= Renderer2DData::MaxIndices)
+					NextBatch();
+
+				float textureIndex = GetTextureIndex(fontAtlas);
+
+				glm::vec3 positions[] = {
+					transform * glm::vec4(quadMin, 0.0f, 1.0f),
+					transform * glm::vec4(quadMin.x, quadMax.y, 0.0f, 1.0f),
+					transform * glm::vec4(quadMax, 0.0f, 1.0f),
+					transform * glm::vec4(quadMax.x, quadMin.y, 0.0f, 1.0f)
+				};
+				glm::vec2 texCoords[] = {
+					texCoordMin,
+					{ texCoordMin.x, texCoordMax.y },
+					texCoordMax,
+					{ texCoordMax.x, texCoordMin.y }
+				};
+
+				WriteUnifiedQuad(positions, texCoords, textParams.Color, { 0.0f, 0.0f }, textureIndex, UnifiedPrimitiveKind::Text, entityID);
+				s_Data.Stats.QuadCount++;
+			}
+			else
+			{
+				s_Data.TextVertexBufferPtr->Position = transform * glm::vec4(quadMin, 0.0f, 1.0f);
+				s_Data.TextVertexBufferPtr->Color = textParams.Color;
+				s_Data.TextVertexBufferPtr->TexCoord = texCoordMin;
+				s_Data.TextVertexBufferPtr->EntityID = entityID;
+				s_Data.TextVertexBufferPtr++;
+
+				s_Data.TextVertexBufferPtr->Position = transform * glm::vec4(quadMin.x, quadMax.y, 0.0f, 1.0f);
+				s_Data.TextVertexBufferPtr->Color = textParams.Color;
+				s_Data.TextVertexBufferPtr->TexCoord = { texCoordMin.x, texCoordMax.y };
+				s_Data.TextVertexBufferPtr->EntityID = entityID;
+				s_Data.TextVertexBufferPtr++;
+
+				s_Data.TextVertexBufferPtr->Position = transform * glm::vec4(quadMax, 0.0f, 1.0f);
+				s_Data.TextVertexBufferPtr->Color = textParams.Color;
+				s_Data.TextVertexBufferPtr->TexCoord = texCoordMax;
+				s_Data.TextVertexBufferPtr->EntityID = entityID;
+				s_Data.TextVertexBufferPtr++;
+
+				s_Data.TextVertexBufferPtr->Position = transform * glm::vec4(quadMax.x, quadMin.y, 0.0f, 1.0f);
+				s_Data.TextVertexBufferPtr->Color = textParams.Color;
+				s_Data.TextVertexBufferPtr->TexCoord = { texCoordMax.x, texCoordMin.y };
+				s_Data.TextVertexBufferPtr->EntityID = entityID;
+				s_Data.TextVertexBufferPtr++;
+
+				s_Data.TextIndexCount += 6;
+				s_Data.Stats.QuadCount++;
+			}
 
 			if (i < string.size() - 1)
 			{
@@ -665,7 +926,8 @@ namespace Hazel {
 
 	void Renderer2D::DrawString(const std::string& string, const glm::mat4& transform, const TextComponent& component, int entityID)
 	{
-		DrawString(string, component.FontAsset, transform, { component.Color, component.Kerning, component.LineSpacing }, entityID);
+		const Ref<Font>& font = component.FontAsset ? AssetTable<Font>::GetRef(component.FontAsset) : Font::GetDefault();
+		DrawString(string, font, transform, { component.Color, component.Kerning, component.LineSpacing }, entityID);
 	}
 
 	float Renderer2D::GetLineWidth()
@@ -678,6 +940,26 @@ namespace Hazel {
 		s_Data.LineWidth = width;
 	}
 
+	void Renderer2D::SetViewportSize(uint32_t width, uint32_t height)
+	{
+		s_Data.ViewportSize = { (float)width, (float)height };
+	}
+
+	bool Renderer2D::IsUnifiedPipelineEnabled()
+	{
+		return s_Data.UseUnifiedPipeline;
+	}
+
+	void Renderer2D::SetUnifiedPipelineEnabled(bool enabled)
+	{
+		if (s_Data.UseUnifiedPipeline == enabled)
+			return;
+
+		// Anything batched so far was written in the other vertex format
+		NextBatch();
+		s_Data.UseUnifiedPipeline = enabled;
+	}
+
 	void Renderer2D::ResetStats()
 	{
 		memset(&s_Data.Stats, 0, sizeof(Statistics));
@@ -3,6 +3,7 @@
 #include "XingXing/Renderer/OrthographicCamera.h"
 
 #include "XingXing/Renderer/Texture.h"
+#include "XingXing/Renderer/SubTexture2D.h"
 
 #include "XingXing/Renderer/Camera.h"
 #include "XingXing/Renderer/EditorCamera.h"
@@ -12,6 +13,11 @@
 
 namespace Hazel {
 
+	enum class LineCap
+	{
+		Butt = 0, Square, Round
+	};
+
 	class Renderer2D
 	{
 	public:
@@ -33,6 +39,10 @@ namespace Hazel {
 		static void DrawQuad(const glm::mat4& transform, const glm::vec4& color, int entityID = -1);
 		static void DrawQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f), int entityID = -1);
 
+		static void DrawQuad(const glm::vec2& position, const glm::vec2& size, const Ref<SubTexture2D>& subtexture, const glm::vec4& tintColor = glm::vec4(1.0f));
+		static void DrawQuad(const glm::vec3& position, const glm::vec2& size, const Ref<SubTexture2D>& subtexture, const glm::vec4& tintColor = glm::vec4(1.0f));
+		static void DrawQuad(const glm::mat4& transform, const Ref<SubTexture2D>& subtexture, const glm::vec4& tintColor = glm::vec4(1.0f), int entityID = -1);
+
 		static void DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const glm::vec4& color);
 		static void DrawRotatedQuad(const glm::vec3& position, const glm::vec2& size, float rotation, const glm::vec4& color);
 		static void DrawRotatedQuad(const glm::vec2& position, const glm::vec2& size, float rotation, const Ref<Texture2D>& texture, float tilingFactor = 1.0f, const glm::vec4& tintColor = glm::vec4(1.0f));
@@ -40,12 +50,17 @@ namespace Hazel {
 
 		static void DrawCircle(const glm::mat4& transform, const glm::vec4& color, float thickness = 1.0f, float fade = 0.005f, int entityID = -1);
 		
-		static void DrawLine(const glm::vec3& p0, glm::vec3& p1, const glm::vec4& color, int entityID = -1);
+		// Line widths are in pixels, lines of any width share a single batch
+		static void DrawLine(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, int entityID = -1);
+		static void DrawLine(const glm::vec3& p0, const glm::vec3& p1, const glm::vec4& color, float startWidth, float endWidth, LineCap cap = LineCap::Butt, int entityID = -1);
+		// Consecutive segments are mitered; widths is optional and holds one width per point
+		static void DrawPolyline(const glm::vec3* points, uint32_t count, const glm::vec4& color, bool closed = false, LineCap cap = LineCap::Butt, const float* widths = nullptr, int entityID = -1);
 
 		static void DrawRect(const glm::vec3& position, const glm::vec2& size, const glm::vec4& color, int entityID = -1);
 		static void DrawRect(const glm::mat4& transform, const glm::vec4& color, int entityID = -1);
+		static void DrawCircleOutline(const glm::mat4& transform, const glm::vec4& color, int entityID = -1);
 
-		static void DrawSprite(const glm::mat4& transform, SpriteRendererComponent& src, int entityID);
+		static void DrawSprite(const glm::mat4& transform, const SpriteRendererComponent& src, int entityID);
 
 		struct TextParams
 		{
@@ -53,20 +68,30 @@ namespace Hazel {
 			float Kerning = 0.0f;
 			float LineSpacing = 0.0f;
 		};
-		static void DrawString(const std::string& string, Ref<Font> font, const glm::mat4& transform, const TextParams& textParams, int entityID = -1);
+		static void DrawString(const std::string& string, const Ref<Font>& font, const glm::mat4& transform, const TextParams& textParams, int entityID = -1);
 		static void DrawString(const std::string& string, const glm::mat4& transform, const TextComponent& component, int entityID = -1);
 
+		// Default width for lines drawn without an explicit one
 		static float GetLineWidth();
 		static void SetLineWidth(float width);
 
+		// Size of the render target in pixels, needed to expand lines in screen space
+		static void SetViewportSize(uint32_t width, uint32_t height);
+
+		// Draws quads, circles and text with one shader, in a single batch in submission order
+		// instead of one batch per primitive type. Lines always use their own pipeline.
+		static bool IsUnifiedPipelineEnabled();
+		static void SetUnifiedPipelineEnabled(bool enabled);
+
 		// Stats
 		struct Statistics
 		{
 			uint32_t DrawCalls = 0;
 			uint32_t QuadCount = 0;
+			uint32_t LineCount = 0;
 
-			uint32_t GetTotalVertexCount() const { return QuadCount * 4; }
-			uint32_t GetTotalIndexCount() const { return QuadCount * 6; }
+			uint32_t GetTotalVertexCount() const { return (QuadCount + LineCount) * 4; }
+			uint32_t GetTotalIndexCount() const { return (QuadCount + LineCount) * 6; }
 		};
 		static void ResetStats();
 		static Statistics GetStats();
@@ -74,6 +99,12 @@ namespace Hazel {
 	private:
 		static void StartBatch();
 		static void NextBatch();
+
+		static float GetTextureIndex(const Ref<Texture2D>& texture);
+		static void DrawTexturedQuad(const glm::mat4& transform, const Ref<Texture2D>& texture, const glm::vec2* textureCoords, float tilingFactor, const glm::vec4& tintColor, int entityID);
+
+		static void DrawLineSegment(const glm::vec3& start, const glm::vec3& end, const glm::vec3& startJoin, const glm::vec3& endJoin,
+			const glm::vec4& color, float startWidth, float endWidth, LineCap cap, int entityID);
 	};
 
 }
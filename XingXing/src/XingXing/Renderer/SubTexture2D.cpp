@@ -0,0 +1,28 @@
+#include "hzpch.h"
+#include "XingXing/Renderer/SubTexture2D.h"
+
+namespace Hazel {
+
+	SubTexture2D::SubTexture2D(const Ref<Texture2D>& texture, const glm::vec2& min, const glm::vec2& max, const std::string& path)
+		: m_Texture(texture), m_Path(path)
+	{
+		m_TexCoords[0] = { min.x, min.y };
+		m_TexCoords[1] = { max.x, min.y };
+		m_TexCoords[2] = { max.x, max.y };
+		m_TexCoords[3] = { min.x, max.y };
+	}
+
+	glm::vec2 SubTexture2D::GetSize() const
+	{
+		glm::vec2 uvSize = m_TexCoords[2] - m_TexCoords[0];
+		return { uvSize.x * m_Texture->GetWidth(), uvSize.y * m_Texture->GetHeight() };
+	}
+
+	Ref<SubTexture2D> SubTexture2D::CreateFromCoords(const Ref<Texture2D>& texture, const glm::vec2& coords, const glm::vec2& cellSize, const glm::vec2& spriteSize)
+	{
+		glm::vec2 min = { (coords.x * cellSize.x) / texture->GetWidth(), (coords.y * cellSize.y) / texture->GetHeight() };
+		glm::vec2 max = { ((coords.x + spriteSize.x) * cellSize.x) / texture->GetWidth(), ((coords.y + spriteSize.y) * cellSize.y) / texture->GetHeight() };
+		return CreateRef<SubTexture2D>(texture, min, max);
+	}
+
+}
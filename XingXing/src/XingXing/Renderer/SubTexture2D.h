@@ -0,0 +1,31 @@
+#pragma once
+
+#include "XingXing/Renderer/Texture.h"
+
+#include <glm/glm.hpp>
+
+namespace Hazel {
+
+	// Rectangular region of a texture, e.g. a cell of a sprite sheet or an image packed into an atlas page
+	class SubTexture2D
+	{
+	public:
+		SubTexture2D(const Ref<Texture2D>& texture, const glm::vec2& min, const glm::vec2& max, const std::string& path = std::string());
+
+		const Ref<Texture2D>& GetTexture() const { return m_Texture; }
+		const glm::vec2* GetTexCoords() const { return m_TexCoords; }
+
+		// Source image of an atlas entry, empty for sprite sheet cells
+		const std::string& GetPath() const { return m_Path; }
+
+		// Size of the region in pixels
+		glm::vec2 GetSize() const;
+
+		static Ref<SubTexture2D> CreateFromCoords(const Ref<Texture2D>& texture, const glm::vec2& coords, const glm::vec2& cellSize, const glm::vec2& spriteSize = { 1, 1 });
+	private:
+		Ref<Texture2D> m_Texture;
+		glm::vec2 m_TexCoords[4];
+		std::string m_Path;
+	};
+
+}
@@ -2,6 +2,7 @@
 #include "XingXing/Renderer/Texture.h"
 
 #include "XingXing/Renderer/Renderer.h"
+#include "XingXing/Renderer/GPUResourceRegistry.h"
 #include "Platform/OpenGL/OpenGLTexture.h"
 
 namespace Hazel {
@@ -11,7 +12,7 @@ namespace Hazel {
 		switch (Renderer::GetAPI())
 		{
 			case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2D>(specification);
+			case RendererAPI::API::OpenGL:  return Renderer::CreateResource<OpenGLTexture2D>(specification);
 		}
 
 		HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -23,11 +24,58 @@ namespace Hazel {
 		switch (Renderer::GetAPI())
 		{
 			case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLTexture2D>(path);
+			case RendererAPI::API::OpenGL:
+			{
+				Ref<Texture2D> texture = Renderer::CreateResource<OpenGLTexture2D>(path);
+				if (texture->IsLoaded())
+					GPUResourceRegistry::RegisterEvictable(texture);
+				return texture;
+			}
 		}
 
 		HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
 		return nullptr;
 	}
 
+	bool Texture2D::Decode(const std::string& path, TextureImage& outImage)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return false;
+			case RendererAPI::API::OpenGL:  return OpenGLTexture2D::Decode(path, outImage);
+		}
+
+		HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return false;
+	}
+
+	Ref<Texture2D> Texture2D::Create(const std::string& path, TextureImage image)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
+			case RendererAPI::API::OpenGL:
+			{
+				Ref<Texture2D> texture = Renderer::CreateResource<OpenGLTexture2D>(path, image);
+				if (texture->IsLoaded())
+					GPUResourceRegistry::RegisterEvictable(texture);
+				return texture;
+			}
+		}
+
+		HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
+		return nullptr;
+	}
+
+	void Texture2D::FreeImage(TextureImage& image)
+	{
+		switch (Renderer::GetAPI())
+		{
+			case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return;
+			case RendererAPI::API::OpenGL:  OpenGLTexture2D::FreeImage(image); return;
+		}
+
+		HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
+	}
+
 }
@@ -23,6 +23,13 @@ namespace Hazel {
 		bool GenerateMips = true;
 	};
 
+	// Decoded pixels of a texture's source file, owned by whoever holds them until handed back to the texture
+	struct TextureImage
+	{
+		void* Data = nullptr;
+		uint32_t Width = 0, Height = 0, Channels = 0;
+	};
+
 	class Texture
 	{
 	public:
@@ -42,6 +49,15 @@ namespace Hazel {
 
 		virtual bool IsLoaded() const = 0;
 
+		// Replaces the image with a low resolution copy to free GPU memory, see GPUResourceRegistry.
+		// Returns false if the texture could not be restored afterwards.
+		virtual bool Evict() { return false; }
+		// Restoring takes two steps, so the file is never read while rendering: DecodeSource reads the
+		// source on any thread, Restore uploads the image on the main thread and takes ownership of it.
+		// Returns false, with an empty image, if the source can't be read any more.
+		virtual bool DecodeSource([[maybe_unused]] TextureImage& outImage) const { return false; }
+		virtual void Restore([[maybe_unused]] TextureImage image) {}
+
 		virtual bool operator==(const Texture& other) const = 0;
 	};
 
@@ -50,6 +66,11 @@ namespace Hazel {
 	public:
 		static Ref<Texture2D> Create(const TextureSpecification& specification);
 		static Ref<Texture2D> Create(const std::string& path);
+		// Loading in two steps, like restoring: Decode reads the file on any thread, Create uploads the
+		// image on the main thread and takes ownership of it. Images that are never uploaded go to FreeImage.
+		static bool Decode(const std::string& path, TextureImage& outImage);
+		static Ref<Texture2D> Create(const std::string& path, TextureImage image);
+		static void FreeImage(TextureImage& image);
 	};
 
 }
@@ -0,0 +1,331 @@
+#include "hzpch.h"
+#include "XingXing/Renderer/TextureAtlas.h"
+
+#include <stb_image.h>
+
+namespace Hazel {
+
+	namespace Utils {
+
+		static std::string AtlasKey(const std::filesystem::path& path)
+		{
+			return path.lexically_normal().string();
+		}
+
+		static bool IsAtlasImage(const std::filesystem::path& path)
+		{
+			std::string extension = path.extension().string();
+			std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return (char)std::tolower(c); });
+			return extension == ".png" || extension == ".jpg" || extension == ".jpeg" || extension == ".tga" || extension == ".bmp";
+		}
+
+		static uint32_t NextPowerOfTwo(uint32_t value)
+		{
+			uint32_t result = 1;
+			while (result < value)
+				result <<= 1;
+			return result;
+		}
+
+	}
+
+	// Skyline bottom-left packer: the free space is tracked as a list of horizontal segments,
+	// each rectangle goes where its top edge ends up lowest
+	class SkylinePacker
+	{
+	public:
+		SkylinePacker(uint32_t width, uint32_t height)
+			: m_Width(width), m_Height(height)
+		{
+			m_Skyline.push_back({ 0, 0, width });
+		}
+
+		bool Pack(uint32_t width, uint32_t height, uint32_t& outX, uint32_t& outY)
+		{
+			size_t bestIndex = SIZE_MAX;
+			uint32_t bestTop = UINT32_MAX, bestWidth = UINT32_MAX;
+			for (size_t i = 0; i < m_Skyline.size(); i++)
+			{
+				uint32_t y;
+				if (!Fit(i, width, height, y))
+					continue;
+
+				uint32_t top = y + height;
+				if (top < bestTop || (top == bestTop && m_Skyline[i].Width < bestWidth))
+				{
+					bestIndex = i;
+					bestTop = top;
+					bestWidth = m_Skyline[i].Width;
+					outX = m_Skyline[i].X;
+					outY = y;
+				}
+			}
+
+			if (bestIndex == SIZE_MAX)
+				return false;
+
+			m_Skyline.insert(m_Skyline.begin() + bestIndex, { outX, outY + height, width });
+
+			// Trim the segments now covered by the new one
+			for (size_t i = bestIndex + 1; i < m_Skyline.size();)
+			{
+				uint32_t previousEnd = m_Skyline[i - 1].X + m_Skyline[i - 1].Width;
+				if (m_Skyline[i].X >= previousEnd)
+					break;
+
+				uint32_t overlap = previousEnd - m_Skyline[i].X;
+				if (m_Skyline[i].Width > overlap)
+				{
+					m_Skyline[i].X += overlap;
+					m_Skyline[i].Width -= overlap;
+					break;
+				}
+
+				m_Skyline.erase(m_Skyline.begin() + i);
+			}
+
+			// Merge neighbours at the same height
+			for (size_t i = 0; i + 1 < m_Skyline.size();)
+			{
+				if (m_Skyline[i].Y == m_Skyline[i + 1].Y)
+				{
+					m_Skyline[i].Width += m_Skyline[i + 1].Width;
+					m_Skyline.erase(m_Skyline.begin() + i + 1);
+				}
+				else
+				{
+					i++;
+				}
+			}
+
+			m_UsedHeight = std::max(m_UsedHeight, outY + height);
+			return true;
+		}
+
+		uint32_t GetUsedHeight() const { return m_UsedHeight; }
+	private:
+		bool Fit(size_t index, uint32_t width, uint32_t height, uint32_t& outY) const
+		{
+			if (m_Skyline[index].X + width > m_Width)
+				return false;
+
+			uint32_t y = 0;
+			int64_t widthLeft = width;
+			for (size_t i = index; widthLeft > 0; i++)
+			{
+				y = std::max(y, m_Skyline[i].Y);
+				if (y + height > m_Height)
+					return false;
+
+				widthLeft -= m_Skyline[i].Width;
+			}
+
+			outY = y;
+			return true;
+		}
+	private:
+		struct Segment
+		{
+			uint32_t X, Y, Width;
+		};
+
+		uint32_t m_Width, m_Height;
+		uint32_t m_UsedHeight = 0;
+		std::vector<Segment> m_Skyline;
+	};
+
+	TextureAtlas::TextureAtlas(const TextureAtlasSpecification& specification)
+		: m_Specification(specification)
+	{
+	}
+
+	TextureAtlas::~TextureAtlas()
+	{
+		for (PendingImage& image : m_PendingImages)
+			image.Pixels.Release();
+	}
+
+	bool TextureAtlas::Add(const std::filesystem::path& path)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		std::string pathString = path.string();
+
+		int width, height, channels;
+		if (!stbi_info(pathString.c_str(), &width, &height, &channels))
+		{
+			HZ_CORE_WARN("TextureAtlas: could not read '{0}'", pathString);
+			return false;
+		}
+
+		if ((uint32_t)width > m_Specification.MaxImageSize || (uint32_t)height > m_Specification.MaxImageSize)
+			return false;
+
+		// Same orientation as OpenGLTexture2D, so atlas entries and standalone textures are interchangeable
+		stbi_set_flip_vertically_on_load(1);
+		stbi_uc* data = stbi_load(pathString.c_str(), &width, &height, &channels, 4);
+		if (!data)
+		{
+			HZ_CORE_WARN("TextureAtlas: could not load '{0}'", pathString);
+			return false;
+		}
+
+		bool added = Add(pathString, (uint32_t)width, (uint32_t)height, data);
+		stbi_image_free(data);
+		return added;
+	}
+
+	bool TextureAtlas::Add(const std::string& name, uint32_t width, uint32_t height, const void* pixels)
+	{
+		HZ_CORE_ASSERT(width > 0 && height > 0);
+
+		uint32_t paddedSize = 2 * m_Specification.Padding;
+		if (width + paddedSize > m_Specification.PageSize || height + paddedSize > m_Specification.PageSize)
+			return false;
+
+		PendingImage& image = m_PendingImages.emplace_back();
+		image.Name = Utils::AtlasKey(name);
+		image.Width = width;
+		image.Height = height;
+		image.Pixels = Buffer::Copy(pixels, (uint64_t)width * height * 4);
+		return true;
+	}
+
+	uint32_t TextureAtlas::AddDirectory(const std::filesystem::path& directory)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		uint32_t count = 0;
+		std::error_code error;
+		for (auto& entry : std::filesystem::recursive_directory_iterator(directory, error))
+		{
+			if (entry.is_regular_file() && Utils::IsAtlasImage(entry.path()) && Add(entry.path()))
+				count++;
+		}
+
+		return count;
+	}
+
+	void TextureAtlas::Build()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (m_PendingImages.empty())
+			return;
+
+		const uint32_t pageSize = m_Specification.PageSize;
+		const uint32_t padding = m_Specification.Padding;
+
+		// Tallest first keeps the skyline flat
+		std::vector<uint32_t> order(m_PendingImages.size());
+		for (uint32_t i = 0; i < (uint32_t)order.size(); i++)
+			order[i] = i;
+		std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b)
+		{
+			const PendingImage& imageA = m_PendingImages[a];
+			const PendingImage& imageB = m_PendingImages[b];
+			return imageA.Height != imageB.Height ? imageA.Height > imageB.Height : imageA.Width > imageB.Width;
+		});
+
+		struct Placement
+		{
+			uint32_t Page, X, Y;
+		};
+		std::vector<Placement> placements(m_PendingImages.size());
+		std::vector<SkylinePacker> packers;
+
+		for (uint32_t index : order)
+		{
+			const PendingImage& image = m_PendingImages[index];
+			uint32_t width = image.Width + 2 * padding;
+			uint32_t height = image.Height + 2 * padding;
+
+			Placement& placement = placements[index];
+			bool packed = false;
+			for (uint32_t page = 0; page < (uint32_t)packers.size() && !packed; page++)
+			{
+				packed = packers[page].Pack(width, height, placement.X, placement.Y);
+				placement.Page = page;
+			}
+
+			if (!packed)
+			{
+				placement.Page = (uint32_t)packers.size();
+				packers.emplace_back(pageSize, pageSize);
+				packed = packers.back().Pack(width, height, placement.X, placement.Y);
+				HZ_CORE_ASSERT(packed);
+			}
+		}
+
+		// Pages are only as tall as they need to be
+		std::vector<Buffer> pageData(packers.size());
+		std::vector<uint32_t> pageHeights(packers.size());
+		for (size_t page = 0; page < packers.size(); page++)
+		{
+			pageHeights[page] = std::min(pageSize, Utils::NextPowerOfTwo(packers[page].GetUsedHeight()));
+			pageData[page].Allocate((uint64_t)pageSize * pageHeights[page] * 4);
+			memset(pageData[page].Data, 0, pageData[page].Size);
+		}
+
+		uint32_t firstPage = (uint32_t)m_Pages.size();
+		for (size_t page = 0; page < packers.size(); page++)
+		{
+			TextureSpecification spec;
+			spec.Width = pageSize;
+			spec.Height = pageHeights[page];
+			spec.Format = ImageFormat::RGBA8;
+			spec.GenerateMips = false;
+			m_Pages.push_back(Texture2D::Create(spec));
+		}
+
+		for (size_t i = 0; i < m_PendingImages.size(); i++)
+		{
+			PendingImage& image = m_PendingImages[i];
+			const Placement& placement = placements[i];
+
+			// Copy the image with its edge pixels repeated across the padding
+			uint32_t* destination = pageData[placement.Page].As<uint32_t>();
+			const uint32_t* source = image.Pixels.As<uint32_t>();
+			for (int64_t y = -(int64_t)padding; y < (int64_t)(image.Height + padding); y++)
+			{
+				int64_t sourceY = std::clamp<int64_t>(y, 0, image.Height - 1);
+				uint32_t* row = destination + (placement.Y + padding + y) * pageSize + placement.X + padding;
+				const uint32_t* sourceRow = source + sourceY * image.Width;
+
+				memcpy(row, sourceRow, image.Width * 4);
+				for (uint32_t x = 1; x <= padding; x++)
+				{
+					row[-(int64_t)x] = sourceRow[0];
+					row[image.Width - 1 + x] = sourceRow[image.Width - 1];
+				}
+			}
+
+			Ref<Texture2D> pageTexture = m_Pages[firstPage + placement.Page];
+			float pageHeight = (float)pageHeights[placement.Page];
+			glm::vec2 min = { (float)(placement.X + padding) / pageSize, (float)(placement.Y + padding) / pageHeight };
+			glm::vec2 max = { (float)(placement.X + padding + image.Width) / pageSize, (float)(placement.Y + padding + image.Height) / pageHeight };
+			m_SubTextures[image.Name] = CreateRef<SubTexture2D>(pageTexture, min, max, image.Name);
+
+			image.Pixels.Release();
+		}
+
+		for (size_t page = 0; page < packers.size(); page++)
+		{
+			m_Pages[firstPage + page]->SetData(pageData[page].Data, (uint32_t)pageData[page].Size);
+			pageData[page].Release();
+		}
+
+		HZ_CORE_INFO("TextureAtlas: packed {0} images into {1} page(s)", m_PendingImages.size(), packers.size());
+		m_PendingImages.clear();
+	}
+
+	Ref<SubTexture2D> TextureAtlas::GetSubTexture(const std::filesystem::path& path) const
+	{
+		auto it = m_SubTextures.find(Utils::AtlasKey(path));
+		if (it == m_SubTextures.end())
+			return nullptr;
+
+		return it->second;
+	}
+
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "XingXing/Core/Buffer.h"
+#include "XingXing/Renderer/SubTexture2D.h"
+
+#include <filesystem>
+#include <unordered_map>
+#include <vector>
+
+namespace Hazel {
+
+	struct TextureAtlasSpecification
+	{
+		uint32_t PageSize = 2048;
+		// Empty border around every image; edge pixels are extruded into it so filtering does not bleed
+		uint32_t Padding = 2;
+		// Images larger than this in either dimension are not packed and stay separate textures
+		uint32_t MaxImageSize = 256;
+	};
+
+	// Packs small images into shared RGBA8 pages so sprites using them can be drawn in one batch
+	// without competing for texture slots
+	class TextureAtlas
+	{
+	public:
+		TextureAtlas(const TextureAtlasSpecification& specification = TextureAtlasSpecification());
+		~TextureAtlas();
+
+		// Returns false if the image cannot be loaded or is too large for the atlas
+		bool Add(const std::filesystem::path& path);
+		// Adds a copy of RGBA8 pixels, rows ordered bottom to top like Texture2D::SetData
+		bool Add(const std::string& name, uint32_t width, uint32_t height, const void* pixels);
+		// Adds every supported image below the directory, returns the number of images added
+		uint32_t AddDirectory(const std::filesystem::path& directory);
+
+		// Packs the images added since the last build into new pages and uploads them
+		void Build();
+
+		// Looks up an entry by the path or name it was added with, returns nullptr if it is not in the atlas
+		Ref<SubTexture2D> GetSubTexture(const std::filesystem::path& path) const;
+
+		const std::vector<Ref<Texture2D>>& GetPages() const { return m_Pages; }
+		uint32_t GetSubTextureCount() const { return (uint32_t)m_SubTextures.size(); }
+		const TextureAtlasSpecification& GetSpecification() const { return m_Specification; }
+	private:
+		struct PendingImage
+		{
+			std::string Name;
+			uint32_t Width = 0, Height = 0;
+			Buffer Pixels;
+		};
+	private:
+		TextureAtlasSpecification m_Specification;
+
+		std::vector<PendingImage> m_PendingImages;
+		std::unordered_map<std::string, Ref<SubTexture2D>> m_SubTextures;
+		std::vector<Ref<Texture2D>> m_Pages;
+	};
+
+}
@@ -11,7 +11,7 @@ namespace Hazel {
 		switch (Renderer::GetAPI())
 		{
 			case RendererAPI::API::None:    HZ_CORE_ASSERT(false, "RendererAPI::None is currently not supported!"); return nullptr;
-			case RendererAPI::API::OpenGL:  return CreateRef<OpenGLUniformBuffer>(size, binding);
+			case RendererAPI::API::OpenGL:  return Renderer::CreateResource<OpenGLUniformBuffer>(size, binding);
 		}
 
 		HZ_CORE_ASSERT(false, "Unknown RendererAPI!");
@@ -2,8 +2,11 @@
 
 #include "SceneCamera.h"
 #include "XingXing/Core/UUID.h"
+#include "XingXing/Asset/AssetTable.h"
 #include "XingXing/Renderer/Texture.h"
+#include "XingXing/Renderer/SubTexture2D.h"
 #include "XingXing/Renderer/Font.h"
+#include "XingXing/Scene/UpdateLOD.h"
 
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
@@ -11,6 +14,8 @@
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/quaternion.hpp>
 
+#include "entt.hpp"
+
 namespace Hazel {
 
 	struct IDComponent
@@ -31,6 +36,13 @@ namespace Hazel {
 			: Tag(tag) {}
 	};
 
+	// Tag for switched off entities. Scene views exclude it, so they skip disabled entities
+	// without checking each one. Toggle it through Scene::SetEntityActive. It is not inherited:
+	// the children of a disabled entity stay active unless they are disabled themselves.
+	struct DisabledComponent
+	{
+	};
+
 	struct TransformComponent
 	{
 		glm::vec3 Translation = { 0.0f, 0.0f, 0.0f };
@@ -52,10 +64,46 @@ namespace Hazel {
 		}
 	};
 
+	// Parent and children by UUID, so the hierarchy survives serialization and scene copies.
+	// Change it through Scene::SetParent, which keeps WorldTransformComponent in sync.
+	struct RelationshipComponent
+	{
+		UUID Parent = 0;
+		std::vector<UUID> Children;
+
+		RelationshipComponent() = default;
+		RelationshipComponent(const RelationshipComponent&) = default;
+	};
+
+	// Maintained by the scene. The pool is kept sorted parents first, so world transforms are
+	// propagated in one sweep; the local transform they were computed from lets unchanged subtrees be skipped.
+	struct WorldTransformComponent
+	{
+		glm::mat4 Transform{ 1.0f };
+		// What gets drawn: Transform, with rigidbodies in between their last two physics states
+		glm::mat4 RenderTransform{ 1.0f };
+
+		entt::entity Parent = entt::null;
+		uint32_t Depth = 0;
+
+		glm::vec3 LocalTranslation{ 0.0f };
+		glm::vec3 LocalRotation{ 0.0f };
+		glm::vec3 LocalScale{ 1.0f };
+		bool Dirty = true; // Recompute regardless of the local transform
+		bool Updated = false; // Recomputed in the last sweep, so the children have to be as well
+		bool Interpolated = false; // Has a physics body, its render transform changes every frame
+		bool RenderUpdated = false;
+
+		WorldTransformComponent() = default;
+		WorldTransformComponent(const WorldTransformComponent&) = default;
+	};
+
 	struct SpriteRendererComponent
 	{
 		glm::vec4 Color{ 1.0f, 1.0f, 1.0f, 1.0f };
-		Ref<Texture2D> Texture;
+		AssetHandle<Texture2D> Texture;
+		// Takes precedence over Texture, e.g. when the texture was packed into the project's sprite atlas
+		AssetHandle<SubTexture2D> SubTexture;
 		float TilingFactor = 1.0f;
 
 		SpriteRendererComponent() = default;
@@ -63,6 +111,8 @@ namespace Hazel {
 		SpriteRendererComponent(const glm::vec4& color)
 			: Color(color) {}
 	};
+	// Copied in bulk by scene copies and prefab instantiation
+	static_assert(std::is_trivially_copyable_v<SpriteRendererComponent>);
 
 	struct CircleRendererComponent
 	{
@@ -99,8 +149,8 @@ namespace Hazel {
 	{
 		ScriptableEntity* Instance = nullptr;
 
-		ScriptableEntity*(*InstantiateScript)();
-		void (*DestroyScript)(NativeScriptComponent*);
+		ScriptableEntity*(*InstantiateScript)() = nullptr;
+		void (*DestroyScript)(NativeScriptComponent*) = nullptr;
 
 		template<typename T>
 		void Bind()
@@ -110,6 +160,28 @@ namespace Hazel {
 		}
 	};
 
+	// Overrides the update LOD of the entity's script class, see Scene::SetScriptUpdateLOD
+	struct UpdateLODComponent
+	{
+		UpdateLODSettings Settings;
+
+		UpdateLODComponent() = default;
+		UpdateLODComponent(const UpdateLODComponent&) = default;
+	};
+
+	// Storage for runtime, entities without it update every frame
+	struct UpdateLODStateComponent
+	{
+		UpdateLODTier Tier = UpdateLODTier::Full;
+		uint32_t Interval = 1;
+		// Frame time not yet passed to the scripts
+		float AccumulatedTime = 0.0f;
+
+		// This frame's decision
+		bool Update = true;
+		float Timestep = 0.0f;
+	};
+
 	// Physics
 
 	struct Rigidbody2DComponent
@@ -120,6 +192,10 @@ namespace Hazel {
 
 		// Storage for runtime
 		void* RuntimeBody = nullptr;
+		// Pose before the last fixed step. TransformComponent holds the body's current pose,
+		// WorldTransformComponent::RenderTransform one in between the two.
+		glm::vec2 PreviousPosition = { 0.0f, 0.0f };
+		float PreviousAngle = 0.0f;
 
 		Rigidbody2DComponent() = default;
 		Rigidbody2DComponent(const Rigidbody2DComponent&) = default;
@@ -164,7 +240,7 @@ namespace Hazel {
 	struct TextComponent
 	{
 		std::string TextString;
-		Ref<Font> FontAsset = Font::GetDefault();
+		AssetHandle<Font> FontAsset; // The default font when not set
 		glm::vec4 Color{ 1.0f };
 		float Kerning = 0.0f;
 		float LineSpacing = 0.0f;
@@ -179,6 +255,6 @@ namespace Hazel {
 		ComponentGroup<TransformComponent, SpriteRendererComponent,
 			CircleRendererComponent, CameraComponent, ScriptComponent,
 			NativeScriptComponent, Rigidbody2DComponent, BoxCollider2DComponent,
-			CircleCollider2DComponent, TextComponent>;
+			CircleCollider2DComponent, TextComponent, UpdateLODComponent>;
 
 }
@@ -58,6 +58,14 @@ namespace Hazel {
 
 		UUID GetUUID() { return GetComponent<IDComponent>().ID; }
 		const std::string& GetName() { return GetComponent<TagComponent>().Tag; }
+		void SetName(std::string_view name) { m_Scene->SetEntityName(*this, name); }
+
+		bool IsActive() { return m_Scene->IsEntityActive(*this); }
+		void SetActive(bool active) { m_Scene->SetEntityActive(*this, active); }
+
+		Entity GetParent() { return m_Scene->GetParent(*this); }
+		void SetParent(Entity parent) { m_Scene->SetParent(*this, parent); }
+		const std::vector<UUID>& GetChildren() { return GetComponent<RelationshipComponent>().Children; }
 
 		bool operator==(const Entity& other) const
 		{
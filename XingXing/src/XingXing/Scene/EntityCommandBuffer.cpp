@@ -0,0 +1,308 @@
+#include "hzpch.h"
+#include "XingXing/Scene/EntityCommandBuffer.h"
+
+#include "XingXing/Scene/Scene.h"
+#include "XingXing/Scene/Components.h"
+
+namespace Hazel {
+
+	UUID EntityCommandBuffer::CreateEntity(const std::string& name)
+	{
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+
+		CreateCommand& command = m_CreateCommands.emplace_back();
+		command.ID = UUID();
+		command.Source = 0;
+		command.Name = name;
+		return command.ID;
+	}
+
+	UUID EntityCommandBuffer::Instantiate(UUID source)
+	{
+		HZ_CORE_ASSERT(source != 0);
+
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+
+		CreateCommand& command = m_CreateCommands.emplace_back();
+		command.ID = UUID();
+		command.Source = source;
+		return command.ID;
+	}
+
+	UUID EntityCommandBuffer::Instantiate(UUID source, const glm::vec3& translation)
+	{
+		HZ_CORE_ASSERT(source != 0);
+
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+
+		CreateCommand& command = m_CreateCommands.emplace_back();
+		command.ID = UUID();
+		command.Source = source;
+		command.OverrideTranslation = true;
+		command.Translation = translation;
+		return command.ID;
+	}
+
+	UUID EntityCommandBuffer::Instantiate(const Ref<Prefab>& prefab)
+	{
+		Entity source = prefab->GetEntity();
+		return Instantiate(prefab, source.GetComponent<TransformComponent>().Translation);
+	}
+
+	UUID EntityCommandBuffer::Instantiate(const Ref<Prefab>& prefab, const glm::vec3& translation)
+	{
+		UUID id;
+		Instantiate(prefab, &translation, 1, &id);
+		return id;
+	}
+
+	void EntityCommandBuffer::Instantiate(const Ref<Prefab>& prefab, const glm::vec3* translations, uint32_t count, UUID* outIDs)
+	{
+		HZ_CORE_ASSERT(prefab);
+
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+
+		m_CreateCommands.reserve(m_CreateCommands.size() + count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			CreateCommand& command = m_CreateCommands.emplace_back();
+			command.ID = UUID();
+			command.Source = 0;
+			command.SourcePrefab = prefab;
+			command.OverrideTranslation = true;
+			command.Translation = translations[i];
+
+			if (outIDs)
+				outIDs[i] = command.ID;
+		}
+	}
+
+	void EntityCommandBuffer::DestroyEntity(UUID entity)
+	{
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+
+		m_DestroyCommands.push_back(entity);
+	}
+
+	void EntityCommandBuffer::Playback(Scene& scene)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		std::vector<CreateCommand> createCommands;
+		std::vector<UUID> destroyCommands;
+		ComponentCommandMap addComponentCommands;
+		ComponentCommandMap removeComponentCommands;
+		{
+			std::scoped_lock<std::mutex> lock(m_Mutex);
+
+			std::swap(createCommands, m_CreateCommands);
+			std::swap(destroyCommands, m_DestroyCommands);
+			std::swap(addComponentCommands, m_AddComponentCommands);
+			std::swap(removeComponentCommands, m_RemoveComponentCommands);
+		}
+
+		// Entities have to exist before components can be added to them, and destroys go last so
+		// commands for entities destroyed in the same frame are still valid.
+		if (!createCommands.empty())
+			PlaybackCreates(scene, createCommands);
+
+		for (auto& [type, commands] : addComponentCommands)
+			commands->Playback(scene);
+
+		for (auto& [type, commands] : removeComponentCommands)
+			commands->Playback(scene);
+
+		if (!destroyCommands.empty())
+			PlaybackDestroys(scene, destroyCommands);
+	}
+
+	bool EntityCommandBuffer::IsEmpty() const
+	{
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+
+		if (!m_CreateCommands.empty() || !m_DestroyCommands.empty())
+			return false;
+
+		for (const auto& [type, commands] : m_AddComponentCommands)
+		{
+			if (!commands->IsEmpty())
+				return false;
+		}
+
+		for (const auto& [type, commands] : m_RemoveComponentCommands)
+		{
+			if (!commands->IsEmpty())
+				return false;
+		}
+
+		return true;
+	}
+
+	void EntityCommandBuffer::Clear()
+	{
+		std::scoped_lock<std::mutex> lock(m_Mutex);
+
+		m_CreateCommands.clear();
+		m_DestroyCommands.clear();
+		m_AddComponentCommands.clear();
+		m_RemoveComponentCommands.clear();
+	}
+
+	// Appends the descendants of entity, parents before their children
+	static void CollectDescendants(Scene& scene, Entity entity, std::vector<entt::entity>& outEntities)
+	{
+		for (UUID childID : entity.GetComponent<RelationshipComponent>().Children)
+		{
+			if (Entity child = scene.GetEntityByUUID(childID))
+			{
+				outEntities.push_back(child);
+				CollectDescendants(scene, child, outEntities);
+			}
+		}
+	}
+
+	void EntityCommandBuffer::PlaybackCreates(Scene& scene, std::vector<CreateCommand>& commands)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		entt::registry& registry = scene.m_Registry;
+
+		// Group copies of the same source so each run is a handful of range inserts; empty entities sort first
+		std::stable_sort(commands.begin(), commands.end(), [](const CreateCommand& a, const CreateCommand& b)
+		{
+			if (a.Source != b.Source)
+				return (uint64_t)a.Source < (uint64_t)b.Source;
+			return a.SourcePrefab.get() < b.SourcePrefab.get();
+		});
+
+		std::vector<UUID> ids;
+		ids.reserve(commands.size());
+		for (const CreateCommand& command : commands)
+			ids.push_back(command.ID);
+
+		std::vector<entt::entity> entities(commands.size());
+		// Copies of the sources' children, initialized along with the roots
+		std::vector<entt::entity> descendants;
+
+		size_t runStart = 0;
+		while (runStart < commands.size())
+		{
+			const CreateCommand& run = commands[runStart];
+			size_t runEnd = runStart + 1;
+			while (runEnd < commands.size() && commands[runEnd].Source == run.Source && commands[runEnd].SourcePrefab == run.SourcePrefab)
+				runEnd++;
+
+			Entity source;
+			if (run.SourcePrefab)
+				source = run.SourcePrefab->GetEntity();
+			else if (run.Source != 0)
+			{
+				source = scene.GetEntityByUUID(run.Source);
+				if (!source)
+					HZ_CORE_WARN("Instantiating entity {0} which no longer exists, creating empty entities instead", (uint64_t)run.Source);
+			}
+
+			if (source)
+			{
+				scene.CloneEntities(source, ids.data() + runStart, entities.data() + runStart, runEnd - runStart);
+
+				// The copies start out as roots, the subtrees are duplicated the way DuplicateEntity does
+				if (!source.GetComponent<RelationshipComponent>().Children.empty())
+				{
+					// Copied, adding the duplicates can move the source's relationship
+					const std::vector<UUID> children = source.GetComponent<RelationshipComponent>().Children;
+					for (size_t i = runStart; i < runEnd; i++)
+					{
+						Entity copy = { entities[i], &scene };
+						for (UUID childID : children)
+						{
+							if (Entity child = scene.GetEntityByUUID(childID))
+								scene.DuplicateSubtree(child, copy);
+						}
+						CollectDescendants(scene, copy, descendants);
+					}
+				}
+			}
+			else
+			{
+				entt::entity* first = entities.data() + runStart;
+				entt::entity* last = entities.data() + runEnd;
+				registry.create(first, last);
+
+				std::vector<IDComponent> idComponents;
+				std::vector<TagComponent> tags;
+				idComponents.reserve(runEnd - runStart);
+				tags.reserve(runEnd - runStart);
+				for (size_t i = runStart; i < runEnd; i++)
+				{
+					idComponents.push_back(IDComponent{ commands[i].ID });
+					tags.emplace_back(commands[i].Name.empty() ? "Entity" : std::move(commands[i].Name));
+				}
+				registry.insert<IDComponent>(first, last, idComponents.begin(), idComponents.end());
+				registry.insert<TagComponent>(first, last, tags.begin(), tags.end());
+				registry.insert<TransformComponent>(first, last);
+				registry.insert<RelationshipComponent>(first, last);
+				registry.insert<WorldTransformComponent>(first, last);
+
+				for (size_t i = runStart; i < runEnd; i++)
+				{
+					scene.m_EntityMap[commands[i].ID] = entities[i];
+					scene.m_NameIndex.Add(scene.m_NameIndex.Intern(registry.get<TagComponent>(entities[i]).Tag), entities[i]);
+				}
+			}
+
+			runStart = runEnd;
+		}
+
+		for (size_t i = 0; i < commands.size(); i++)
+		{
+			if (commands[i].OverrideTranslation)
+				registry.get<TransformComponent>(entities[i]).Translation = commands[i].Translation;
+		}
+
+		for (entt::entity entity : entities)
+			scene.InitializeRuntimeEntity(Entity{ entity, &scene });
+		for (entt::entity entity : descendants)
+			scene.InitializeRuntimeEntity(Entity{ entity, &scene });
+	}
+
+	void EntityCommandBuffer::PlaybackDestroys(Scene& scene, const std::vector<UUID>& uuids)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		std::vector<entt::entity> entities;
+		entities.reserve(uuids.size());
+		for (UUID uuid : uuids)
+		{
+			entt::entity entity = ResolveEntity(scene, uuid);
+			if (entity != entt::null)
+				entities.push_back(entity);
+		}
+
+		// Children go with their parents
+		for (size_t i = 0; i < entities.size(); i++)
+		{
+			for (UUID childID : scene.m_Registry.get<RelationshipComponent>(entities[i]).Children)
+			{
+				entt::entity child = ResolveEntity(scene, childID);
+				if (child != entt::null)
+					entities.push_back(child);
+			}
+		}
+
+		std::sort(entities.begin(), entities.end());
+		entities.erase(std::unique(entities.begin(), entities.end()), entities.end());
+
+		for (entt::entity entity : entities)
+			scene.ReleaseEntityResources(Entity{ entity, &scene });
+
+		scene.m_Registry.destroy(entities.begin(), entities.end());
+	}
+
+	entt::entity EntityCommandBuffer::ResolveEntity(Scene& scene, UUID uuid)
+	{
+		auto it = scene.m_EntityMap.find(uuid);
+		return it != scene.m_EntityMap.end() ? it->second : entt::null;
+	}
+
+}
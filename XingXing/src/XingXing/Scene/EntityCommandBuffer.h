@@ -0,0 +1,260 @@
+#pragma once
+
+#include "XingXing/Core/Base.h"
+#include "XingXing/Core/UUID.h"
+#include "XingXing/Core/FlatHashMap.h"
+#include "XingXing/Scene/Entity.h"
+#include "XingXing/Scene/Prefab.h"
+
+#include <glm/glm.hpp>
+
+#include <mutex>
+
+namespace Hazel {
+
+	// Records structural changes (creating and destroying entities, adding and removing components)
+	// so they can be made while views are being iterated, possibly from several threads. The scene
+	// plays them back at its sync points, batched per command and component type.
+	//
+	// Entities created through the buffer get their UUID right away, but only exist after playback.
+	class EntityCommandBuffer
+	{
+	public:
+		EntityCommandBuffer() = default;
+		EntityCommandBuffer(const EntityCommandBuffer&) = delete;
+		EntityCommandBuffer& operator=(const EntityCommandBuffer&) = delete;
+
+		UUID CreateEntity(const std::string& name = std::string());
+		// Copies source and its children with all their components at playback time
+		UUID Instantiate(UUID source);
+		UUID Instantiate(UUID source, const glm::vec3& translation);
+		UUID Instantiate(const Ref<Prefab>& prefab);
+		UUID Instantiate(const Ref<Prefab>& prefab, const glm::vec3& translation);
+		// Records count instances under a single lock, outIDs is optional
+		void Instantiate(const Ref<Prefab>& prefab, const glm::vec3* translations, uint32_t count, UUID* outIDs = nullptr);
+		void DestroyEntity(UUID entity);
+
+		// Adds or replaces the component. Physics bodies and script instances are created for it at playback.
+		template<typename T>
+		void AddComponent(UUID entity, const T& component = T())
+		{
+			std::scoped_lock<std::mutex> lock(m_Mutex);
+			auto& commands = GetComponentCommands<AddComponentCommands<T>>(m_AddComponentCommands);
+			commands.Entities.push_back(entity);
+			commands.Components.push_back(component);
+		}
+
+		template<typename T>
+		void RemoveComponent(UUID entity)
+		{
+			std::scoped_lock<std::mutex> lock(m_Mutex);
+			auto& commands = GetComponentCommands<RemoveComponentCommands<T>>(m_RemoveComponentCommands);
+			commands.Entities.push_back(entity);
+		}
+
+		// Commands recorded during playback, e.g. by scripts being created, are kept for the next one
+		void Playback(Scene& scene);
+
+		bool IsEmpty() const;
+		void Clear();
+	private:
+		struct CreateCommand
+		{
+			UUID ID;
+			UUID Source; // 0 for empty entities and prefabs
+			Ref<Prefab> SourcePrefab;
+			std::string Name;
+			bool OverrideTranslation = false;
+			glm::vec3 Translation{ 0.0f };
+		};
+
+		struct ComponentCommands
+		{
+			virtual ~ComponentCommands() = default;
+			virtual void Playback(Scene& scene) = 0;
+			virtual bool IsEmpty() const = 0;
+		};
+
+		template<typename T>
+		struct AddComponentCommands : ComponentCommands
+		{
+			std::vector<UUID> Entities;
+			std::vector<T> Components;
+
+			virtual void Playback(Scene& scene) override;
+			virtual bool IsEmpty() const override { return Entities.empty(); }
+		};
+
+		template<typename T>
+		struct RemoveComponentCommands : ComponentCommands
+		{
+			std::vector<UUID> Entities;
+
+			virtual void Playback(Scene& scene) override;
+			virtual bool IsEmpty() const override { return Entities.empty(); }
+		};
+
+		using ComponentCommandMap = FlatHashMap<entt::id_type, Scope<ComponentCommands>>;
+
+		template<typename Commands>
+		static Commands& GetComponentCommands(ComponentCommandMap& map)
+		{
+			auto& commands = map[entt::type_info<Commands>::id()];
+			if (!commands)
+				commands = CreateScope<Commands>();
+			return static_cast<Commands&>(*commands);
+		}
+
+		// Physics and script components have runtime state in the scene, which follows them during playback
+		template<typename T>
+		static constexpr bool IsPhysicsComponent = std::is_same_v<T, Rigidbody2DComponent>
+			|| std::is_same_v<T, BoxCollider2DComponent> || std::is_same_v<T, CircleCollider2DComponent>;
+
+		template<typename T>
+		static void ReleaseRuntimeComponent(Scene& scene, Entity entity);
+		template<typename T>
+		static void InitializeRuntimeComponent(Scene& scene, Entity entity);
+
+		static void PlaybackCreates(Scene& scene, std::vector<CreateCommand>& commands);
+		static void PlaybackDestroys(Scene& scene, const std::vector<UUID>& entities);
+
+		// entt::null if there is no entity with the UUID (anymore)
+		static entt::entity ResolveEntity(Scene& scene, UUID uuid);
+	private:
+		mutable std::mutex m_Mutex;
+
+		std::vector<CreateCommand> m_CreateCommands;
+		std::vector<UUID> m_DestroyCommands;
+		ComponentCommandMap m_AddComponentCommands;
+		ComponentCommandMap m_RemoveComponentCommands;
+	};
+
+	template<typename T>
+	void EntityCommandBuffer::ReleaseRuntimeComponent(Scene& scene, Entity entity)
+	{
+		if constexpr (std::is_same_v<T, Rigidbody2DComponent>)
+			scene.DestroyPhysicsBody(entity);
+		else if constexpr (std::is_same_v<T, ScriptComponent>)
+			scene.DestroyScriptInstance(entity);
+		else if constexpr (std::is_same_v<T, NativeScriptComponent>)
+			scene.DestroyNativeScript(entity);
+	}
+
+	template<typename T>
+	void EntityCommandBuffer::InitializeRuntimeComponent(Scene& scene, Entity entity)
+	{
+		// Colliders are fixtures of the body, so the body is rebuilt with them
+		if constexpr (IsPhysicsComponent<T>)
+			scene.RecreatePhysicsBody(entity);
+		else if constexpr (std::is_same_v<T, ScriptComponent>)
+			scene.CreateScriptInstance(entity);
+		else if constexpr (std::is_same_v<T, NativeScriptComponent>)
+		{
+			if (scene.m_IsRunning)
+				scene.m_PendingNativeScripts.push_back(entity);
+		}
+	}
+
+	template<typename T>
+	void EntityCommandBuffer::AddComponentCommands<T>::Playback(Scene& scene)
+	{
+		entt::registry& registry = scene.m_Registry;
+
+		// Components for entities that don't have one yet are inserted as a range, the rest replaced
+		std::vector<entt::entity> entities(Entities.size());
+		std::vector<entt::entity> insertEntities;
+		std::vector<T> insertComponents;
+		FlatHashMap<entt::entity, size_t> insertIndices;
+		for (size_t i = 0; i < Entities.size(); i++)
+		{
+			entities[i] = ResolveEntity(scene, Entities[i]);
+			if (entities[i] == entt::null || registry.has<T>(entities[i]))
+				continue;
+
+			if (insertIndices.try_emplace(entities[i], i).second)
+			{
+				insertEntities.push_back(entities[i]);
+				insertComponents.push_back(Components[i]);
+			}
+		}
+
+		registry.insert<T>(insertEntities.begin(), insertEntities.end(), insertComponents.begin(), insertComponents.end());
+		for (entt::entity entity : insertEntities)
+			scene.OnComponentAdded<T>(Entity{ entity, &scene }, registry.get<T>(entity));
+
+		// Replacements, in recording order so the last command wins. Runtime state is released once
+		// before the first one; entities that were just inserted have none yet.
+		constexpr bool hasRuntimeState = IsPhysicsComponent<T> || std::is_same_v<T, ScriptComponent> || std::is_same_v<T, NativeScriptComponent>;
+		std::vector<entt::entity> replacedEntities;
+		FlatHashMap<entt::entity, size_t> replacedIndices;
+		for (size_t i = 0; i < Entities.size(); i++)
+		{
+			if (entities[i] == entt::null)
+				continue;
+
+			auto it = insertIndices.find(entities[i]);
+			if (it != insertIndices.end() && it->second == i)
+				continue;
+
+			if constexpr (hasRuntimeState)
+			{
+				if (it == insertIndices.end() && replacedIndices.try_emplace(entities[i], i).second)
+				{
+					ReleaseRuntimeComponent<T>(scene, Entity{ entities[i], &scene });
+					replacedEntities.push_back(entities[i]);
+				}
+			}
+			registry.emplace_or_replace<T>(entities[i], Components[i]);
+		}
+
+		// Recorded components carry no runtime handles, they are created for the final components
+		if constexpr (hasRuntimeState)
+		{
+			// OnComponentAdded already queued inserted native scripts
+			if constexpr (!std::is_same_v<T, NativeScriptComponent>)
+			{
+				for (entt::entity entity : insertEntities)
+					InitializeRuntimeComponent<T>(scene, Entity{ entity, &scene });
+			}
+			for (entt::entity entity : replacedEntities)
+				InitializeRuntimeComponent<T>(scene, Entity{ entity, &scene });
+		}
+
+		Entities.clear();
+		Components.clear();
+	}
+
+	template<typename T>
+	void EntityCommandBuffer::RemoveComponentCommands<T>::Playback(Scene& scene)
+	{
+		entt::registry& registry = scene.m_Registry;
+
+		std::vector<entt::entity> entities;
+		entities.reserve(Entities.size());
+		for (UUID uuid : Entities)
+		{
+			entt::entity entity = ResolveEntity(scene, uuid);
+			if (entity != entt::null && registry.has<T>(entity))
+				entities.push_back(entity);
+		}
+
+		// remove() requires every entity to have the component, so drop duplicates
+		std::sort(entities.begin(), entities.end());
+		entities.erase(std::unique(entities.begin(), entities.end()), entities.end());
+
+		for (entt::entity entity : entities)
+			ReleaseRuntimeComponent<T>(scene, Entity{ entity, &scene });
+
+		registry.remove<T>(entities.begin(), entities.end());
+
+		// The body loses the collider's fixture
+		if constexpr (std::is_same_v<T, BoxCollider2DComponent> || std::is_same_v<T, CircleCollider2DComponent>)
+		{
+			for (entt::entity entity : entities)
+				scene.RecreatePhysicsBody(Entity{ entity, &scene });
+		}
+
+		Entities.clear();
+	}
+
+}
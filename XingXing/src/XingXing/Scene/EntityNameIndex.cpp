@@ -0,0 +1,54 @@
+#include "hzpch.h"
+#include "XingXing/Scene/EntityNameIndex.h"
+
+namespace Hazel {
+
+	EntityNameIndex::EntityNameIndex()
+	{
+		// Reserve InvalidNameID
+		m_Names.emplace_back();
+		m_Entities.emplace_back();
+	}
+
+	NameID EntityNameIndex::Intern(std::string_view name)
+	{
+		NameID id = GetNameID(name);
+		if (id != InvalidNameID)
+			return id;
+
+		id = (NameID)m_Names.size();
+		m_Names.emplace_back(name);
+		m_Entities.emplace_back();
+		m_Lookup.emplace(std::hash<std::string_view>()(name), id);
+		m_SortedNames.emplace(name, id);
+		return id;
+	}
+
+	NameID EntityNameIndex::GetNameID(std::string_view name) const
+	{
+		auto [begin, end] = m_Lookup.equal_range(std::hash<std::string_view>()(name));
+		for (auto it = begin; it != end; ++it)
+		{
+			if (m_Names[it->second] == name)
+				return it->second;
+		}
+		return InvalidNameID;
+	}
+
+	void EntityNameIndex::Add(NameID id, entt::entity entity)
+	{
+		HZ_CORE_ASSERT(id != InvalidNameID && id < m_Entities.size());
+		m_Entities[id].push_back(entity);
+	}
+
+	void EntityNameIndex::Remove(NameID id, entt::entity entity)
+	{
+		HZ_CORE_ASSERT(id != InvalidNameID && id < m_Entities.size());
+
+		auto& entities = m_Entities[id];
+		auto it = std::find(entities.begin(), entities.end(), entity);
+		if (it != entities.end())
+			entities.erase(it);
+	}
+
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "entt.hpp"
+
+#include <map>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace Hazel {
+
+	using NameID = uint32_t;
+
+	// Maps entity names to the entities carrying them. Names are interned, an ID stays valid
+	// for the lifetime of the index even when no entity uses the name anymore.
+	class EntityNameIndex
+	{
+	public:
+		static constexpr NameID InvalidNameID = 0;
+	public:
+		EntityNameIndex();
+
+		NameID Intern(std::string_view name);
+		// InvalidNameID for names that were never interned
+		NameID GetNameID(std::string_view name) const;
+		const std::string& GetName(NameID id) const { return m_Names[id]; }
+
+		void Add(NameID id, entt::entity entity);
+		void Remove(NameID id, entt::entity entity);
+
+		// In the order the entities were added
+		const std::vector<entt::entity>& GetEntities(NameID id) const { return m_Entities[id]; }
+
+		// Calls func(NameID) for every interned name starting with prefix, in lexicographical order
+		template<typename Func>
+		void ForEachNameWithPrefix(std::string_view prefix, Func func) const
+		{
+			for (auto it = m_SortedNames.lower_bound(prefix); it != m_SortedNames.end(); ++it)
+			{
+				if (it->first.compare(0, prefix.size(), prefix) != 0)
+					break;
+
+				func(it->second);
+			}
+		}
+	private:
+		std::vector<std::string> m_Names;
+		std::vector<std::vector<entt::entity>> m_Entities;
+
+		// Keyed by hash so lookups by string_view don't need to allocate
+		std::unordered_multimap<size_t, NameID> m_Lookup;
+		std::map<std::string, NameID, std::less<>> m_SortedNames;
+	};
+
+}
@@ -0,0 +1,80 @@
+#include "hzpch.h"
+#include "XingXing/Scene/Prefab.h"
+
+#include "XingXing/Scene/SceneSerializer.h"
+
+#include <fstream>
+
+#include <yaml-cpp/yaml.h>
+
+namespace Hazel {
+
+	Prefab::Prefab()
+		: m_Scene(CreateRef<Scene>())
+	{
+	}
+
+	Ref<Prefab> Prefab::Create(Entity entity)
+	{
+		Ref<Prefab> prefab = CreateRef<Prefab>();
+
+		UUID id;
+		entt::entity handle;
+		prefab->m_Scene->CloneEntities(entity, &id, &handle, 1);
+		prefab->m_Entity = { handle, prefab->m_Scene.get() };
+		return prefab;
+	}
+
+	Ref<Prefab> Prefab::Load(const std::filesystem::path& filepath)
+	{
+		YAML::Node data;
+		try
+		{
+			data = YAML::LoadFile(filepath.string());
+		}
+		catch (YAML::ParserException e)
+		{
+			HZ_CORE_ERROR("Failed to load prefab file '{0}'\n     {1}", filepath.string(), e.what());
+			return nullptr;
+		}
+
+		auto entities = data["Entities"];
+		if (!data["Prefab"] || !entities || entities.size() != 1)
+		{
+			HZ_CORE_ERROR("'{0}' is not a prefab file", filepath.string());
+			return nullptr;
+		}
+
+		auto entity = entities[0];
+		uint64_t uuid = entity["Entity"].as<uint64_t>();
+
+		std::string name;
+		auto tagComponent = entity["TagComponent"];
+		if (tagComponent)
+			name = tagComponent["Tag"].as<std::string>();
+
+		Ref<Prefab> prefab = CreateRef<Prefab>();
+		prefab->m_Entity = prefab->m_Scene->CreateEntityWithUUID(uuid, name);
+		SceneSerializer::DeserializeEntity(entity, prefab->m_Entity);
+		return prefab;
+	}
+
+	bool Prefab::Save(const std::filesystem::path& filepath)
+	{
+		YAML::Emitter out;
+		out << YAML::BeginMap;
+		out << YAML::Key << "Prefab" << YAML::Value << m_Entity.GetName();
+		out << YAML::Key << "Entities" << YAML::Value << YAML::BeginSeq;
+		SceneSerializer::SerializeEntity(out, m_Entity);
+		out << YAML::EndSeq;
+		out << YAML::EndMap;
+
+		std::ofstream fout(filepath);
+		if (!fout)
+			return false;
+
+		fout << out.c_str();
+		return true;
+	}
+
+}
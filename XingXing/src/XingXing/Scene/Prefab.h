@@ -0,0 +1,31 @@
+#pragma once
+
+#include "XingXing/Core/Base.h"
+#include "XingXing/Scene/Entity.h"
+
+#include <filesystem>
+
+namespace Hazel {
+
+	// An entity template. Prefab files (.hprefab) use the scene entity format and are parsed once
+	// when loaded; the template entity lives in a scene of its own, so instantiating copies
+	// already-parsed components instead of going through the serializer.
+	class Prefab
+	{
+	public:
+		Prefab();
+
+		// Captures the current components of entity, later changes to it don't affect the prefab
+		static Ref<Prefab> Create(Entity entity);
+		static Ref<Prefab> Load(const std::filesystem::path& filepath);
+		bool Save(const std::filesystem::path& filepath);
+
+		// The UUID of the template entity, identifies the prefab at runtime
+		UUID GetID() { return m_Entity.GetUUID(); }
+		Entity GetEntity() const { return m_Entity; }
+	private:
+		Ref<Scene> m_Scene;
+		Entity m_Entity;
+	};
+
+}
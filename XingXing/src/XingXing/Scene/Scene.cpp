@@ -3,10 +3,15 @@
 #include "Entity.h"
 
 #include "Components.h"
+#include "EntityCommandBuffer.h"
+#include "Prefab.h"
 #include "ScriptableEntity.h"
 #include "XingXing/Scripting/ScriptEngine.h"
 #include "XingXing/Renderer/Renderer2D.h"
 #include "XingXing/Physics/Physics2D.h"
+#include "XingXing/Math/Math.h"
+#include "XingXing/Core/FrameAllocator.h"
+#include "XingXing/Core/JobSystem.h"
 
 #include <glm/glm.hpp>
 
@@ -21,353 +26,1432 @@
 
 namespace Hazel {
 
+	// Components that give an entity bounds in the spatial index
+	using BoundsComponents = ComponentGroup<SpriteRendererComponent, CircleRendererComponent, BoxCollider2DComponent, CircleCollider2DComponent>;
+
+	static void MarkBoundsChanged(std::vector<entt::entity>& changed, entt::registry&, entt::entity entity)
+	{
+		changed.push_back(entity);
+	}
+
+	template<typename... Component>
+	static void ConnectBoundsSignals(ComponentGroup<Component...>, entt::registry& registry, std::vector<entt::entity>& changed)
+	{
+		(registry.on_construct<Component>().template connect<&MarkBoundsChanged>(changed), ...);
+		(registry.on_destroy<Component>().template connect<&MarkBoundsChanged>(changed), ...);
+	}
+
+	// Every live scene, so assets are only released once none of them uses them
+	static std::mutex s_SceneListMutex;
+	static std::vector<Scene*> s_Scenes;
+
 	Scene::Scene()
+		: Scene(true)
+	{
+	}
+
+	Scene::Scene(bool tracked)
+		: m_Tracked(tracked)
+	{
+		if (m_Tracked)
+		{
+			std::scoped_lock<std::mutex> lock(s_SceneListMutex);
+			s_Scenes.push_back(this);
+		}
+
+		m_CommandBuffer = CreateScope<EntityCommandBuffer>();
+
+		// Moves are picked up from the transform sweep, these catch bounds appearing and disappearing
+		ConnectBoundsSignals(BoundsComponents{}, m_Registry, m_BoundsChanged);
+	}
+
+	Scene::~Scene()
+	{
+		delete m_PhysicsWorld;
+
+		if (!m_Tracked)
+			return;
+
+		{
+			std::scoped_lock<std::mutex> lock(s_SceneListMutex);
+			s_Scenes.erase(std::find(s_Scenes.begin(), s_Scenes.end(), this));
+		}
+
+		// Scenes dropped elsewhere leave their assets to the next release on the main thread
+		if (JobSystem::IsMainThread())
+			ReleaseUnusedAssets();
+	}
+
+	void Scene::ReleaseUnusedAssets()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		std::vector<bool> usedTextures(AssetTable<Texture2D>::GetCapacity());
+		std::vector<bool> usedSubTextures(AssetTable<SubTexture2D>::GetCapacity());
+		std::vector<bool> usedFonts(AssetTable<Font>::GetCapacity());
+		{
+			std::scoped_lock<std::mutex> lock(s_SceneListMutex);
+			for (Scene* scene : s_Scenes)
+			{
+				auto sprites = scene->m_Registry.view<SpriteRendererComponent>();
+				const SpriteRendererComponent* spriteData = sprites.raw();
+				for (size_t i = 0; i < sprites.size(); i++)
+				{
+					usedTextures[spriteData[i].Texture.GetIndex()] = true;
+					usedSubTextures[spriteData[i].SubTexture.GetIndex()] = true;
+				}
+
+				auto texts = scene->m_Registry.view<TextComponent>();
+				const TextComponent* textData = texts.raw();
+				for (size_t i = 0; i < texts.size(); i++)
+					usedFonts[textData[i].FontAsset.GetIndex()] = true;
+			}
+		}
+
+		// Sub-textures hold their atlas texture, so they go first
+		AssetTable<SubTexture2D>::Collect(usedSubTextures);
+		AssetTable<Texture2D>::Collect(usedTextures);
+		AssetTable<Font>::Collect(usedFonts);
+	}
+
+	// Bulk copies whole pools. Both registries hold the same entity identifiers, so the packed arrays
+	// can be inserted as ranges; for trivially copyable components this boils down to a memcpy.
+	template<typename... Component>
+	static void CopyComponent(entt::registry& dst, entt::registry& src)
+	{
+		([&]()
+		{
+			auto view = src.view<Component>();
+			dst.reserve<Component>(view.size());
+			dst.insert<Component>(view.data(), view.data() + view.size(), view.raw(), view.raw() + view.size());
+		}(), ...);
+	}
+
+	template<typename... Component>
+	static void CopyComponent(ComponentGroup<Component...>, entt::registry& dst, entt::registry& src)
+	{
+		CopyComponent<Component...>(dst, src);
+	}
+
+	// Copies the source components to every entity in the range with a single insert per type
+	template<typename... Component>
+	static void CloneComponents(entt::registry& dst, Entity src, const entt::entity* first, const entt::entity* last)
+	{
+		([&]()
+		{
+			if (!src.HasComponent<Component>())
+				return;
+
+			// Copy first, the source may live in the pool being inserted into
+			Component component = src.GetComponent<Component>();
+			dst.insert<Component>(first, last, component);
+		}(), ...);
+	}
+
+	template<typename... Component>
+	static void CloneComponents(ComponentGroup<Component...>, entt::registry& dst, Entity src, const entt::entity* first, const entt::entity* last)
+	{
+		CloneComponents<Component...>(dst, src, first, last);
+	}
+
+	Ref<Scene> Scene::Copy(Ref<Scene> other)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		Ref<Scene> newScene = CreateRef<Scene>();
+
+		newScene->m_ViewportWidth = other->m_ViewportWidth;
+		newScene->m_ViewportHeight = other->m_ViewportHeight;
+		newScene->m_WorldSpecification = other->m_WorldSpecification;
+		newScene->m_FixedTimestep = other->m_FixedTimestep;
+		newScene->m_MaxSubsteps = other->m_MaxSubsteps;
+		newScene->m_ScriptUpdateLODs = other->m_ScriptUpdateLODs;
+		newScene->m_RewindEnabled = other->m_RewindEnabled;
+		newScene->m_RewindSpecification = other->m_RewindSpecification;
+		newScene->m_NativeSystems = other->m_NativeSystems;
+
+		auto& srcSceneRegistry = other->m_Registry;
+		auto& dstSceneRegistry = newScene->m_Registry;
+
+		// Take over the entity identifiers as they are, including the free list
+		dstSceneRegistry.assign(srcSceneRegistry.data(), srcSceneRegistry.data() + srcSceneRegistry.size());
+
+		// World transforms are copied in pool order, so the hierarchy stays sorted
+		CopyComponent<IDComponent, TagComponent, RelationshipComponent, WorldTransformComponent>(dstSceneRegistry, srcSceneRegistry);
+		CopyComponent(AllComponents{}, dstSceneRegistry, srcSceneRegistry);
+
+		// Tags have no storage to copy, only the entities
+		auto disabled = srcSceneRegistry.view<DisabledComponent>();
+		dstSceneRegistry.insert<DisabledComponent>(disabled.data(), disabled.data() + disabled.size());
+
+		// Identifiers are unchanged, so the UUID and name lookups carry over
+		newScene->m_EntityMap = other->m_EntityMap;
+		newScene->m_NameIndex = other->m_NameIndex;
+
+		return newScene;
+	}
+
+	Entity Scene::CreateEntity(const std::string& name)
+	{
+		return CreateEntityWithUUID(UUID(), name);
+	}
+
+	Entity Scene::CreateEntityWithUUID(UUID uuid, const std::string& name)
+	{
+		Entity entity = { m_Registry.create(), this };
+		entity.AddComponent<IDComponent>(uuid);
+		entity.AddComponent<TransformComponent>();
+		entity.AddComponent<RelationshipComponent>();
+		entity.AddComponent<WorldTransformComponent>();
+		auto& tag = entity.AddComponent<TagComponent>();
+		tag.Tag = name.empty() ? "Entity" : name;
+
+		m_EntityMap[uuid] = entity;
+		m_NameIndex.Add(m_NameIndex.Intern(tag.Tag), entity);
+
+		return entity;
+	}
+
+	void Scene::DestroyEntity(Entity entity)
+	{
+		// Children go with their parent. Copied, destroying them edits the list.
+		ScratchScope scratch;
+		const auto& relationship = entity.GetComponent<RelationshipComponent>();
+		std::pmr::vector<UUID> children(relationship.Children.begin(), relationship.Children.end(), ScratchAllocator::GetMemoryResource());
+		for (UUID childID : children)
+		{
+			if (Entity child = GetEntityByUUID(childID))
+				DestroyEntity(child);
+		}
+
+		ReleaseEntityResources(entity);
+		m_Registry.destroy(entity);
+	}
+
+	void Scene::InitializeRuntimeEntity(Entity entity)
+	{
+		if (m_PhysicsWorld && entity.HasComponent<Rigidbody2DComponent>())
+			CreatePhysicsBody(entity);
+
+		if (m_IsRunning && entity.HasComponent<ScriptComponent>())
+			ScriptEngine::OnCreateEntity(entity);
+
+		if (m_IsRunning && entity.HasComponent<NativeScriptComponent>())
+			CreateNativeScript(entity);
+	}
+
+	void Scene::CreateNativeScript(entt::entity entity)
+	{
+		auto& nsc = m_Registry.get<NativeScriptComponent>(entity);
+		if (nsc.Instance)
+			return;
+
+		HZ_CORE_ASSERT(nsc.InstantiateScript, "NativeScriptComponent has no script bound!");
+		nsc.Instance = nsc.InstantiateScript();
+		nsc.Instance->m_Entity = Entity{ entity, this };
+		nsc.Instance->OnCreate();
+	}
+
+	void Scene::CreatePendingNativeScripts()
+	{
+		// Swapped out, OnCreate may add more
+		std::vector<entt::entity> pending;
+		pending.swap(m_PendingNativeScripts);
+		for (entt::entity entity : pending)
+		{
+			if (m_Registry.valid(entity) && m_Registry.has<NativeScriptComponent>(entity))
+				CreateNativeScript(entity);
+		}
+	}
+
+	void Scene::ReleaseEntityResources(Entity entity)
+	{
+		if (entity.HasComponent<ScriptComponent>())
+			DestroyScriptInstance(entity);
+
+		if (entity.HasComponent<NativeScriptComponent>())
+			DestroyNativeScript(entity);
+
+		DestroyPhysicsBody(entity);
+
+		if (Entity parent = GetParent(entity))
+		{
+			auto& siblings = parent.GetComponent<RelationshipComponent>().Children;
+			siblings.erase(std::remove(siblings.begin(), siblings.end(), entity.GetUUID()), siblings.end());
+		}
+
+		// Right away, so queries before the next update don't return it
+		m_SpatialIndex.Remove(entity);
+
+		if (NameID nameID = m_NameIndex.GetNameID(entity.GetName()); nameID != EntityNameIndex::InvalidNameID)
+			m_NameIndex.Remove(nameID, entity);
+
+		m_EntityMap.erase(entity.GetUUID());
+	}
+
+	void Scene::DestroyPhysicsBody(Entity entity)
+	{
+		if (!m_PhysicsWorld || !entity.HasComponent<Rigidbody2DComponent>())
+			return;
+
+		auto& rb2d = entity.GetComponent<Rigidbody2DComponent>();
+		if (rb2d.RuntimeBody)
+		{
+			m_PhysicsWorld->DestroyBody((b2Body*)rb2d.RuntimeBody);
+			rb2d.RuntimeBody = nullptr;
+			entity.GetComponent<WorldTransformComponent>().Interpolated = false;
+		}
+	}
+
+	void Scene::RecreatePhysicsBody(Entity entity)
+	{
+		if (!m_PhysicsWorld || !entity.HasComponent<Rigidbody2DComponent>())
+			return;
+
+		b2Vec2 linearVelocity(0.0f, 0.0f);
+		float angularVelocity = 0.0f;
+		if (b2Body* body = (b2Body*)entity.GetComponent<Rigidbody2DComponent>().RuntimeBody)
+		{
+			linearVelocity = body->GetLinearVelocity();
+			angularVelocity = body->GetAngularVelocity();
+		}
+
+		DestroyPhysicsBody(entity);
+		CreatePhysicsBody(entity);
+
+		b2Body* body = (b2Body*)entity.GetComponent<Rigidbody2DComponent>().RuntimeBody;
+		body->SetLinearVelocity(linearVelocity);
+		body->SetAngularVelocity(angularVelocity);
+	}
+
+	void Scene::CreateScriptInstance(Entity entity)
+	{
+		if (m_IsRunning)
+			ScriptEngine::OnCreateEntity(entity);
+	}
+
+	void Scene::DestroyScriptInstance(Entity entity)
+	{
+		if (m_IsRunning)
+			ScriptEngine::OnDestroyEntity(entity);
+	}
+
+	void Scene::DestroyNativeScript(Entity entity)
+	{
+		auto& nsc = entity.GetComponent<NativeScriptComponent>();
+		if (m_IsRunning && nsc.Instance)
+		{
+			nsc.Instance->OnDestroy();
+			nsc.DestroyScript(&nsc);
+		}
+	}
+
+	void Scene::OnRuntimeStart()
+	{
+		m_IsRunning = true;
+
+		OnPhysics2DStart();
+
+		// Scripting
+		{
+			ScriptEngine::OnRuntimeStart(this);
+			// Instantiate all script entities
+
+			auto view = m_Registry.view<ScriptComponent>();
+			for (auto e : view)
+			{
+				Entity entity = { e, this };
+				ScriptEngine::OnCreateEntity(entity);
+			}
+
+			// Up front, so the per-frame update doesn't have to check for missing instances.
+			// Copied, OnCreate may add entities with native scripts.
+			ScratchScope scratch;
+			auto nativeScripts = m_Registry.view<NativeScriptComponent>();
+			std::pmr::vector<entt::entity> entities(nativeScripts.begin(), nativeScripts.end(), ScratchAllocator::GetMemoryResource());
+			for (entt::entity e : entities)
+				CreateNativeScript(e);
+		}
+
+		if (!m_WorldSpecification.WorldPath.empty())
+			m_WorldPartition = WorldPartition::Create(this, m_WorldSpecification);
+
+		if (m_RewindEnabled)
+			m_RewindBuffer = CreateScope<RewindBuffer>(m_RewindSpecification);
+
+		m_FixedTimeAccumulator = 0.0f;
+		m_InterpolationAlpha = 1.0f;
+		RegisterSystems(true);
+	}
+
+	void Scene::OnRuntimeStop()
+	{
+		m_IsRunning = false;
+
+		m_Systems.Clear();
+		m_CommandBuffer->Clear();
+		m_WorldPartition.reset();
+		m_RewindBuffer.reset();
+
+		m_Registry.view<NativeScriptComponent>().each([](auto entity, auto& nsc)
+		{
+			if (nsc.Instance)
+			{
+				nsc.Instance->OnDestroy();
+				nsc.DestroyScript(&nsc);
+			}
+		});
+		m_PendingNativeScripts.clear();
+		m_SystemsDirty = false;
+
+		OnPhysics2DStop();
+
+		ScriptEngine::OnRuntimeStop();
+	}
+
+	void Scene::OnSimulationStart()
+	{
+		OnPhysics2DStart();
+
+		m_FixedTimeAccumulator = 0.0f;
+		m_InterpolationAlpha = 1.0f;
+		RegisterSystems(false);
+	}
+
+	void Scene::OnSimulationStop()
+	{
+		m_Systems.Clear();
+		m_CommandBuffer->Clear();
+
+		OnPhysics2DStop();
+	}
+
+	void Scene::OnUpdateRuntime(Timestep ts)
+	{
+		m_SimulateFrame = !m_IsPaused || m_StepFrames-- > 0;
+
+		m_Systems.Execute(m_Registry, ts);
+
+		// Commands recorded by the systems that ran after the last sync point
+		m_CommandBuffer->Playback(*this);
+
+		// Native systems added or removed during the frame, m_Systems can't change while it executes
+		if (m_SystemsDirty && m_IsRunning)
+		{
+			RegisterSystems(true);
+			m_SystemsDirty = false;
+		}
+	}
+
+	void Scene::OnUpdateSimulation(Timestep ts, EditorCamera& camera)
+	{
+		m_SimulateFrame = !m_IsPaused || m_StepFrames-- > 0;
+
+		m_Systems.Execute(m_Registry, ts);
+		m_CommandBuffer->Playback(*this);
+
+		// Render
+		RenderScene(camera);
+	}
+
+	void Scene::AddNativeSystem(const std::string& name, const SystemAccess& access, const NativeSystemFunction& function)
+	{
+		m_NativeSystems.push_back({ name, access, function });
+
+		// Rebuilt at the end of the frame, this may be called from a running system or script
+		if (m_IsRunning)
+			m_SystemsDirty = true;
+	}
+
+	void Scene::RemoveNativeSystem(const std::string& name)
+	{
+		auto it = std::find_if(m_NativeSystems.begin(), m_NativeSystems.end(), [&](const NativeSystem& system) { return system.Name == name; });
+		if (it == m_NativeSystems.end())
+			return;
+
+		m_NativeSystems.erase(it);
+
+		if (m_IsRunning)
+			m_SystemsDirty = true;
+	}
+
+	void Scene::SetRewindEnabled(bool enabled, const RewindBufferSpecification& specification)
+	{
+		m_RewindEnabled = enabled;
+		m_RewindSpecification = specification;
+
+		if (!enabled)
+			m_RewindBuffer.reset();
+		else if (m_IsRunning && !m_RewindBuffer)
+			m_RewindBuffer = CreateScope<RewindBuffer>(m_RewindSpecification);
+	}
+
+	void Scene::SetScriptUpdateLOD(const std::string& className, const UpdateLODSettings& settings)
+	{
+		HZ_CORE_ASSERT(settings.ReducedInterval > 0);
+		m_ScriptUpdateLODs[className] = settings;
+	}
+
+	void Scene::RemoveScriptUpdateLOD(const std::string& className)
+	{
+		m_ScriptUpdateLODs.erase(className);
+	}
+
+	void Scene::UpdateScriptLOD(Timestep ts)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		m_FrameIndex++;
+		m_UpdateLODStatistics = {};
+
+		// Last frame's camera, this frame's hasn't been found yet
+		const bool hasCamera = m_RuntimeCamera != nullptr;
+		const glm::vec3 cameraPosition = m_RuntimeCameraTransform[3];
+
+		auto resolveSettings = [this](entt::entity entity) -> const UpdateLODSettings*
+		{
+			if (auto* lod = m_Registry.try_get<UpdateLODComponent>(entity))
+				return &lod->Settings;
+
+			if (auto* script = m_Registry.try_get<ScriptComponent>(entity))
+			{
+				auto it = m_ScriptUpdateLODs.find(script->ClassName);
+				if (it != m_ScriptUpdateLODs.end())
+					return &it->second;
+			}
+
+			return nullptr;
+		};
+
+		auto updateEntity = [&](entt::entity entity)
+		{
+			const UpdateLODSettings* settings = hasCamera ? resolveSettings(entity) : nullptr;
+			auto* state = m_Registry.try_get<UpdateLODStateComponent>(entity);
+			if (!settings && !state)
+			{
+				m_UpdateLODStatistics.Full++;
+				return;
+			}
+
+			UpdateLODTier tier = UpdateLODTier::Full;
+			if (settings)
+			{
+				glm::vec3 position = m_Registry.get<WorldTransformComponent>(entity).Transform[3];
+				float distance = glm::distance(position, cameraPosition);
+
+				if (distance > settings->SuspendDistance)
+					tier = UpdateLODTier::Suspended;
+				else if (distance > settings->ReducedDistance)
+					tier = UpdateLODTier::Reduced;
+
+				if (tier == UpdateLODTier::Full && settings->ReduceOffscreen)
+				{
+					// A little margin, the position is only the entity's origin
+					glm::vec4 clip = m_RuntimeCameraViewProjection * glm::vec4(position, 1.0f);
+					const float margin = 1.1f;
+					if (clip.w <= 0.0f || glm::abs(clip.x) > clip.w * margin || glm::abs(clip.y) > clip.w * margin)
+						tier = UpdateLODTier::Reduced;
+				}
+
+				if (!state)
+					state = &m_Registry.emplace<UpdateLODStateComponent>(entity);
+
+				state->Interval = glm::max(settings->ReducedInterval, 1u);
+			}
+
+			// Dynamic bodies are woken up when they leave the suspended tier, whatever the settings are now
+			if (tier != state->Tier && (tier == UpdateLODTier::Suspended || state->Tier == UpdateLODTier::Suspended))
+			{
+				auto* rb2d = m_Registry.try_get<Rigidbody2DComponent>(entity);
+				if (rb2d && rb2d->RuntimeBody && (tier != UpdateLODTier::Suspended || settings->SleepSuspendedBodies))
+					((b2Body*)rb2d->RuntimeBody)->SetAwake(tier != UpdateLODTier::Suspended);
+			}
+			state->Tier = tier;
+
+			state->AccumulatedTime += ts;
+			switch (tier)
+			{
+				case UpdateLODTier::Full:
+				{
+					state->Update = true;
+					m_UpdateLODStatistics.Full++;
+					break;
+				}
+				case UpdateLODTier::Reduced:
+				{
+					// Spread by entity id, so 1 / Interval of the entities update each frame
+					uint32_t slot = (uint32_t)entt::to_integral(entity) & entt::entt_traits<std::underlying_type_t<entt::entity>>::entity_mask;
+					state->Update = (m_FrameIndex + slot) % state->Interval == 0;
+					m_UpdateLODStatistics.Reduced++;
+					break;
+				}
+				case UpdateLODTier::Suspended:
+				{
+					// Resuming entities don't catch up on the time they were suspended
+					state->AccumulatedTime = 0.0f;
+					state->Update = false;
+					m_UpdateLODStatistics.Suspended++;
+					break;
+				}
+			}
+
+			if (state->Update)
+			{
+				state->Timestep = state->AccumulatedTime;
+				state->AccumulatedTime = 0.0f;
+			}
+		};
+
+		// Emplacing the state doesn't touch the pools being iterated
+		for (auto entity : m_Registry.view<ScriptComponent>(entt::exclude<DisabledComponent>))
+			updateEntity(entity);
+		for (auto entity : m_Registry.view<NativeScriptComponent>(entt::exclude<DisabledComponent, ScriptComponent>))
+			updateEntity(entity);
+	}
+
+	bool Scene::ShouldUpdateScripts(entt::entity entity, Timestep frameTimestep, Timestep& timestep)
+	{
+		auto* state = m_Registry.try_get<UpdateLODStateComponent>(entity);
+		if (!state)
+		{
+			timestep = frameTimestep;
+			return true;
+		}
+
+		timestep = state->Timestep;
+		return state->Update;
+	}
+
+	void Scene::FixedUpdate()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		Timestep ts = m_FixedTimestep;
+
+		if (m_IsRunning)
+		{
+			auto isSuspended = [this](entt::entity entity)
+			{
+				auto* lod = m_Registry.try_get<UpdateLODStateComponent>(entity);
+				return lod && lod->Tier == UpdateLODTier::Suspended;
+			};
+
+			auto view = m_Registry.view<ScriptComponent>(entt::exclude<DisabledComponent>);
+			for (auto e : view)
+			{
+				if (!isSuspended(e))
+					ScriptEngine::OnFixedUpdateEntity({ e, this }, ts);
+			}
+
+			// Components added after the last script update have no instance yet
+			m_Registry.view<NativeScriptComponent>(entt::exclude<DisabledComponent>).each([&](auto entity, auto& nsc)
+			{
+				if (nsc.Instance && !isSuspended(entity))
+					nsc.Instance->OnFixedUpdate(ts);
+			});
+		}
+
+		// Remember where the bodies were, so rendering can interpolate towards the new state.
+		// Components added while running only get a body through InitializeRuntimeEntity or the command buffer.
+		ParallelEach<Rigidbody2DComponent>(m_Registry, 256, [](entt::entity e, Rigidbody2DComponent& rb2d)
+		{
+			b2Body* body = (b2Body*)rb2d.RuntimeBody;
+			if (!body)
+				return;
+
+			rb2d.PreviousPosition = { body->GetPosition().x, body->GetPosition().y };
+			rb2d.PreviousAngle = body->GetAngle();
+		}, entt::exclude<DisabledComponent>);
+
+		const int32_t velocityIterations = 6;
+		const int32_t positionIterations = 2;
+		m_PhysicsWorld->Step(ts, velocityIterations, positionIterations);
+	}
+
+	void Scene::RegisterSystems(bool runtime)
+	{
+		m_Systems.Clear();
+
+		if (runtime)
+		{
+			m_Systems.AddSystem("Update LOD", SystemAccess().Exclusive().MainThread(), [this](Timestep ts)
+			{
+				if (!m_SimulateFrame)
+					return;
+
+				UpdateScriptLOD(ts);
+			});
+
+			m_Systems.AddSystem("C# Scripts", SystemAccess().Exclusive().MainThread(), [this](Timestep ts)
+			{
+				if (!m_SimulateFrame)
+					return;
+
+				// C# Entity OnUpdate
+				auto view = m_Registry.view<ScriptComponent>(entt::exclude<DisabledComponent>);
+				for (auto e : view)
+				{
+					Timestep timestep;
+					if (!ShouldUpdateScripts(e, ts, timestep))
+						continue;
+
+					Entity entity = { e, this };
+					ScriptEngine::OnUpdateEntity(entity, timestep);
+				}
+			});
+
+			m_Systems.AddSystem("Native Scripts", SystemAccess().Exclusive().MainThread(), [this](Timestep ts)
+			{
+				if (!m_SimulateFrame)
+					return;
+
+				// Instances exist from OnRuntimeStart or InitializeRuntimeEntity, only components added since need one
+				CreatePendingNativeScripts();
+
+				m_Registry.view<NativeScriptComponent>(entt::exclude<DisabledComponent>).each([=](auto entity, auto& nsc)
+					{
+						Timestep timestep;
+						if (nsc.Instance && ShouldUpdateScripts(entity, ts, timestep))
+							nsc.Instance->OnUpdate(timestep);
+					});
+			});
+
+			for (const NativeSystem& system : m_NativeSystems)
+			{
+				m_Systems.AddSystem(system.Name, system.Access, [this, function = system.Function](Timestep ts)
+				{
+					if (!m_SimulateFrame)
+						return;
+
+					function(*this, ts);
+				});
+			}
+
+			// Sync point: entities spawned by scripts exist before physics and rendering see the frame
+			m_Systems.AddSystem("Entity Commands", SystemAccess().Exclusive().MainThread(), [this](Timestep ts)
+			{
+				m_CommandBuffer->Playback(*this);
+				// Scripts added by the commands, so "Fixed Update" sees their instances
+				CreatePendingNativeScripts();
+			});
+
+			// Streams around last frame's camera, so new entities get their world transforms before they are rendered
+			m_Systems.AddSystem("World Streaming", SystemAccess().Exclusive().MainThread(), [this](Timestep ts)
+			{
+				if (m_WorldPartition && m_RuntimeCamera)
+					m_WorldPartition->Update(glm::vec3(m_RuntimeCameraTransform[3]));
+			});
+		}
+
+		// Scripts' OnFixedUpdate and the physics step, at the fixed rate
+		m_Systems.AddSystem("Fixed Update", SystemAccess().Exclusive().MainThread(), [this](Timestep ts)
+		{
+			if (!m_SimulateFrame)
+				return;
+
+			// Stepping a paused scene advances exactly one tick
+			if (m_IsPaused)
+			{
+				FixedUpdate();
+				m_FixedTimeAccumulator = 0.0f;
+				m_InterpolationAlpha = 1.0f;
+				return;
+			}
+
+			m_FixedTimeAccumulator += ts;
+
+			uint32_t steps = 0;
+			while (m_FixedTimeAccumulator >= m_FixedTimestep && steps < m_MaxSubsteps)
+			{
+				FixedUpdate();
+				m_FixedTimeAccumulator -= m_FixedTimestep;
+				steps++;
+			}
+
+			// Drop what couldn't be simulated, catching up would only make the next frame slower still
+			if (m_FixedTimeAccumulator >= m_FixedTimestep)
+				m_FixedTimeAccumulator = std::fmod(m_FixedTimeAccumulator, m_FixedTimestep);
+
+			m_InterpolationAlpha = m_FixedTimeAccumulator / m_FixedTimestep;
+		});
+
+		m_Systems.AddSystem("Physics 2D Write-back", SystemAccess().ReadResource("Physics2D").Read<Rigidbody2DComponent>().Write<TransformComponent>(), [this](Timestep ts)
+		{
+			if (!m_SimulateFrame)
+				return;
+
+			// Retrieve transform from Box2D. Scripts and physics see the body's pose, the transform sweep
+			// interpolates the render transform from the previous one.
+			ParallelEach<Rigidbody2DComponent, TransformComponent>(m_Registry, 256, [](entt::entity e, Rigidbody2DComponent& rb2d, TransformComponent& transform)
+			{
+				b2Body* body = (b2Body*)rb2d.RuntimeBody;
+				if (!body)
+					return;
+
+				const auto& position = body->GetPosition();
+				transform.Translation.x = position.x;
+				transform.Translation.y = position.y;
+				transform.Rotation.z = body->GetAngle();
+			}, entt::exclude<DisabledComponent>);
+		});
+
+		m_Systems.AddSystem("Transform Hierarchy", SystemAccess().Read<TransformComponent, Rigidbody2DComponent>().Write<WorldTransformComponent>(), [this](Timestep ts)
+		{
+			UpdateWorldTransforms();
+		});
+
+		SystemAccess spatialIndexAccess;
+		spatialIndexAccess.Read<WorldTransformComponent, SpriteRendererComponent, CircleRendererComponent, BoxCollider2DComponent, CircleCollider2DComponent>()
+			.WriteResource("SpatialIndex");
+		m_Systems.AddSystem("Spatial Index", spatialIndexAccess, [this](Timestep ts)
+		{
+			UpdateSpatialIndex();
+		});
+
+		if (runtime)
+		{
+			// Captures the frame's final state, after scripts, physics and commands
+			m_Systems.AddSystem("Rewind Capture", SystemAccess().Exclusive().MainThread(), [this](Timestep ts)
+			{
+				if (m_SimulateFrame && m_RewindBuffer)
+					m_RewindBuffer->Capture(*this, ts);
+			});
+
+			m_Systems.AddSystem("Primary Camera", SystemAccess().Read<WorldTransformComponent, CameraComponent>().WriteResource("RuntimeCamera"), [this](Timestep ts)
+			{
+				m_RuntimeCamera = nullptr;
+
+				auto view = m_Registry.view<WorldTransformComponent, CameraComponent>(entt::exclude<DisabledComponent>);
+				for (auto entity : view)
+				{
+					auto [transform, camera] = view.get<WorldTransformComponent, CameraComponent>(entity);
+
+					if (camera.Primary)
+					{
+						m_RuntimeCamera = &camera.Camera;
+						// The drawn pose, so a camera attached to a physics body moves as smoothly as the body
+						m_RuntimeCameraTransform = transform.RenderTransform;
+						m_RuntimeCameraViewProjection = camera.Camera.GetProjection() * glm::inverse(transform.RenderTransform);
+						break;
+					}
+				}
+			});
+
+			SystemAccess renderAccess;
+			renderAccess.Read<WorldTransformComponent, SpriteRendererComponent, CircleRendererComponent, TextComponent>()
+				.ReadResource("RuntimeCamera").WriteResource("Renderer2D").MainThread();
+			m_Systems.AddSystem("Render 2D", renderAccess, [this](Timestep ts)
+			{
+				if (!m_RuntimeCamera || !m_RenderingEnabled)
+					return;
+
+				Renderer2D::BeginScene(*m_RuntimeCamera, m_RuntimeCameraTransform);
+
+				// Draw sprites
+				{
+					auto view = m_Registry.view<WorldTransformComponent, SpriteRendererComponent>(entt::exclude<DisabledComponent>);
+					for (auto entity : view)
+					{
+						auto [transform, sprite] = view.get<WorldTransformComponent, SpriteRendererComponent>(entity);
+
+						Renderer2D::DrawSprite(transform.RenderTransform, sprite, (int)entity);
+					}
+				}
+
+				// Draw circles
+				{
+					auto view = m_Registry.view<WorldTransformComponent, CircleRendererComponent>(entt::exclude<DisabledComponent>);
+					for (auto entity : view)
+					{
+						auto [transform, circle] = view.get<WorldTransformComponent, CircleRendererComponent>(entity);
+
+						Renderer2D::DrawCircle(transform.RenderTransform, circle.Color, circle.Thickness, circle.Fade, (int)entity);
+					}
+				}
+
+				// Draw text
+				{
+					auto view = m_Registry.view<WorldTransformComponent, TextComponent>(entt::exclude<DisabledComponent>);
+					for (auto entity : view)
+					{
+						auto [transform, text] = view.get<WorldTransformComponent, TextComponent>(entity);
+
+						Renderer2D::DrawString(text.TextString, transform.RenderTransform, text, (int)entity);
+					}
+				}
+
+				Renderer2D::EndScene();
+			});
+		}
+	}
+
+	void Scene::OnUpdateEditor(Timestep ts, EditorCamera& camera)
+	{
+		UpdateWorldTransforms();
+		UpdateSpatialIndex();
+
+		// Render
+		RenderScene(camera);
+	}
+
+	void Scene::OnViewportResize(uint32_t width, uint32_t height)
+	{
+		if (m_ViewportWidth == width && m_ViewportHeight == height)
+			return;
+
+		m_ViewportWidth = width;
+		m_ViewportHeight = height;
+
+		// Resize our non-FixedAspectRatio cameras
+		auto view = m_Registry.view<CameraComponent>();
+		for (auto entity : view)
+		{
+			auto& cameraComponent = view.get<CameraComponent>(entity);
+			if (!cameraComponent.FixedAspectRatio)
+				cameraComponent.Camera.SetViewportSize(width, height);
+		}
+	}
+
+	Entity Scene::GetPrimaryCameraEntity()
+	{
+		auto view = m_Registry.view<CameraComponent>(entt::exclude<DisabledComponent>);
+		for (auto entity : view)
+		{
+			const auto& camera = view.get<CameraComponent>(entity);
+			if (camera.Primary)
+				return Entity{entity, this};
+		}
+		return {};
+	}
+
+	void Scene::Step(int frames)
+	{
+		m_StepFrames = frames;
+	}
+
+	Entity Scene::DuplicateEntity(Entity entity)
+	{
+		return DuplicateSubtree(entity, GetParent(entity));
+	}
+
+	Entity Scene::DuplicateSubtree(Entity entity, Entity parent)
+	{
+		UUID id;
+		entt::entity handle;
+		CloneEntities(entity, &id, &handle, 1);
+
+		Entity newEntity = { handle, this };
+		if (parent)
+			SetParent(newEntity, parent);
+
+		// Copied, duplicating into the same parent extends the list
+		ScratchScope scratch;
+		const auto& relationship = entity.GetComponent<RelationshipComponent>();
+		std::pmr::vector<UUID> children(relationship.Children.begin(), relationship.Children.end(), ScratchAllocator::GetMemoryResource());
+		for (UUID childID : children)
+		{
+			if (Entity child = GetEntityByUUID(childID))
+				DuplicateSubtree(child, newEntity);
+		}
+
+		return newEntity;
+	}
+
+	void Scene::SetParent(Entity entity, Entity parent, bool keepWorldTransform)
+	{
+		if (parent && (parent == entity || IsDescendantOf(parent, entity)))
+		{
+			HZ_CORE_WARN("Can't parent '{0}' to '{1}', it would create a cycle", entity.GetName(), parent.GetName());
+			return;
+		}
+
+		auto& relationship = entity.GetComponent<RelationshipComponent>();
+		if (Entity oldParent = GetParent(entity))
+		{
+			auto& siblings = oldParent.GetComponent<RelationshipComponent>().Children;
+			siblings.erase(std::remove(siblings.begin(), siblings.end(), entity.GetUUID()), siblings.end());
+		}
+
+		auto& world = entity.GetComponent<WorldTransformComponent>();
+		if (keepWorldTransform)
+		{
+			glm::mat4 local = parent ? glm::inverse(parent.GetComponent<WorldTransformComponent>().Transform) * world.Transform : world.Transform;
+
+			auto& transform = entity.GetComponent<TransformComponent>();
+			Math::DecomposeTransform(local, transform.Translation, transform.Rotation, transform.Scale);
+		}
+
+		relationship.Parent = parent ? parent.GetUUID() : UUID(0);
+		if (parent)
+			parent.GetComponent<RelationshipComponent>().Children.push_back(entity.GetUUID());
+
+		world.Parent = parent ? (entt::entity)parent : entt::null;
+		world.Dirty = true;
+		UpdateHierarchyDepth(entity, parent ? parent.GetComponent<WorldTransformComponent>().Depth + 1 : 0);
+	}
+
+	void Scene::SetEntityActive(Entity entity, bool active)
+	{
+		if (IsEntityActive(entity) == active)
+			return;
+
+		if (active)
+			m_Registry.remove<DisabledComponent>(entity);
+		else
+			m_Registry.emplace<DisabledComponent>(entity);
+
+		// Bodies are switched off rather than destroyed, so they keep their velocities and contacts
+		if (m_PhysicsWorld && entity.HasComponent<Rigidbody2DComponent>())
+		{
+			b2Body* body = (b2Body*)entity.GetComponent<Rigidbody2DComponent>().RuntimeBody;
+			if (body)
+			{
+				// The transform may have been changed while the body was disabled
+				if (active)
+				{
+					auto& transform = entity.GetComponent<TransformComponent>();
+					body->SetTransform(b2Vec2(transform.Translation.x, transform.Translation.y), transform.Rotation.z);
+
+					auto& rb2d = entity.GetComponent<Rigidbody2DComponent>();
+					rb2d.PreviousPosition = { transform.Translation.x, transform.Translation.y };
+					rb2d.PreviousAngle = transform.Rotation.z;
+				}
+				body->SetEnabled(active);
+			}
+		}
+	}
+
+	bool Scene::IsEntityActive(Entity entity)
+	{
+		return !m_Registry.has<DisabledComponent>(entity);
+	}
+
+	Entity Scene::GetParent(Entity entity)
 	{
+		UUID parent = entity.GetComponent<RelationshipComponent>().Parent;
+		return parent != 0 ? GetEntityByUUID(parent) : Entity{};
 	}
 
-	Scene::~Scene()
+	bool Scene::IsDescendantOf(Entity entity, Entity ancestor)
 	{
-		delete m_PhysicsWorld;
+		for (Entity parent = GetParent(entity); parent; parent = GetParent(parent))
+		{
+			if (parent == ancestor)
+				return true;
+		}
+		return false;
 	}
 
-	template<typename... Component>
-	static void CopyComponent(entt::registry& dst, entt::registry& src, const std::unordered_map<UUID, entt::entity>& enttMap)
+	void Scene::UpdateHierarchyDepth(Entity entity, uint32_t depth)
 	{
-		([&]()
+		entity.GetComponent<WorldTransformComponent>().Depth = depth;
+		for (UUID childID : entity.GetComponent<RelationshipComponent>().Children)
 		{
-			auto view = src.view<Component>();
-			for (auto srcEntity : view)
+			if (Entity child = GetEntityByUUID(childID))
+				UpdateHierarchyDepth(child, depth + 1);
+		}
+	}
+
+	void Scene::RebuildHierarchy()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		auto view = m_Registry.view<RelationshipComponent, WorldTransformComponent>();
+		for (auto e : view)
+		{
+			auto [relationship, world] = view.get<RelationshipComponent, WorldTransformComponent>(e);
+
+			Entity parent = relationship.Parent != 0 ? GetEntityByUUID(relationship.Parent) : Entity{};
+			if (relationship.Parent != 0 && !parent)
 			{
-				entt::entity dstEntity = enttMap.at(src.get<IDComponent>(srcEntity).ID);
+				HZ_CORE_WARN("Parent {0} of entity {1} doesn't exist, detaching it", (uint64_t)relationship.Parent, (uint64_t)m_Registry.get<IDComponent>(e).ID);
+				relationship.Parent = 0;
+			}
 
-				auto& srcComponent = src.get<Component>(srcEntity);
-				dst.emplace_or_replace<Component>(dstEntity, srcComponent);
+			world.Parent = parent ? (entt::entity)parent : entt::null;
+			world.Dirty = true;
+		}
+
+		for (auto e : view)
+		{
+			if (view.get<RelationshipComponent>(e).Parent == 0)
+				UpdateHierarchyDepth({ e, this }, 0);
+		}
+	}
+
+	// Returns false when a child comes before its parent; the pool has to be sorted first then.
+	// Render transforms of physics bodies are interpolated by alpha between their last two physics states.
+	static bool PropagateWorldTransforms(entt::registry& registry, bool force, float alpha)
+	{
+		auto view = registry.view<WorldTransformComponent>();
+		WorldTransformComponent* worldTransforms = view.raw();
+		const entt::entity* entities = view.data();
+		const size_t count = view.size();
+
+		for (size_t i = 0; i < count; i++)
+		{
+			WorldTransformComponent& world = worldTransforms[i];
+			const TransformComponent& transform = registry.get<TransformComponent>(entities[i]);
+
+			const WorldTransformComponent* parent = nullptr;
+			if (world.Parent != entt::null)
+			{
+				parent = &registry.get<WorldTransformComponent>(world.Parent);
+				if (parent > &world)
+					return false;
 			}
-		}(), ...);
+
+			world.Updated = force || world.Dirty || (parent && parent->Updated)
+				|| transform.Translation != world.LocalTranslation
+				|| transform.Rotation != world.LocalRotation
+				|| transform.Scale != world.LocalScale;
+			world.RenderUpdated = world.Updated || world.Interpolated || (parent && parent->RenderUpdated);
+			if (!world.RenderUpdated)
+				continue;
+
+			const glm::mat4 local = transform.GetTransform();
+			if (world.Updated)
+			{
+				world.Dirty = false;
+				world.LocalTranslation = transform.Translation;
+				world.LocalRotation = transform.Rotation;
+				world.LocalScale = transform.Scale;
+				world.Transform = parent ? parent->Transform * local : local;
+			}
+
+			glm::mat4 renderLocal = local;
+			if (world.Interpolated)
+			{
+				const auto& rb2d = registry.get<Rigidbody2DComponent>(entities[i]);
+				TransformComponent interpolated = transform;
+				interpolated.Translation.x = glm::mix(rb2d.PreviousPosition.x, transform.Translation.x, alpha);
+				interpolated.Translation.y = glm::mix(rb2d.PreviousPosition.y, transform.Translation.y, alpha);
+				interpolated.Rotation.z = glm::mix(rb2d.PreviousAngle, transform.Rotation.z, alpha);
+				renderLocal = interpolated.GetTransform();
+			}
+			world.RenderTransform = parent ? parent->RenderTransform * renderLocal : renderLocal;
+		}
+
+		return true;
 	}
 
-	template<typename... Component>
-	static void CopyComponent(ComponentGroup<Component...>, entt::registry& dst, entt::registry& src, const std::unordered_map<UUID, entt::entity>& enttMap)
+	void Scene::UpdateWorldTransforms()
 	{
-		CopyComponent<Component...>(dst, src, enttMap);
+		HZ_PROFILE_FUNCTION();
+
+		if (!PropagateWorldTransforms(m_Registry, false, m_InterpolationAlpha))
+		{
+			// Reparenting and destroying entities can leave children in front of their parents
+			m_Registry.sort<WorldTransformComponent>([](const WorldTransformComponent& lhs, const WorldTransformComponent& rhs) { return lhs.Depth < rhs.Depth; });
+
+			[[maybe_unused]] bool sorted = PropagateWorldTransforms(m_Registry, true, m_InterpolationAlpha);
+			HZ_CORE_ASSERT(sorted);
+		}
 	}
 
 	template<typename... Component>
-	static void CopyComponentIfExists(Entity dst, Entity src)
+	static void ForEachBoundsEntity(ComponentGroup<Component...>, entt::registry& registry, const std::function<void(entt::entity)>& func)
 	{
 		([&]()
 		{
-			if (src.HasComponent<Component>())
-				dst.AddOrReplaceComponent<Component>(src.GetComponent<Component>());
+			for (auto entity : registry.view<Component>())
+				func(entity);
 		}(), ...);
 	}
 
-	template<typename... Component>
-	static void CopyComponentIfExists(ComponentGroup<Component...>, Entity dst, Entity src)
+	void Scene::UpdateSpatialIndex()
 	{
-		CopyComponentIfExists<Component...>(dst, src);
+		HZ_PROFILE_FUNCTION();
+
+		if (m_RebuildSpatialIndex)
+		{
+			m_SpatialIndex.Clear();
+			m_BoundsChanged.clear();
+			ForEachBoundsEntity(BoundsComponents{}, m_Registry, [this](entt::entity entity) { RefreshBounds(entity); });
+			m_RebuildSpatialIndex = false;
+			return;
+		}
+
+		for (entt::entity entity : m_BoundsChanged)
+			RefreshBounds(entity);
+		m_BoundsChanged.clear();
+
+		// Flagged by the transform sweep that ran before
+		auto view = m_Registry.view<WorldTransformComponent>();
+		const WorldTransformComponent* worldTransforms = view.raw();
+		const entt::entity* entities = view.data();
+		for (size_t i = 0; i < view.size(); i++)
+		{
+			if (worldTransforms[i].Updated && m_SpatialIndex.Contains(entities[i]))
+				RefreshBounds(entities[i]);
+		}
 	}
 
-	Ref<Scene> Scene::Copy(Ref<Scene> other)
+	void Scene::RefreshBounds(entt::entity entity)
 	{
-		Ref<Scene> newScene = CreateRef<Scene>();
+		if (!m_Registry.valid(entity))
+		{
+			m_SpatialIndex.Remove(entity);
+			return;
+		}
 
-		newScene->m_ViewportWidth = other->m_ViewportWidth;
-		newScene->m_ViewportHeight = other->m_ViewportHeight;
+		// Local space box of everything the entity draws or collides with
+		glm::vec2 min(std::numeric_limits<float>::max());
+		glm::vec2 max(std::numeric_limits<float>::lowest());
+		auto expand = [&](const glm::vec2& boxMin, const glm::vec2& boxMax)
+		{
+			min = glm::min(min, boxMin);
+			max = glm::max(max, boxMax);
+		};
+
+		if (m_Registry.has<SpriteRendererComponent>(entity) || m_Registry.has<CircleRendererComponent>(entity))
+			expand(glm::vec2(-0.5f), glm::vec2(0.5f));
+		if (auto* bc2d = m_Registry.try_get<BoxCollider2DComponent>(entity))
+			expand(bc2d->Offset - bc2d->Size, bc2d->Offset + bc2d->Size);
+		if (auto* cc2d = m_Registry.try_get<CircleCollider2DComponent>(entity))
+			expand(cc2d->Offset - cc2d->Radius, cc2d->Offset + cc2d->Radius);
+
+		if (min.x > max.x)
+		{
+			m_SpatialIndex.Remove(entity);
+			return;
+		}
 
-		auto& srcSceneRegistry = other->m_Registry;
-		auto& dstSceneRegistry = newScene->m_Registry;
-		std::unordered_map<UUID, entt::entity> enttMap;
+		const glm::mat4& transform = m_Registry.get<WorldTransformComponent>(entity).Transform;
+		const glm::vec2 corners[4] = { min, { max.x, min.y }, max, { min.x, max.y } };
 
-		// Create entities in new scene
-		auto idView = srcSceneRegistry.view<IDComponent>();
-		for (auto e : idView)
+		glm::vec2 worldMin(std::numeric_limits<float>::max());
+		glm::vec2 worldMax(std::numeric_limits<float>::lowest());
+		for (const glm::vec2& corner : corners)
 		{
-			UUID uuid = srcSceneRegistry.get<IDComponent>(e).ID;
-			const auto& name = srcSceneRegistry.get<TagComponent>(e).Tag;
-			Entity newEntity = newScene->CreateEntityWithUUID(uuid, name);
-			enttMap[uuid] = (entt::entity)newEntity;
+			glm::vec2 worldCorner = glm::vec2(transform * glm::vec4(corner, 0.0f, 1.0f));
+			worldMin = glm::min(worldMin, worldCorner);
+			worldMax = glm::max(worldMax, worldCorner);
 		}
 
-		// Copy components (except IDComponent and TagComponent)
-		CopyComponent(AllComponents{}, dstSceneRegistry, srcSceneRegistry, enttMap);
-
-		return newScene;
+		m_SpatialIndex.Update(entity, worldMin, worldMax);
 	}
 
-	Entity Scene::CreateEntity(const std::string& name)
+	std::vector<Entity> Scene::GetActiveEntities(const std::vector<entt::entity>& entities)
 	{
-		return CreateEntityWithUUID(UUID(), name);
+		std::vector<Entity> result;
+		result.reserve(entities.size());
+		for (entt::entity entity : entities)
+		{
+			if (m_Registry.valid(entity) && !m_Registry.has<DisabledComponent>(entity))
+				result.emplace_back(entity, this);
+		}
+		return result;
 	}
 
-	Entity Scene::CreateEntityWithUUID(UUID uuid, const std::string& name)
+	std::vector<Entity> Scene::QueryAABB(const glm::vec2& min, const glm::vec2& max)
 	{
-		Entity entity = { m_Registry.create(), this };
-		entity.AddComponent<IDComponent>(uuid);
-		entity.AddComponent<TransformComponent>();
-		auto& tag = entity.AddComponent<TagComponent>();
-		tag.Tag = name.empty() ? "Entity" : name;
-
-		m_EntityMap[uuid] = entity;
-
-		return entity;
+		std::vector<entt::entity> entities;
+		m_SpatialIndex.QueryAABB(min, max, entities);
+		return GetActiveEntities(entities);
 	}
 
-	void Scene::DestroyEntity(Entity entity)
+	std::vector<Entity> Scene::QueryRadius(const glm::vec2& center, float radius)
 	{
-		m_EntityMap.erase(entity.GetUUID());
-		m_Registry.destroy(entity);
+		std::vector<entt::entity> entities;
+		m_SpatialIndex.QueryRadius(center, radius, entities);
+		return GetActiveEntities(entities);
 	}
 
-	void Scene::OnRuntimeStart()
+	std::vector<Entity> Scene::QueryPoint(const glm::vec2& point)
 	{
-		m_IsRunning = true;
-
-		OnPhysics2DStart();
-
-		// Scripting
-		{
-			ScriptEngine::OnRuntimeStart(this);
-			// Instantiate all script entities
-
-			auto view = m_Registry.view<ScriptComponent>();
-			for (auto e : view)
-			{
-				Entity entity = { e, this };
-				ScriptEngine::OnCreateEntity(entity);
-			}
-		}
+		std::vector<entt::entity> entities;
+		m_SpatialIndex.QueryPoint(point, entities);
+		return GetActiveEntities(entities);
 	}
 
-	void Scene::OnRuntimeStop()
+	std::vector<Entity> Scene::QueryNearest(const glm::vec2& point, uint32_t count)
 	{
-		m_IsRunning = false;
-
-		OnPhysics2DStop();
-
-		ScriptEngine::OnRuntimeStop();
+		std::vector<entt::entity> entities;
+		m_SpatialIndex.QueryNearest(point, count, entities, [this](entt::entity entity)
+		{
+			return !m_Registry.has<DisabledComponent>(entity);
+		});
+		return GetActiveEntities(entities);
 	}
 
-	void Scene::OnSimulationStart()
+	Entity Scene::InstantiatePrefab(const Ref<Prefab>& prefab)
 	{
-		OnPhysics2DStart();
+		Entity source = prefab->GetEntity();
+		return InstantiatePrefab(prefab, source.GetComponent<TransformComponent>().Translation);
 	}
 
-	void Scene::OnSimulationStop()
+	Entity Scene::InstantiatePrefab(const Ref<Prefab>& prefab, const glm::vec3& translation)
 	{
-		OnPhysics2DStop();
+		std::vector<Entity> entities;
+		InstantiatePrefab(prefab, &translation, 1, &entities);
+		return entities.front();
 	}
 
-	void Scene::OnUpdateRuntime(Timestep ts)
+	void Scene::InstantiatePrefab(const Ref<Prefab>& prefab, const glm::vec3* translations, uint32_t count, std::vector<Entity>* outEntities)
 	{
-		if (!m_IsPaused || m_StepFrames-- > 0)
-		{
-			// Update scripts
-			{
-				// C# Entity OnUpdate
-				auto view = m_Registry.view<ScriptComponent>();
-				for (auto e : view)
-				{
-					Entity entity = { e, this };
-					ScriptEngine::OnUpdateEntity(entity, ts);
-				}
+		HZ_PROFILE_FUNCTION();
 
-				m_Registry.view<NativeScriptComponent>().each([=](auto entity, auto& nsc)
-					{
-						// TODO: Move to Scene::OnScenePlay
-						if (!nsc.Instance)
-						{
-							nsc.Instance = nsc.InstantiateScript();
-							nsc.Instance->m_Entity = Entity{ entity, this };
-							nsc.Instance->OnCreate();
-						}
-
-						nsc.Instance->OnUpdate(ts);
-					});
-			}
+		std::vector<UUID> ids;
+		ids.reserve(count);
+		for (uint32_t i = 0; i < count; i++)
+			ids.emplace_back();
 
-			// Physics
-			{
-				const int32_t velocityIterations = 6;
-				const int32_t positionIterations = 2;
-				m_PhysicsWorld->Step(ts, velocityIterations, positionIterations);
+		std::vector<entt::entity> entities(count);
+		CloneEntities(prefab->GetEntity(), ids.data(), entities.data(), count);
 
-				// Retrieve transform from Box2D
-				auto view = m_Registry.view<Rigidbody2DComponent>();
-				for (auto e : view)
-				{
-					Entity entity = { e, this };
-					auto& transform = entity.GetComponent<TransformComponent>();
-					auto& rb2d = entity.GetComponent<Rigidbody2DComponent>();
+		auto view = m_Registry.view<TransformComponent>();
+		for (uint32_t i = 0; i < count; i++)
+			view.get<TransformComponent>(entities[i]).Translation = translations[i];
 
-					b2Body* body = (b2Body*)rb2d.RuntimeBody;
+		for (entt::entity entity : entities)
+			InitializeRuntimeEntity({ entity, this });
 
-					const auto& position = body->GetPosition();
-					transform.Translation.x = position.x;
-					transform.Translation.y = position.y;
-					transform.Rotation.z = body->GetAngle();
-				}
-			}
+		if (outEntities)
+		{
+			outEntities->reserve(outEntities->size() + count);
+			for (entt::entity entity : entities)
+				outEntities->emplace_back(entity, this);
 		}
+	}
 
-		// Render 2D
-		Camera* mainCamera = nullptr;
-		glm::mat4 cameraTransform;
+	void Scene::CloneEntities(Entity source, const UUID* ids, entt::entity* outEntities, size_t count)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		entt::entity* first = outEntities;
+		entt::entity* last = outEntities + count;
+		m_Registry.create(first, last);
+
+		// Copy the name, the source may live in this registry
+		const std::string name = source.GetName();
+
+		std::vector<IDComponent> idComponents(count);
+		for (size_t i = 0; i < count; i++)
+			idComponents[i].ID = ids[i];
+		m_Registry.insert<IDComponent>(first, last, idComponents.begin(), idComponents.end());
+		m_Registry.insert<TagComponent>(first, last, TagComponent(name));
+		CloneComponents(AllComponents{}, m_Registry, source, first, last);
+		// Copies start out as roots, DuplicateEntity takes care of subtrees
+		m_Registry.insert<RelationshipComponent>(first, last);
+		m_Registry.insert<WorldTransformComponent>(first, last);
+		if (source.HasComponent<DisabledComponent>())
+			m_Registry.insert<DisabledComponent>(first, last);
+
+		// Runtime handles belong to the source, the copies get their own in InitializeRuntimeEntity
+		if (source.HasComponent<Rigidbody2DComponent>())
 		{
-			auto view = m_Registry.view<TransformComponent, CameraComponent>();
-			for (auto entity : view)
-			{
-				auto [transform, camera] = view.get<TransformComponent, CameraComponent>(entity);
-				
-				if (camera.Primary)
-				{
-					mainCamera = &camera.Camera;
-					cameraTransform = transform.GetTransform();
-					break;
-				}
-			}
+			for (entt::entity* it = first; it != last; ++it)
+				m_Registry.get<Rigidbody2DComponent>(*it).RuntimeBody = nullptr;
 		}
-
-		if (mainCamera)
+		if (source.HasComponent<BoxCollider2DComponent>())
 		{
-			Renderer2D::BeginScene(*mainCamera, cameraTransform);
-
-			// Draw sprites
-			{
-				auto group = m_Registry.group<TransformComponent>(entt::get<SpriteRendererComponent>);
-				for (auto entity : group)
-				{
-					auto [transform, sprite] = group.get<TransformComponent, SpriteRendererComponent>(entity);
-
-					Renderer2D::DrawSprite(transform.GetTransform(), sprite, (int)entity);
-				}
-			}
-
-			// Draw circles
-			{
-				auto view = m_Registry.view<TransformComponent, CircleRendererComponent>();
-				for (auto entity : view)
-				{
-					auto [transform, circle] = view.get<TransformComponent, CircleRendererComponent>(entity);
-
-					Renderer2D::DrawCircle(transform.GetTransform(), circle.Color, circle.Thickness, circle.Fade, (int)entity);
-				}
-			}
-
-			// Draw text
-			{
-				auto view = m_Registry.view<TransformComponent, TextComponent>();
-				for (auto entity : view)
-				{
-					auto [transform, text] = view.get<TransformComponent, TextComponent>(entity);
-
-					Renderer2D::DrawString(text.TextString, transform.GetTransform(), text, (int)entity);
-				}
-			}
-
-			Renderer2D::EndScene();
+			for (entt::entity* it = first; it != last; ++it)
+				m_Registry.get<BoxCollider2DComponent>(*it).RuntimeFixture = nullptr;
+		}
+		if (source.HasComponent<CircleCollider2DComponent>())
+		{
+			for (entt::entity* it = first; it != last; ++it)
+				m_Registry.get<CircleCollider2DComponent>(*it).RuntimeFixture = nullptr;
+		}
+		if (source.HasComponent<NativeScriptComponent>())
+		{
+			for (entt::entity* it = first; it != last; ++it)
+				m_Registry.get<NativeScriptComponent>(*it).Instance = nullptr;
 		}
 
-	}
+		// Cameras are the only components that react to being added, see OnComponentAdded
+		if (source.HasComponent<CameraComponent>() && m_ViewportWidth > 0 && m_ViewportHeight > 0)
+		{
+			for (entt::entity* it = first; it != last; ++it)
+				m_Registry.get<CameraComponent>(*it).Camera.SetViewportSize(m_ViewportWidth, m_ViewportHeight);
+		}
 
-	void Scene::OnUpdateSimulation(Timestep ts, EditorCamera& camera)
-	{
-		if (!m_IsPaused || m_StepFrames-- > 0)
+		if (source.HasComponent<ScriptComponent>())
 		{
-			// Physics
+			// Copied up front, creating the other field maps can move the source's
+			ScriptFieldMap fields = ScriptEngine::GetScriptFieldMap(source);
+			if (!fields.empty())
 			{
-				const int32_t velocityIterations = 6;
-				const int32_t positionIterations = 2;
-				m_PhysicsWorld->Step(ts, velocityIterations, positionIterations);
-
-				// Retrieve transform from Box2D
-				auto view = m_Registry.view<Rigidbody2DComponent>();
-				for (auto e : view)
-				{
-					Entity entity = { e, this };
-					auto& transform = entity.GetComponent<TransformComponent>();
-					auto& rb2d = entity.GetComponent<Rigidbody2DComponent>();
-
-					b2Body* body = (b2Body*)rb2d.RuntimeBody;
-					const auto& position = body->GetPosition();
-					transform.Translation.x = position.x;
-					transform.Translation.y = position.y;
-					transform.Rotation.z = body->GetAngle();
-				}
+				for (entt::entity* it = first; it != last; ++it)
+					ScriptEngine::GetScriptFieldMap({ *it, this }) = fields;
 			}
 		}
 
-		// Render
-		RenderScene(camera);
-	}
+		m_EntityMap.reserve(m_EntityMap.size() + count);
+		for (size_t i = 0; i < count; i++)
+			m_EntityMap[ids[i]] = outEntities[i];
 
-	void Scene::OnUpdateEditor(Timestep ts, EditorCamera& camera)
-	{
-		// Render
-		RenderScene(camera);
+		NameID nameID = m_NameIndex.Intern(name);
+		for (entt::entity* it = first; it != last; ++it)
+			m_NameIndex.Add(nameID, *it);
 	}
 
-	void Scene::OnViewportResize(uint32_t width, uint32_t height)
+	void Scene::SetEntityName(Entity entity, std::string_view name)
 	{
-		if (m_ViewportWidth == width && m_ViewportHeight == height)
+		auto& tag = entity.GetComponent<TagComponent>();
+		if (tag.Tag == name)
 			return;
 
-		m_ViewportWidth = width;
-		m_ViewportHeight = height;
+		if (NameID nameID = m_NameIndex.GetNameID(tag.Tag); nameID != EntityNameIndex::InvalidNameID)
+			m_NameIndex.Remove(nameID, entity);
 
-		// Resize our non-FixedAspectRatio cameras
-		auto view = m_Registry.view<CameraComponent>();
-		for (auto entity : view)
-		{
-			auto& cameraComponent = view.get<CameraComponent>(entity);
-			if (!cameraComponent.FixedAspectRatio)
-				cameraComponent.Camera.SetViewportSize(width, height);
-		}
+		tag.Tag = name;
+		m_NameIndex.Add(m_NameIndex.Intern(name), entity);
 	}
 
-	Entity Scene::GetPrimaryCameraEntity()
+	Entity Scene::FindEntityByName(std::string_view name)
 	{
-		auto view = m_Registry.view<CameraComponent>();
-		for (auto entity : view)
+		NameID nameID = m_NameIndex.GetNameID(name);
+		if (nameID == EntityNameIndex::InvalidNameID)
+			return {};
+
+		// Tags written directly leave stale entries behind, so check the name is still current
+		for (entt::entity entity : m_NameIndex.GetEntities(nameID))
 		{
-			const auto& camera = view.get<CameraComponent>(entity);
-			if (camera.Primary)
-				return Entity{entity, this};
+			if (m_Registry.valid(entity) && m_Registry.get<TagComponent>(entity).Tag == name)
+				return Entity{ entity, this };
 		}
 		return {};
 	}
 
-	void Scene::Step(int frames)
+	std::vector<Entity> Scene::FindEntitiesByName(std::string_view name)
 	{
-		m_StepFrames = frames;
-	}
+		std::vector<Entity> result;
 
-	Entity Scene::DuplicateEntity(Entity entity)
-	{
-		// Copy name because we're going to modify component data structure
-		std::string name = entity.GetName();
-		Entity newEntity = CreateEntity(name);
-		CopyComponentIfExists(AllComponents{}, newEntity, entity);
-		return newEntity;
+		NameID nameID = m_NameIndex.GetNameID(name);
+		if (nameID == EntityNameIndex::InvalidNameID)
+			return result;
+
+		for (entt::entity entity : m_NameIndex.GetEntities(nameID))
+		{
+			if (m_Registry.valid(entity) && m_Registry.get<TagComponent>(entity).Tag == name)
+				result.emplace_back(entity, this);
+		}
+		return result;
 	}
 
-	Entity Scene::FindEntityByName(std::string_view name)
+	std::vector<Entity> Scene::FindEntitiesByNamePrefix(std::string_view prefix)
 	{
-		auto view = m_Registry.view<TagComponent>();
-		for (auto entity : view)
+		std::vector<Entity> result;
+		m_NameIndex.ForEachNameWithPrefix(prefix, [&](NameID nameID)
 		{
-			const TagComponent& tc = view.get<TagComponent>(entity);
-			if (tc.Tag == name)
-				return Entity{ entity, this };
-		}
-		return {};
+			const std::string& name = m_NameIndex.GetName(nameID);
+			for (entt::entity entity : m_NameIndex.GetEntities(nameID))
+			{
+				if (m_Registry.valid(entity) && m_Registry.get<TagComponent>(entity).Tag == name)
+					result.emplace_back(entity, this);
+			}
+		});
+		return result;
 	}
 
 	Entity Scene::GetEntityByUUID(UUID uuid)
 	{
 		// TODO(Yan): Maybe should be assert
-		if (m_EntityMap.find(uuid) != m_EntityMap.end())
-			return { m_EntityMap.at(uuid), this };
+		auto it = m_EntityMap.find(uuid);
+		if (it != m_EntityMap.end())
+			return { it->second, this };
 
 		return {};
 	}
@@ -378,57 +1462,69 @@ namespace Hazel {
 
 		auto view = m_Registry.view<Rigidbody2DComponent>();
 		for (auto e : view)
-		{
-			Entity entity = { e, this };
-			auto& transform = entity.GetComponent<TransformComponent>();
-			auto& rb2d = entity.GetComponent<Rigidbody2DComponent>();
-
-			b2BodyDef bodyDef;
-			bodyDef.type = Utils::Rigidbody2DTypeToBox2DBody(rb2d.Type);
-			bodyDef.position.Set(transform.Translation.x, transform.Translation.y);
-			bodyDef.angle = transform.Rotation.z;
-
-			b2Body* body = m_PhysicsWorld->CreateBody(&bodyDef);
-			body->SetFixedRotation(rb2d.FixedRotation);
-			rb2d.RuntimeBody = body;
-
-			if (entity.HasComponent<BoxCollider2DComponent>())
-			{
-				auto& bc2d = entity.GetComponent<BoxCollider2DComponent>();
-
-				b2PolygonShape boxShape;
-				boxShape.SetAsBox(bc2d.Size.x * transform.Scale.x, bc2d.Size.y * transform.Scale.y, b2Vec2(bc2d.Offset.x, bc2d.Offset.y), 0.0f);
-
-				b2FixtureDef fixtureDef;
-				fixtureDef.shape = &boxShape;
-				fixtureDef.density = bc2d.Density;
-				fixtureDef.friction = bc2d.Friction;
-				fixtureDef.restitution = bc2d.Restitution;
-				fixtureDef.restitutionThreshold = bc2d.RestitutionThreshold;
-				body->CreateFixture(&fixtureDef);
-			}
-
-			if (entity.HasComponent<CircleCollider2DComponent>())
-			{
-				auto& cc2d = entity.GetComponent<CircleCollider2DComponent>();
+			CreatePhysicsBody({ e, this });
+	}
 
-				b2CircleShape circleShape;
-				circleShape.m_p.Set(cc2d.Offset.x, cc2d.Offset.y);
-				circleShape.m_radius = transform.Scale.x * cc2d.Radius;
+	void Scene::CreatePhysicsBody(Entity entity)
+	{
+		auto& transform = entity.GetComponent<TransformComponent>();
+		auto& rb2d = entity.GetComponent<Rigidbody2DComponent>();
+
+		b2BodyDef bodyDef;
+		bodyDef.type = Utils::Rigidbody2DTypeToBox2DBody(rb2d.Type);
+		bodyDef.position.Set(transform.Translation.x, transform.Translation.y);
+		bodyDef.angle = transform.Rotation.z;
+		bodyDef.enabled = !entity.HasComponent<DisabledComponent>();
+
+		b2Body* body = m_PhysicsWorld->CreateBody(&bodyDef);
+		body->SetFixedRotation(rb2d.FixedRotation);
+		rb2d.RuntimeBody = body;
+		rb2d.PreviousPosition = { transform.Translation.x, transform.Translation.y };
+		rb2d.PreviousAngle = transform.Rotation.z;
+		entity.GetComponent<WorldTransformComponent>().Interpolated = true;
+
+		if (entity.HasComponent<BoxCollider2DComponent>())
+		{
+			auto& bc2d = entity.GetComponent<BoxCollider2DComponent>();
+
+			b2PolygonShape boxShape;
+			boxShape.SetAsBox(bc2d.Size.x * transform.Scale.x, bc2d.Size.y * transform.Scale.y, b2Vec2(bc2d.Offset.x, bc2d.Offset.y), 0.0f);
+
+			b2FixtureDef fixtureDef;
+			fixtureDef.shape = &boxShape;
+			fixtureDef.density = bc2d.Density;
+			fixtureDef.friction = bc2d.Friction;
+			fixtureDef.restitution = bc2d.Restitution;
+			fixtureDef.restitutionThreshold = bc2d.RestitutionThreshold;
+			body->CreateFixture(&fixtureDef);
+		}
 
-				b2FixtureDef fixtureDef;
-				fixtureDef.shape = &circleShape;
-				fixtureDef.density = cc2d.Density;
-				fixtureDef.friction = cc2d.Friction;
-				fixtureDef.restitution = cc2d.Restitution;
-				fixtureDef.restitutionThreshold = cc2d.RestitutionThreshold;
-				body->CreateFixture(&fixtureDef);
-			}
+		if (entity.HasComponent<CircleCollider2DComponent>())
+		{
+			auto& cc2d = entity.GetComponent<CircleCollider2DComponent>();
+
+			b2CircleShape circleShape;
+			circleShape.m_p.Set(cc2d.Offset.x, cc2d.Offset.y);
+			circleShape.m_radius = transform.Scale.x * cc2d.Radius;
+
+			b2FixtureDef fixtureDef;
+			fixtureDef.shape = &circleShape;
+			fixtureDef.density = cc2d.Density;
+			fixtureDef.friction = cc2d.Friction;
+			fixtureDef.restitution = cc2d.Restitution;
+			fixtureDef.restitutionThreshold = cc2d.RestitutionThreshold;
+			body->CreateFixture(&fixtureDef);
 		}
 	}
 
 	void Scene::OnPhysics2DStop()
 	{
+		for (auto e : m_Registry.view<Rigidbody2DComponent>())
+		{
+			m_Registry.get<Rigidbody2DComponent>(e).RuntimeBody = nullptr;
+			m_Registry.get<WorldTransformComponent>(e).Interpolated = false;
+		}
+
 		delete m_PhysicsWorld;
 		m_PhysicsWorld = nullptr;
 	}
@@ -439,34 +1535,34 @@ namespace Hazel {
 
 		// Draw sprites
 		{
-			auto group = m_Registry.group<TransformComponent>(entt::get<SpriteRendererComponent>);
-			for (auto entity : group)
+			auto view = m_Registry.view<WorldTransformComponent, SpriteRendererComponent>(entt::exclude<DisabledComponent>);
+			for (auto entity : view)
 			{
-				auto [transform, sprite] = group.get<TransformComponent, SpriteRendererComponent>(entity);
+				auto [transform, sprite] = view.get<WorldTransformComponent, SpriteRendererComponent>(entity);
 
-				Renderer2D::DrawSprite(transform.GetTransform(), sprite, (int)entity);
+				Renderer2D::DrawSprite(transform.RenderTransform, sprite, (int)entity);
 			}
 		}
 
 		// Draw circles
 		{
-			auto view = m_Registry.view<TransformComponent, CircleRendererComponent>();
+			auto view = m_Registry.view<WorldTransformComponent, CircleRendererComponent>(entt::exclude<DisabledComponent>);
 			for (auto entity : view)
 			{
-				auto [transform, circle] = view.get<TransformComponent, CircleRendererComponent>(entity);
+				auto [transform, circle] = view.get<WorldTransformComponent, CircleRendererComponent>(entity);
 
-				Renderer2D::DrawCircle(transform.GetTransform(), circle.Color, circle.Thickness, circle.Fade, (int)entity);
+				Renderer2D::DrawCircle(transform.RenderTransform, circle.Color, circle.Thickness, circle.Fade, (int)entity);
 			}
 		}
 
 		// Draw text
 		{
-			auto view = m_Registry.view<TransformComponent, TextComponent>();
+			auto view = m_Registry.view<WorldTransformComponent, TextComponent>(entt::exclude<DisabledComponent>);
 			for (auto entity : view)
 			{
-				auto [transform, text] = view.get<TransformComponent, TextComponent>(entity);
+				auto [transform, text] = view.get<WorldTransformComponent, TextComponent>(entity);
 
-				Renderer2D::DrawString(text.TextString, transform.GetTransform(), text, (int)entity);
+				Renderer2D::DrawString(text.TextString, transform.RenderTransform, text, (int)entity);
 			}
 		}
 
@@ -489,6 +1585,16 @@ namespace Hazel {
 	{
 	}
 
+	template<>
+	void Scene::OnComponentAdded<RelationshipComponent>(Entity entity, RelationshipComponent& component)
+	{
+	}
+
+	template<>
+	void Scene::OnComponentAdded<WorldTransformComponent>(Entity entity, WorldTransformComponent& component)
+	{
+	}
+
 	template<>
 	void Scene::OnComponentAdded<CameraComponent>(Entity entity, CameraComponent& component)
 	{
@@ -519,6 +1625,9 @@ namespace Hazel {
 	template<>
 	void Scene::OnComponentAdded<NativeScriptComponent>(Entity entity, NativeScriptComponent& component)
 	{
+		// The script is bound after the component is added
+		if (m_IsRunning)
+			m_PendingNativeScripts.push_back(entity);
 	}
 
 	template<>
@@ -541,4 +1650,9 @@ namespace Hazel {
 	{
 	}
 
+	template<>
+	void Scene::OnComponentAdded<UpdateLODComponent>(Entity entity, UpdateLODComponent& component)
+	{
+	}
+
 }
@@ -2,7 +2,14 @@
 
 #include "XingXing/Core/Timestep.h"
 #include "XingXing/Core/UUID.h"
+#include "XingXing/Core/FlatHashMap.h"
 #include "XingXing/Renderer/EditorCamera.h"
+#include "XingXing/Scene/SystemScheduler.h"
+#include "XingXing/Scene/EntityNameIndex.h"
+#include "XingXing/Scene/SpatialIndex.h"
+#include "XingXing/Scene/SceneSnapshot.h"
+#include "XingXing/Scene/UpdateLOD.h"
+#include "XingXing/Scene/WorldPartition.h"
 
 #include "entt.hpp"
 
@@ -11,15 +18,30 @@ class b2World;
 namespace Hazel {
 
 	class Entity;
+	class EntityCommandBuffer;
+	class Prefab;
+	struct DisabledComponent;
 
 	class Scene
 	{
+	public:
+		// Script entities per update LOD tier, counted once per frame
+		struct UpdateLODStatistics
+		{
+			uint32_t Full = 0;
+			uint32_t Reduced = 0;
+			uint32_t Suspended = 0;
+		};
 	public:
 		Scene();
 		~Scene();
 
 		static Ref<Scene> Copy(Ref<Scene> other);
 
+		// Frees the asset table slots that none of the live scenes' components refer to any more.
+		// Runs when a scene is destroyed and when streamed cells are unloaded; main thread only.
+		static void ReleaseUnusedAssets();
+
 		Entity CreateEntity(const std::string& name = std::string());
 		Entity CreateEntityWithUUID(UUID uuid, const std::string& name = std::string());
 		void DestroyEntity(Entity entity);
@@ -35,13 +57,96 @@ namespace Hazel {
 		void OnUpdateEditor(Timestep ts, EditorCamera& camera);
 		void OnViewportResize(uint32_t width, uint32_t height);
 
+		// Duplicates the whole subtree, the copy gets the same parent
 		Entity DuplicateEntity(Entity entity);
 
+		// Children keep their local transform, relative to the parent. With keepWorldTransform the
+		// local transform is adjusted so the entity stays where it is. Pass a null parent to detach.
+		void SetParent(Entity entity, Entity parent, bool keepWorldTransform = false);
+		Entity GetParent(Entity entity);
+		bool IsDescendantOf(Entity entity, Entity ancestor);
+
+		// Disabled entities keep their components, script instances and physics bodies, but are skipped by
+		// rendering, script updates and physics. Children are not affected.
+		void SetEntityActive(Entity entity, bool active);
+		bool IsEntityActive(Entity entity);
+
+		// Copies of the prefab's entity are created with a few range operations per component type,
+		// which keeps spawning large batches cheap. Not safe while iterating entities, use the command buffer there.
+		Entity InstantiatePrefab(const Ref<Prefab>& prefab);
+		Entity InstantiatePrefab(const Ref<Prefab>& prefab, const glm::vec3& translation);
+		void InstantiatePrefab(const Ref<Prefab>& prefab, const glm::vec3* translations, uint32_t count, std::vector<Entity>* outEntities = nullptr);
+
+		// Names are indexed, rename entities through SetEntityName (or Entity::SetName) to keep the index valid
+		void SetEntityName(Entity entity, std::string_view name);
 		Entity FindEntityByName(std::string_view name);
+		std::vector<Entity> FindEntitiesByName(std::string_view name);
+		std::vector<Entity> FindEntitiesByNamePrefix(std::string_view prefix);
 		Entity GetEntityByUUID(UUID uuid);
 
 		Entity GetPrimaryCameraEntity();
 
+		// Queries the world space bounds of sprites, circles and colliders on the xy plane. The index is
+		// brought up to date once per frame, after the transform hierarchy. Disabled entities are skipped.
+		std::vector<Entity> QueryAABB(const glm::vec2& min, const glm::vec2& max);
+		std::vector<Entity> QueryRadius(const glm::vec2& center, float radius);
+		std::vector<Entity> QueryPoint(const glm::vec2& point);
+		// Closest first
+		std::vector<Entity> QueryNearest(const glm::vec2& point, uint32_t count);
+
+		// With a world path set, the world's cells are streamed in around the primary camera while the scene runs
+		void SetWorldSpecification(const WorldPartitionSpecification& specification) { m_WorldSpecification = specification; }
+		const WorldPartitionSpecification& GetWorldSpecification() const { return m_WorldSpecification; }
+		// Only exists while the scene is running
+		WorldPartition* GetWorldPartition() const { return m_WorldPartition.get(); }
+
+		// Records the state of every simulated frame while the scene runs, so it can be rewound and replayed
+		void SetRewindEnabled(bool enabled, const RewindBufferSpecification& specification = RewindBufferSpecification());
+		bool IsRewindEnabled() const { return m_RewindEnabled; }
+		// Only exists while the scene is running with rewind enabled
+		RewindBuffer* GetRewindBuffer() const { return m_RewindBuffer.get(); }
+
+		// With rendering disabled the scene runs as usual but submits nothing to Renderer2D
+		void SetRenderingEnabled(bool enabled) { m_RenderingEnabled = enabled; }
+		bool IsRenderingEnabled() const { return m_RenderingEnabled; }
+
+		const SystemScheduler& GetSystemScheduler() const { return m_Systems; }
+
+		// Native systems update every enabled entity with all of Components in one call per frame while
+		// the scene runs, after the scripts and in the order they were added. func(view, ts) gets the entt
+		// view of those entities. They are scheduled as writing Components, so they may run alongside
+		// systems that don't touch them; create and destroy entities through the command buffer only.
+		// Added or removed while the scene runs, the change takes effect from the next frame.
+		template<typename... Components, typename Func>
+		void AddNativeSystem(const std::string& name, Func func)
+		{
+			AddNativeSystem(name, SystemAccess().Write<Components...>(), [func](Scene& scene, Timestep ts)
+			{
+				func(scene.m_Registry.view<Components...>(entt::exclude<DisabledComponent>), ts);
+			});
+		}
+
+		// As AddNativeSystem, with func(entity, components..., ts) called per entity in chunks of grainSize
+		// spread over the job system. func must only touch the given entity's components.
+		template<typename... Components, typename Func>
+		void AddParallelNativeSystem(const std::string& name, uint32_t grainSize, Func func)
+		{
+			AddNativeSystem(name, SystemAccess().Write<Components...>(), [grainSize, func](Scene& scene, Timestep ts)
+			{
+				ParallelEach<Components...>(scene.m_Registry, grainSize, [&](entt::entity entity, Components&... components)
+				{
+					func(entity, components..., ts);
+				}, entt::exclude<DisabledComponent>);
+			});
+		}
+
+		using NativeSystemFunction = std::function<void(Scene&, Timestep)>;
+		void AddNativeSystem(const std::string& name, const SystemAccess& access, const NativeSystemFunction& function);
+		void RemoveNativeSystem(const std::string& name);
+
+		// Structural changes recorded here are applied at the scene's sync points, see EntityCommandBuffer
+		EntityCommandBuffer& GetCommandBuffer() { return *m_CommandBuffer; }
+
 		bool IsRunning() const { return m_IsRunning; }
 		bool IsPaused() const { return m_IsPaused; }
 
@@ -49,33 +154,146 @@ namespace Hazel {
 
 		void Step(int frames = 1);
 
+		// Physics and OnFixedUpdate run at a fixed rate whatever the frame rate, rendering interpolates
+		// between the last two physics states. A frame runs at most maxSubsteps ticks, time beyond
+		// that is dropped so one slow frame can't make the following ones slower.
+		void SetFixedTimestep(float timestep) { HZ_CORE_ASSERT(timestep > 0.0f); m_FixedTimestep = timestep; }
+		float GetFixedTimestep() const { return m_FixedTimestep; }
+		void SetMaxSubsteps(uint32_t maxSubsteps) { HZ_CORE_ASSERT(maxSubsteps >= 1, "Physics can't run without substeps"); m_MaxSubsteps = maxSubsteps; }
+		uint32_t GetMaxSubsteps() const { return m_MaxSubsteps; }
+
+		// Scripts far from the primary camera, or outside its view, update less often or not at all.
+		// Entities of a class without settings update every frame, unless they have an UpdateLODComponent.
+		void SetScriptUpdateLOD(const std::string& className, const UpdateLODSettings& settings);
+		void RemoveScriptUpdateLOD(const std::string& className);
+		const FlatHashMap<std::string, UpdateLODSettings>& GetScriptUpdateLODs() const { return m_ScriptUpdateLODs; }
+		const UpdateLODStatistics& GetUpdateLODStatistics() const { return m_UpdateLODStatistics; }
+
 		template<typename... Components>
 		auto GetAllEntitiesWith()
 		{
 			return m_Registry.view<Components...>();
 		}
+
+		template<typename... Components>
+		auto GetAllActiveEntitiesWith()
+		{
+			return m_Registry.view<Components...>(entt::exclude<DisabledComponent>);
+		}
 	private:
+		// Untracked scenes are left out of ReleaseUnusedAssets, so a job can fill one while the main thread
+		// releases assets. They must not refer to any; WorldPartition reads world cells into them.
+		explicit Scene(bool tracked);
+
 		template<typename T>
 		void OnComponentAdded(Entity entity, T& component);
 
+		// Creates one entity per id as a copy of source, which may belong to another scene
+		void CloneEntities(Entity source, const UUID* ids, entt::entity* outEntities, size_t count);
+
 		void OnPhysics2DStart();
 		void OnPhysics2DStop();
+		void CreatePhysicsBody(Entity entity);
+
+		// Sets up physics bodies and script instances for an entity created while the scene is running
+		void InitializeRuntimeEntity(Entity entity);
+		void CreateNativeScript(entt::entity entity);
+		void CreatePendingNativeScripts();
+		// Undoes InitializeRuntimeEntity and removes the entity from the lookups, before it is destroyed
+		void ReleaseEntityResources(Entity entity);
+
+		// The runtime side of single components, for components added and removed while the scene runs
+		void DestroyPhysicsBody(Entity entity);
+		// Rebuilds the body from the entity's current rigidbody and colliders, keeping its velocity
+		void RecreatePhysicsBody(Entity entity);
+		void CreateScriptInstance(Entity entity);
+		void DestroyScriptInstance(Entity entity);
+		void DestroyNativeScript(Entity entity);
+
+		// Brings WorldTransformComponent up to date in one sweep over its pool
+		void UpdateWorldTransforms();
+		void UpdateHierarchyDepth(Entity entity, uint32_t depth);
+		// Resolves the parent handles and depths from the relationships, after loading a scene
+		void RebuildHierarchy();
+		Entity DuplicateSubtree(Entity entity, Entity parent);
+
+		// Refreshes the boxes of entities that moved or gained/lost bounds since the last update
+		void UpdateSpatialIndex();
+		void RefreshBounds(entt::entity entity);
+		std::vector<Entity> GetActiveEntities(const std::vector<entt::entity>& entities);
 
+		// Assigns the script entities their tier for this frame and decides which of them update
+		void UpdateScriptLOD(Timestep ts);
+		// Whether the entity's scripts update this frame, and with which timestep
+		bool ShouldUpdateScripts(entt::entity entity, Timestep frameTimestep, Timestep& timestep);
+
+		// One tick: scripts' OnFixedUpdate, then the physics step
+		void FixedUpdate();
+		void RegisterSystems(bool runtime);
 		void RenderScene(EditorCamera& camera);
 	private:
 		entt::registry m_Registry;
 		uint32_t m_ViewportWidth = 0, m_ViewportHeight = 0;
+		bool m_Tracked = true;
 		bool m_IsRunning = false;
 		bool m_IsPaused = false;
+		bool m_RenderingEnabled = true;
 		int m_StepFrames = 0;
 
 		b2World* m_PhysicsWorld = nullptr;
 
-		std::unordered_map<UUID, entt::entity> m_EntityMap;
+		SystemScheduler m_Systems;
+
+		struct NativeSystem
+		{
+			std::string Name;
+			SystemAccess Access;
+			NativeSystemFunction Function;
+		};
+		std::vector<NativeSystem> m_NativeSystems;
+		// Native scripts added while the scene runs, instantiated at the next script update or command playback
+		std::vector<entt::entity> m_PendingNativeScripts;
+		// Native systems changed while running, the schedule is rebuilt after the frame
+		bool m_SystemsDirty = false;
+
+		// Per-frame state shared between systems
+		bool m_SimulateFrame = false;
+		float m_FixedTimestep = 1.0f / 60.0f;
+		uint32_t m_MaxSubsteps = 8;
+		float m_FixedTimeAccumulator = 0.0f;
+		// How far the frame is between the last two physics states
+		float m_InterpolationAlpha = 1.0f;
+		Camera* m_RuntimeCamera = nullptr;
+		glm::mat4 m_RuntimeCameraTransform;
+		glm::mat4 m_RuntimeCameraViewProjection;
+		uint32_t m_FrameIndex = 0;
+
+		FlatHashMap<std::string, UpdateLODSettings> m_ScriptUpdateLODs;
+		UpdateLODStatistics m_UpdateLODStatistics;
+
+		FlatHashMap<UUID, entt::entity> m_EntityMap;
+		EntityNameIndex m_NameIndex;
+
+		SpatialIndex m_SpatialIndex;
+		std::vector<entt::entity> m_BoundsChanged;
+		bool m_RebuildSpatialIndex = true;
+
+		Scope<EntityCommandBuffer> m_CommandBuffer;
+
+		WorldPartitionSpecification m_WorldSpecification;
+		Scope<WorldPartition> m_WorldPartition;
+
+		bool m_RewindEnabled = false;
+		RewindBufferSpecification m_RewindSpecification;
+		Scope<RewindBuffer> m_RewindBuffer;
 
 		friend class Entity;
 		friend class SceneSerializer;
 		friend class SceneHierarchyPanel;
+		friend class EntityCommandBuffer;
+		friend class Prefab;
+		friend class WorldPartition;
+		friend class SceneSnapshot;
 	};
 
 }
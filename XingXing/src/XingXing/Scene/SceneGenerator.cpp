@@ -0,0 +1,299 @@
+#include "hzpch.h"
+#include "XingXing/Scene/SceneGenerator.h"
+
+#include "XingXing/Scene/Scene.h"
+#include "XingXing/Scene/Entity.h"
+#include "XingXing/Scene/Components.h"
+#include "XingXing/Project/Project.h"
+#include "XingXing/Renderer/TextureAtlas.h"
+
+#include <glm/gtc/constants.hpp>
+
+#include <yaml-cpp/yaml.h>
+
+namespace Hazel {
+
+	namespace Utils {
+
+		// SplitMix64. Unlike the std distributions it gives the same numbers with every standard library.
+		class Random
+		{
+		public:
+			// Each kind of entity draws from its own stream, so changing one count doesn't move the others
+			Random(uint64_t seed, uint64_t stream)
+				: m_State(seed ^ (stream * 0xD1B54A32D192ED03ull)) {}
+
+			uint64_t Next()
+			{
+				uint64_t z = (m_State += 0x9E3779B97F4A7C15ull);
+				z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+				z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+				return z ^ (z >> 31);
+			}
+
+			// [0, 1)
+			float Float() { return (float)(Next() >> 40) / (float)(1 << 24); }
+			float Range(float min, float max) { return min + (max - min) * Float(); }
+			uint32_t Index(uint32_t count) { return (uint32_t)(Next() % count); }
+
+			glm::vec4 Color() { return { Range(0.2f, 1.0f), Range(0.2f, 1.0f), Range(0.2f, 1.0f), 1.0f }; }
+		private:
+			uint64_t m_State;
+		};
+
+		struct SpriteTexture
+		{
+			AssetHandle<Texture2D> Texture;
+			AssetHandle<SubTexture2D> SubTexture;
+		};
+
+		// Resolves the textures the same way the editor does when one is dropped on a sprite
+		static std::vector<SpriteTexture> LoadSpriteTextures(const std::vector<std::filesystem::path>& textures)
+		{
+			std::vector<SpriteTexture> result;
+			if (textures.empty())
+				return result;
+
+			if (!Project::GetActive())
+			{
+				HZ_CORE_ERROR("SceneGenerator: textures need an active project, sprites will be plain colors");
+				return result;
+			}
+
+			Ref<TextureAtlas> spriteAtlas = Project::GetSpriteAtlas();
+			for (const auto& texture : textures)
+			{
+				std::filesystem::path path = Project::GetAssetFileSystemPath(texture);
+
+				SpriteTexture& spriteTexture = result.emplace_back();
+				if (spriteAtlas)
+					spriteTexture.SubTexture = AssetTable<SubTexture2D>::Add(spriteAtlas->GetSubTexture(path));
+				if (spriteTexture.SubTexture)
+					continue;
+
+				spriteTexture.Texture = AssetTable<Texture2D>::Find(path.string());
+				if (spriteTexture.Texture)
+					continue;
+
+				Ref<Texture2D> loaded = Texture2D::Create(path.string());
+				if (loaded->IsLoaded())
+					spriteTexture.Texture = AssetTable<Texture2D>::Add(loaded, path.string());
+				else
+				{
+					HZ_CORE_WARN("SceneGenerator: could not load texture {0}", path.string());
+					result.pop_back();
+				}
+			}
+
+			return result;
+		}
+
+	}
+
+	Ref<Scene> SceneGenerator::Generate(const SceneGeneratorSpecification& specification)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		Ref<Scene> scene = CreateRef<Scene>();
+		const glm::vec2 halfExtent = specification.Extent * 0.5f;
+
+		std::vector<Utils::SpriteTexture> textures = Utils::LoadSpriteTextures(specification.Textures);
+
+		// IDs come from the generator too, so the same specification writes the same file
+		Utils::Random idRandom(specification.Seed, 0);
+		auto createEntity = [&](const char* kind, uint32_t index)
+		{
+			return scene->CreateEntityWithUUID(idRandom.Next(), fmt::format("{0} {1}", kind, index));
+		};
+
+		auto place = [&](Entity entity, Utils::Random& random)
+		{
+			auto& transform = entity.GetComponent<TransformComponent>();
+			transform.Translation = { random.Range(-halfExtent.x, halfExtent.x), random.Range(-halfExtent.y, halfExtent.y), 0.0f };
+			transform.Rotation.z = random.Range(0.0f, glm::two_pi<float>());
+			float scale = random.Range(0.5f, 1.5f);
+			transform.Scale = { scale, scale, 1.0f };
+		};
+
+		auto addSprite = [&](Entity entity, Utils::Random& random)
+		{
+			auto& sprite = entity.AddComponent<SpriteRendererComponent>();
+			sprite.Color = random.Color();
+			if (!textures.empty())
+			{
+				const Utils::SpriteTexture& texture = textures[random.Index((uint32_t)textures.size())];
+				sprite.Texture = texture.Texture;
+				sprite.SubTexture = texture.SubTexture;
+			}
+		};
+
+		{
+			// Named like the camera of hand-made scenes, scripts look it up by name
+			Entity camera = scene->CreateEntityWithUUID(idRandom.Next(), "Camera");
+			auto& cc = camera.AddComponent<CameraComponent>();
+			cc.Camera.SetProjectionType(SceneCamera::ProjectionType::Orthographic);
+			cc.Camera.SetOrthographicSize(specification.Extent.y);
+		}
+
+		Utils::Random spriteRandom(specification.Seed, 1);
+		for (uint32_t i = 0; i < specification.SpriteCount; i++)
+		{
+			Entity entity = createEntity("Sprite", i);
+			place(entity, spriteRandom);
+			addSprite(entity, spriteRandom);
+		}
+
+		Utils::Random circleRandom(specification.Seed, 2);
+		for (uint32_t i = 0; i < specification.CircleCount; i++)
+		{
+			Entity entity = createEntity("Circle", i);
+			place(entity, circleRandom);
+			auto& circle = entity.AddComponent<CircleRendererComponent>();
+			circle.Color = circleRandom.Color();
+			circle.Thickness = circleRandom.Range(0.1f, 1.0f);
+		}
+
+		Utils::Random textRandom(specification.Seed, 3);
+		for (uint32_t i = 0; i < specification.TextCount; i++)
+		{
+			Entity entity = createEntity("Text", i);
+			place(entity, textRandom);
+			auto& text = entity.AddComponent<TextComponent>();
+			text.TextString = fmt::format("Text {0}", i);
+			text.Color = textRandom.Color();
+		}
+
+		Utils::Random rigidbodyRandom(specification.Seed, 4);
+		if (specification.RigidbodyCount > 0)
+		{
+			const float spacing = 1.5f;
+			uint32_t columns = (uint32_t)glm::ceil(glm::sqrt((float)specification.RigidbodyCount));
+			float width = glm::max(specification.Extent.x, columns * spacing);
+
+			Entity ground = createEntity("Ground", 0);
+			auto& groundTransform = ground.GetComponent<TransformComponent>();
+			groundTransform.Translation = { 0.0f, -halfExtent.y, 0.0f };
+			groundTransform.Scale = { width, 1.0f, 1.0f };
+			ground.AddComponent<SpriteRendererComponent>();
+			ground.AddComponent<Rigidbody2DComponent>().Type = Rigidbody2DComponent::BodyType::Static;
+			ground.AddComponent<BoxCollider2DComponent>();
+
+			for (uint32_t i = 0; i < specification.RigidbodyCount; i++)
+			{
+				Entity entity = createEntity("Rigidbody", i);
+				auto& transform = entity.GetComponent<TransformComponent>();
+				transform.Translation = { ((float)(i % columns) - columns * 0.5f) * spacing, -halfExtent.y + 2.0f + (i / columns) * spacing, 0.0f };
+				transform.Rotation.z = rigidbodyRandom.Range(0.0f, glm::two_pi<float>());
+
+				entity.AddComponent<Rigidbody2DComponent>().Type = Rigidbody2DComponent::BodyType::Dynamic;
+				if (rigidbodyRandom.Index(2) == 0)
+				{
+					entity.AddComponent<BoxCollider2DComponent>();
+					addSprite(entity, rigidbodyRandom);
+				}
+				else
+				{
+					entity.AddComponent<CircleCollider2DComponent>();
+					entity.AddComponent<CircleRendererComponent>().Color = rigidbodyRandom.Color();
+				}
+			}
+		}
+
+		uint32_t scriptCount = specification.ScriptCount;
+		if (scriptCount > 0 && specification.ScriptClass.empty())
+		{
+			HZ_CORE_WARN("SceneGenerator: no script class given, scripted entities are skipped");
+			scriptCount = 0;
+		}
+
+		Utils::Random scriptRandom(specification.Seed, 5);
+		for (uint32_t i = 0; i < scriptCount; i++)
+		{
+			Entity entity = createEntity("Script", i);
+			place(entity, scriptRandom);
+			addSprite(entity, scriptRandom);
+			entity.AddComponent<ScriptComponent>().ClassName = specification.ScriptClass;
+		}
+
+		// Trees are filled level by level until the count is reached, the last tree may be partial
+		Utils::Random hierarchyRandom(specification.Seed, 6);
+		std::vector<std::pair<Entity, uint32_t>> level;
+		uint32_t hierarchyIndex = 0;
+		while (hierarchyIndex < specification.HierarchyCount)
+		{
+			Entity root = createEntity("Node", hierarchyIndex++);
+			place(root, hierarchyRandom);
+			addSprite(root, hierarchyRandom);
+
+			level.clear();
+			level.push_back({ root, 1 });
+			for (size_t i = 0; i < level.size() && hierarchyIndex < specification.HierarchyCount; i++)
+			{
+				auto [parent, depth] = level[i];
+				if (depth >= specification.HierarchyDepth)
+					continue;
+
+				for (uint32_t c = 0; c < specification.HierarchyChildren && hierarchyIndex < specification.HierarchyCount; c++)
+				{
+					Entity child = createEntity("Node", hierarchyIndex++);
+					auto& transform = child.GetComponent<TransformComponent>();
+					transform.Translation = { hierarchyRandom.Range(-2.0f, 2.0f), hierarchyRandom.Range(-2.0f, 2.0f), 0.0f };
+					transform.Rotation.z = hierarchyRandom.Range(0.0f, glm::two_pi<float>());
+					addSprite(child, hierarchyRandom);
+
+					scene->SetParent(child, parent);
+					level.push_back({ child, depth + 1 });
+				}
+			}
+		}
+
+		return scene;
+	}
+
+	bool SceneGenerator::LoadSpecification(const std::filesystem::path& filepath, SceneGeneratorSpecification& specification)
+	{
+		YAML::Node data;
+		try
+		{
+			data = YAML::LoadFile(filepath.string());
+		}
+		catch (YAML::Exception e)
+		{
+			HZ_CORE_ERROR("Failed to load scene generator file '{0}'\n     {1}", filepath.string(), e.what());
+			return false;
+		}
+
+		auto generatorNode = data["SceneGenerator"];
+		if (!generatorNode)
+			return false;
+
+		auto read = [&](const char* key, auto& value)
+		{
+			if (auto node = generatorNode[key])
+				value = node.as<std::remove_reference_t<decltype(value)>>();
+		};
+
+		read("Seed", specification.Seed);
+		if (auto extent = generatorNode["Extent"])
+			specification.Extent = { extent[0].as<float>(), extent[1].as<float>() };
+
+		read("SpriteCount", specification.SpriteCount);
+		if (auto textures = generatorNode["Textures"])
+		{
+			specification.Textures.clear();
+			for (auto texture : textures)
+				specification.Textures.push_back(texture.as<std::string>());
+		}
+
+		read("CircleCount", specification.CircleCount);
+		read("TextCount", specification.TextCount);
+		read("RigidbodyCount", specification.RigidbodyCount);
+		read("ScriptCount", specification.ScriptCount);
+		read("ScriptClass", specification.ScriptClass);
+		read("HierarchyCount", specification.HierarchyCount);
+		read("HierarchyDepth", specification.HierarchyDepth);
+		read("HierarchyChildren", specification.HierarchyChildren);
+		return true;
+	}
+
+}
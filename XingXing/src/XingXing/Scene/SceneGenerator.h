@@ -0,0 +1,53 @@
+#pragma once
+
+#include "XingXing/Core/Base.h"
+
+#include <glm/glm.hpp>
+
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace Hazel {
+
+	class Scene;
+
+	// How many entities of each kind a generated scene has. Entities are spread at random over
+	// Extent around the origin; the same specification and seed always give the same scene.
+	struct SceneGeneratorSpecification
+	{
+		uint64_t Seed = 1;
+		glm::vec2 Extent = { 1000.0f, 1000.0f };
+
+		uint32_t SpriteCount = 10000;
+		// Paths relative to the asset directory, sprites pick one at random. Without textures sprites are plain colors.
+		std::vector<std::filesystem::path> Textures;
+
+		uint32_t CircleCount = 0;
+		uint32_t TextCount = 0;
+
+		// Dynamic boxes and circles on a grid above a static ground, so they don't start out overlapping
+		uint32_t RigidbodyCount = 0;
+
+		// Entities with a ScriptComponent of ScriptClass
+		uint32_t ScriptCount = 0;
+		std::string ScriptClass;
+
+		// Sprites grouped into trees, every parent has HierarchyChildren children down to HierarchyDepth levels
+		uint32_t HierarchyCount = 0;
+		uint32_t HierarchyDepth = 4;
+		uint32_t HierarchyChildren = 4;
+	};
+
+	// Builds large scenes for stress tests and benchmarks. Textures are loaded through the active project,
+	// so there has to be one when the specification lists textures.
+	class SceneGenerator
+	{
+	public:
+		static Ref<Scene> Generate(const SceneGeneratorSpecification& specification);
+
+		// Reads a parameter file (.hgen), fields that are left out keep their defaults
+		static bool LoadSpecification(const std::filesystem::path& filepath, SceneGeneratorSpecification& specification);
+	};
+
+}
@@ -7,6 +7,7 @@
 #include "XingXing/Core/UUID.h"
 
 #include "XingXing/Project/Project.h"
+#include "XingXing/Renderer/TextureAtlas.h"
 
 #include <fstream>
 
@@ -167,17 +168,39 @@ namespace Hazel {
 		return Rigidbody2DComponent::BodyType::Static;
 	}
 
+	static void SerializeUpdateLODSettings(YAML::Emitter& out, const UpdateLODSettings& settings)
+	{
+		out << YAML::Key << "ReducedDistance" << YAML::Value << settings.ReducedDistance;
+		out << YAML::Key << "SuspendDistance" << YAML::Value << settings.SuspendDistance;
+		out << YAML::Key << "ReducedInterval" << YAML::Value << settings.ReducedInterval;
+		out << YAML::Key << "ReduceOffscreen" << YAML::Value << settings.ReduceOffscreen;
+		out << YAML::Key << "SleepSuspendedBodies" << YAML::Value << settings.SleepSuspendedBodies;
+	}
+
+	static UpdateLODSettings DeserializeUpdateLODSettings(const YAML::Node& node)
+	{
+		UpdateLODSettings settings;
+		settings.ReducedDistance = node["ReducedDistance"].as<float>();
+		settings.SuspendDistance = node["SuspendDistance"].as<float>();
+		settings.ReducedInterval = node["ReducedInterval"].as<uint32_t>();
+		settings.ReduceOffscreen = node["ReduceOffscreen"].as<bool>();
+		settings.SleepSuspendedBodies = node["SleepSuspendedBodies"].as<bool>();
+		return settings;
+	}
+
 	SceneSerializer::SceneSerializer(const Ref<Scene>& scene)
 		: m_Scene(scene)
 	{
 	}
 
-	static void SerializeEntity(YAML::Emitter& out, Entity entity)
+	void SceneSerializer::SerializeEntity(YAML::Emitter& out, Entity entity)
 	{
 		HZ_CORE_ASSERT(entity.HasComponent<IDComponent>());
 
 		out << YAML::BeginMap; // Entity
 		out << YAML::Key << "Entity" << YAML::Value << entity.GetUUID();
+		if (!entity.IsActive())
+			out << YAML::Key << "Active" << YAML::Value << false;
 
 		if (entity.HasComponent<TagComponent>())
 		{
@@ -203,6 +226,24 @@ namespace Hazel {
 			out << YAML::EndMap; // TransformComponent
 		}
 
+		if (entity.HasComponent<RelationshipComponent>())
+		{
+			auto& relationship = entity.GetComponent<RelationshipComponent>();
+			if (relationship.Parent != 0 || !relationship.Children.empty())
+			{
+				out << YAML::Key << "RelationshipComponent";
+				out << YAML::BeginMap; // RelationshipComponent
+
+				out << YAML::Key << "Parent" << YAML::Value << (uint64_t)relationship.Parent;
+				out << YAML::Key << "Children" << YAML::Value << YAML::Flow << YAML::BeginSeq;
+				for (UUID child : relationship.Children)
+					out << (uint64_t)child;
+				out << YAML::EndSeq;
+
+				out << YAML::EndMap; // RelationshipComponent
+			}
+		}
+
 		if (entity.HasComponent<CameraComponent>())
 		{
 			out << YAML::Key << "CameraComponent";
@@ -290,8 +331,12 @@ namespace Hazel {
 
 			auto& spriteRendererComponent = entity.GetComponent<SpriteRendererComponent>();
 			out << YAML::Key << "Color" << YAML::Value << spriteRendererComponent.Color;
-			if (spriteRendererComponent.Texture)
-				out << YAML::Key << "TexturePath" << YAML::Value << spriteRendererComponent.Texture->GetPath();
+			// Atlas entries keep the path of their source image, so the scene does not depend on the atlas layout
+			SubTexture2D* subTexture = spriteRendererComponent.SubTexture ? AssetTable<SubTexture2D>::Get(spriteRendererComponent.SubTexture) : nullptr;
+			if (subTexture && !subTexture->GetPath().empty())
+				out << YAML::Key << "TexturePath" << YAML::Value << subTexture->GetPath();
+			else if (spriteRendererComponent.Texture)
+				out << YAML::Key << "TexturePath" << YAML::Value << AssetTable<Texture2D>::Get(spriteRendererComponent.Texture)->GetPath();
 
 			out << YAML::Key << "TilingFactor" << YAML::Value << spriteRendererComponent.TilingFactor;
 
@@ -370,6 +415,14 @@ namespace Hazel {
 			out << YAML::EndMap; // TextComponent
 		}
 
+		if (entity.HasComponent<UpdateLODComponent>())
+		{
+			out << YAML::Key << "UpdateLODComponent";
+			out << YAML::BeginMap; // UpdateLODComponent
+			SerializeUpdateLODSettings(out, entity.GetComponent<UpdateLODComponent>().Settings);
+			out << YAML::EndMap; // UpdateLODComponent
+		}
+
 		out << YAML::EndMap; // Entity
 	}
 
@@ -378,6 +431,42 @@ namespace Hazel {
 		YAML::Emitter out;
 		out << YAML::BeginMap;
 		out << YAML::Key << "Scene" << YAML::Value << "Untitled";
+
+		out << YAML::Key << "FixedTimestep" << YAML::Value << m_Scene->GetFixedTimestep();
+		out << YAML::Key << "MaxSubsteps" << YAML::Value << m_Scene->GetMaxSubsteps();
+
+		const auto& scriptUpdateLODs = m_Scene->GetScriptUpdateLODs();
+		if (!scriptUpdateLODs.empty())
+		{
+			// Sorted, the map's order changes from run to run
+			std::vector<const std::string*> classNames;
+			for (const auto& [className, settings] : scriptUpdateLODs)
+				classNames.push_back(&className);
+			std::sort(classNames.begin(), classNames.end(), [](const std::string* a, const std::string* b) { return *a < *b; });
+
+			out << YAML::Key << "ScriptUpdateLOD" << YAML::Value << YAML::BeginSeq;
+			for (const std::string* className : classNames)
+			{
+				out << YAML::BeginMap;
+				out << YAML::Key << "Class" << YAML::Value << *className;
+				SerializeUpdateLODSettings(out, scriptUpdateLODs.at(*className));
+				out << YAML::EndMap;
+			}
+			out << YAML::EndSeq;
+		}
+
+		const WorldPartitionSpecification& world = m_Scene->GetWorldSpecification();
+		if (!world.WorldPath.empty())
+		{
+			out << YAML::Key << "World";
+			out << YAML::BeginMap; // World
+			out << YAML::Key << "Path" << YAML::Value << world.WorldPath.string();
+			out << YAML::Key << "LoadRadius" << YAML::Value << world.LoadRadius;
+			out << YAML::Key << "UnloadRadius" << YAML::Value << world.UnloadRadius;
+			out << YAML::Key << "EntitiesPerFrame" << YAML::Value << world.EntitiesPerFrame;
+			out << YAML::EndMap; // World
+		}
+
 		out << YAML::Key << "Entities" << YAML::Value << YAML::BeginSeq;
 		m_Scene->m_Registry.each([&](auto entityID)
 		{
@@ -394,10 +483,18 @@ namespace Hazel {
 		fout << out.c_str();
 	}
 
+	static constexpr char s_SnapshotMagic[4] = { 'H', 'Z', 'S', 'S' };
+	static constexpr uint32_t s_SnapshotVersion = 1;
+
 	void SceneSerializer::SerializeRuntime(const std::string& filepath)
 	{
-		// Not implemented
-		HZ_CORE_ASSERT(false);
+		std::vector<uint8_t> snapshot;
+		SceneSnapshot::Capture(*m_Scene, snapshot);
+
+		std::ofstream fout(filepath, std::ios::binary);
+		fout.write(s_SnapshotMagic, sizeof(s_SnapshotMagic));
+		fout.write((const char*)&s_SnapshotVersion, sizeof(s_SnapshotVersion));
+		fout.write((const char*)snapshot.data(), snapshot.size());
 	}
 
 	bool SceneSerializer::Deserialize(const std::string& filepath)
@@ -419,6 +516,28 @@ namespace Hazel {
 		std::string sceneName = data["Scene"].as<std::string>();
 		HZ_CORE_TRACE("Deserializing scene '{0}'", sceneName);
 
+		if (auto fixedTimestep = data["FixedTimestep"])
+			m_Scene->SetFixedTimestep(fixedTimestep.as<float>());
+		if (auto maxSubsteps = data["MaxSubsteps"])
+			m_Scene->SetMaxSubsteps(std::max(maxSubsteps.as<uint32_t>(), 1u));
+
+		if (auto scriptUpdateLODs = data["ScriptUpdateLOD"])
+		{
+			for (auto lodNode : scriptUpdateLODs)
+				m_Scene->SetScriptUpdateLOD(lodNode["Class"].as<std::string>(), DeserializeUpdateLODSettings(lodNode));
+		}
+
+		auto worldNode = data["World"];
+		if (worldNode)
+		{
+			WorldPartitionSpecification world;
+			world.WorldPath = worldNode["Path"].as<std::string>();
+			world.LoadRadius = worldNode["LoadRadius"].as<int32_t>();
+			world.UnloadRadius = worldNode["UnloadRadius"].as<int32_t>();
+			world.EntitiesPerFrame = worldNode["EntitiesPerFrame"].as<uint32_t>();
+			m_Scene->SetWorldSpecification(world);
+		}
+
 		auto entities = data["Entities"];
 		if (entities)
 		{
@@ -434,171 +553,241 @@ namespace Hazel {
 				HZ_CORE_TRACE("Deserialized entity with ID = {0}, name = {1}", uuid, name);
 
 				Entity deserializedEntity = m_Scene->CreateEntityWithUUID(uuid, name);
+				DeserializeEntity(entity, deserializedEntity);
+			}
+		}
 
-				auto transformComponent = entity["TransformComponent"];
-				if (transformComponent)
-				{
-					// Entities always have transforms
-					auto& tc = deserializedEntity.GetComponent<TransformComponent>();
-					tc.Translation = transformComponent["Translation"].as<glm::vec3>();
-					tc.Rotation = transformComponent["Rotation"].as<glm::vec3>();
-					tc.Scale = transformComponent["Scale"].as<glm::vec3>();
-				}
+		m_Scene->RebuildHierarchy();
 
-				auto cameraComponent = entity["CameraComponent"];
-				if (cameraComponent)
-				{
-					auto& cc = deserializedEntity.AddComponent<CameraComponent>();
+		return true;
+	}
 
-					auto& cameraProps = cameraComponent["Camera"];
-					cc.Camera.SetProjectionType((SceneCamera::ProjectionType)cameraProps["ProjectionType"].as<int>());
+	void SceneSerializer::DeserializeEntity(YAML::Node node, Entity entity)
+	{
+		DeserializeComponents(node, entity);
+		DeserializeReferences(node, entity);
+	}
 
-					cc.Camera.SetPerspectiveVerticalFOV(cameraProps["PerspectiveFOV"].as<float>());
-					cc.Camera.SetPerspectiveNearClip(cameraProps["PerspectiveNear"].as<float>());
-					cc.Camera.SetPerspectiveFarClip(cameraProps["PerspectiveFar"].as<float>());
+	void SceneSerializer::DeserializeComponents(YAML::Node node, Entity entity)
+	{
+		if (auto active = node["Active"]; active && !active.as<bool>())
+			entity.SetActive(false);
 
-					cc.Camera.SetOrthographicSize(cameraProps["OrthographicSize"].as<float>());
-					cc.Camera.SetOrthographicNearClip(cameraProps["OrthographicNear"].as<float>());
-					cc.Camera.SetOrthographicFarClip(cameraProps["OrthographicFar"].as<float>());
+		auto transformComponent = node["TransformComponent"];
+		if (transformComponent)
+		{
+			// Entities always have transforms
+			auto& tc = entity.GetComponent<TransformComponent>();
+			tc.Translation = transformComponent["Translation"].as<glm::vec3>();
+			tc.Rotation = transformComponent["Rotation"].as<glm::vec3>();
+			tc.Scale = transformComponent["Scale"].as<glm::vec3>();
+		}
 
-					cc.Primary = cameraComponent["Primary"].as<bool>();
-					cc.FixedAspectRatio = cameraComponent["FixedAspectRatio"].as<bool>();
-				}
+		auto relationshipComponent = node["RelationshipComponent"];
+		if (relationshipComponent)
+		{
+			// Resolved by the scene once all entities exist
+			auto& relationship = entity.GetComponent<RelationshipComponent>();
+			relationship.Parent = relationshipComponent["Parent"].as<uint64_t>();
+			for (auto child : relationshipComponent["Children"])
+				relationship.Children.push_back(child.as<uint64_t>());
+		}
 
-				auto scriptComponent = entity["ScriptComponent"];
-				if (scriptComponent)
-				{
-					auto& sc = deserializedEntity.AddComponent<ScriptComponent>();
-					sc.ClassName = scriptComponent["ClassName"].as<std::string>();
+		auto cameraComponent = node["CameraComponent"];
+		if (cameraComponent)
+		{
+			auto& cc = entity.AddComponent<CameraComponent>();
 
-					auto scriptFields = scriptComponent["ScriptFields"];
-					if (scriptFields)
-					{
-						Ref<ScriptClass> entityClass = ScriptEngine::GetEntityClass(sc.ClassName);
-						if (entityClass)
-						{
-							const auto& fields = entityClass->GetFields();
-							auto& entityFields = ScriptEngine::GetScriptFieldMap(deserializedEntity);
-
-							for (auto scriptField : scriptFields)
-							{
-								std::string name = scriptField["Name"].as<std::string>();
-								std::string typeString = scriptField["Type"].as<std::string>();
-								ScriptFieldType type = Utils::ScriptFieldTypeFromString(typeString);
-
-								ScriptFieldInstance& fieldInstance = entityFields[name];
-
-								// TODO(Yan): turn this assert into Hazelnut log warning
-								HZ_CORE_ASSERT(fields.find(name) != fields.end());
-
-								if (fields.find(name) == fields.end())
-									continue;
-
-								fieldInstance.Field = fields.at(name);
-
-								switch (type)
-								{
-									READ_SCRIPT_FIELD(Float, float);
-									READ_SCRIPT_FIELD(Double, double);
-									READ_SCRIPT_FIELD(Bool, bool);
-									READ_SCRIPT_FIELD(Char, char);
-									READ_SCRIPT_FIELD(Byte, int8_t);
-									READ_SCRIPT_FIELD(Short, int16_t);
-									READ_SCRIPT_FIELD(Int, int32_t);
-									READ_SCRIPT_FIELD(Long, int64_t);
-									READ_SCRIPT_FIELD(UByte, uint8_t);
-									READ_SCRIPT_FIELD(UShort, uint16_t);
-									READ_SCRIPT_FIELD(UInt, uint32_t);
-									READ_SCRIPT_FIELD(ULong, uint64_t);
-									READ_SCRIPT_FIELD(Vector2, glm::vec2);
-									READ_SCRIPT_FIELD(Vector3, glm::vec3);
-									READ_SCRIPT_FIELD(Vector4, glm::vec4);
-									READ_SCRIPT_FIELD(Entity, UUID);
-								}
-							}
-						}
-					}
+			auto& cameraProps = cameraComponent["Camera"];
+			cc.Camera.SetProjectionType((SceneCamera::ProjectionType)cameraProps["ProjectionType"].as<int>());
 
-				}
+			cc.Camera.SetPerspectiveVerticalFOV(cameraProps["PerspectiveFOV"].as<float>());
+			cc.Camera.SetPerspectiveNearClip(cameraProps["PerspectiveNear"].as<float>());
+			cc.Camera.SetPerspectiveFarClip(cameraProps["PerspectiveFar"].as<float>());
 
-				auto spriteRendererComponent = entity["SpriteRendererComponent"];
-				if (spriteRendererComponent)
+			cc.Camera.SetOrthographicSize(cameraProps["OrthographicSize"].as<float>());
+			cc.Camera.SetOrthographicNearClip(cameraProps["OrthographicNear"].as<float>());
+			cc.Camera.SetOrthographicFarClip(cameraProps["OrthographicFar"].as<float>());
+
+			cc.Primary = cameraComponent["Primary"].as<bool>();
+			cc.FixedAspectRatio = cameraComponent["FixedAspectRatio"].as<bool>();
+		}
+
+		auto scriptComponent = node["ScriptComponent"];
+		if (scriptComponent)
+			entity.AddComponent<ScriptComponent>().ClassName = scriptComponent["ClassName"].as<std::string>();
+
+		auto spriteRendererComponent = node["SpriteRendererComponent"];
+		if (spriteRendererComponent)
+		{
+			auto& src = entity.AddComponent<SpriteRendererComponent>();
+			src.Color = spriteRendererComponent["Color"].as<glm::vec4>();
+			if (spriteRendererComponent["TilingFactor"])
+				src.TilingFactor = spriteRendererComponent["TilingFactor"].as<float>();
+		}
+
+		auto circleRendererComponent = node["CircleRendererComponent"];
+		if (circleRendererComponent)
+		{
+			auto& crc = entity.AddComponent<CircleRendererComponent>();
+			crc.Color = circleRendererComponent["Color"].as<glm::vec4>();
+			crc.Thickness = circleRendererComponent["Thickness"].as<float>();
+			crc.Fade = circleRendererComponent["Fade"].as<float>();
+		}
+
+		auto rigidbody2DComponent = node["Rigidbody2DComponent"];
+		if (rigidbody2DComponent)
+		{
+			auto& rb2d = entity.AddComponent<Rigidbody2DComponent>();
+			rb2d.Type = RigidBody2DBodyTypeFromString(rigidbody2DComponent["BodyType"].as<std::string>());
+			rb2d.FixedRotation = rigidbody2DComponent["FixedRotation"].as<bool>();
+		}
+
+		auto boxCollider2DComponent = node["BoxCollider2DComponent"];
+		if (boxCollider2DComponent)
+		{
+			auto& bc2d = entity.AddComponent<BoxCollider2DComponent>();
+			bc2d.Offset = boxCollider2DComponent["Offset"].as<glm::vec2>();
+			bc2d.Size = boxCollider2DComponent["Size"].as<glm::vec2>();
+			bc2d.Density = boxCollider2DComponent["Density"].as<float>();
+			bc2d.Friction = boxCollider2DComponent["Friction"].as<float>();
+			bc2d.Restitution = boxCollider2DComponent["Restitution"].as<float>();
+			bc2d.RestitutionThreshold = boxCollider2DComponent["RestitutionThreshold"].as<float>();
+		}
+
+		auto circleCollider2DComponent = node["CircleCollider2DComponent"];
+		if (circleCollider2DComponent)
+		{
+			auto& cc2d = entity.AddComponent<CircleCollider2DComponent>();
+			cc2d.Offset = circleCollider2DComponent["Offset"].as<glm::vec2>();
+			cc2d.Radius = circleCollider2DComponent["Radius"].as<float>();
+			cc2d.Density = circleCollider2DComponent["Density"].as<float>();
+			cc2d.Friction = circleCollider2DComponent["Friction"].as<float>();
+			cc2d.Restitution = circleCollider2DComponent["Restitution"].as<float>();
+			cc2d.RestitutionThreshold = circleCollider2DComponent["RestitutionThreshold"].as<float>();
+		}
+
+		auto textComponent = node["TextComponent"];
+		if (textComponent)
+		{
+			auto& tc = entity.AddComponent<TextComponent>();
+			tc.TextString = textComponent["TextString"].as<std::string>();
+			// tc.FontAsset // TODO
+			tc.Color = textComponent["Color"].as<glm::vec4>();
+			tc.Kerning = textComponent["Kerning"].as<float>();
+			tc.LineSpacing = textComponent["LineSpacing"].as<float>();
+		}
+
+		auto updateLODComponent = node["UpdateLODComponent"];
+		if (updateLODComponent)
+			entity.AddComponent<UpdateLODComponent>().Settings = DeserializeUpdateLODSettings(updateLODComponent);
+	}
+
+	void SceneSerializer::DeserializeReferences(YAML::Node node, Entity entity)
+	{
+		auto scriptComponent = node["ScriptComponent"];
+		if (scriptComponent)
+		{
+			const auto& sc = entity.GetComponent<ScriptComponent>();
+
+			auto scriptFields = scriptComponent["ScriptFields"];
+			if (scriptFields)
+			{
+				Ref<ScriptClass> entityClass = ScriptEngine::GetEntityClass(sc.ClassName);
+				if (entityClass)
 				{
-					auto& src = deserializedEntity.AddComponent<SpriteRendererComponent>();
-					src.Color = spriteRendererComponent["Color"].as<glm::vec4>();
-					if (spriteRendererComponent["TexturePath"])
+					const auto& fields = entityClass->GetFields();
+					auto& entityFields = ScriptEngine::GetScriptFieldMap(entity);
+
+					for (auto scriptField : scriptFields)
 					{
-						std::string texturePath = spriteRendererComponent["TexturePath"].as<std::string>();
-						auto path = Project::GetAssetFileSystemPath(texturePath);
-						src.Texture = Texture2D::Create(path.string());
-					}
+						std::string name = scriptField["Name"].as<std::string>();
+						std::string typeString = scriptField["Type"].as<std::string>();
+						ScriptFieldType type = Utils::ScriptFieldTypeFromString(typeString);
 
-					if (spriteRendererComponent["TilingFactor"])
-						src.TilingFactor = spriteRendererComponent["TilingFactor"].as<float>();
-				}
+						ScriptFieldInstance& fieldInstance = entityFields[name];
 
-				auto circleRendererComponent = entity["CircleRendererComponent"];
-				if (circleRendererComponent)
-				{
-					auto& crc = deserializedEntity.AddComponent<CircleRendererComponent>();
-					crc.Color = circleRendererComponent["Color"].as<glm::vec4>();
-					crc.Thickness = circleRendererComponent["Thickness"].as<float>();
-					crc.Fade = circleRendererComponent["Fade"].as<float>();
-				}
+						// TODO(Yan): turn this assert into Hazelnut log warning
+						HZ_CORE_ASSERT(fields.find(name) != fields.end());
 
-				auto rigidbody2DComponent = entity["Rigidbody2DComponent"];
-				if (rigidbody2DComponent)
-				{
-					auto& rb2d = deserializedEntity.AddComponent<Rigidbody2DComponent>();
-					rb2d.Type = RigidBody2DBodyTypeFromString(rigidbody2DComponent["BodyType"].as<std::string>());
-					rb2d.FixedRotation = rigidbody2DComponent["FixedRotation"].as<bool>();
-				}
+						if (fields.find(name) == fields.end())
+							continue;
 
-				auto boxCollider2DComponent = entity["BoxCollider2DComponent"];
-				if (boxCollider2DComponent)
-				{
-					auto& bc2d = deserializedEntity.AddComponent<BoxCollider2DComponent>();
-					bc2d.Offset = boxCollider2DComponent["Offset"].as<glm::vec2>();
-					bc2d.Size = boxCollider2DComponent["Size"].as<glm::vec2>();
-					bc2d.Density = boxCollider2DComponent["Density"].as<float>();
-					bc2d.Friction = boxCollider2DComponent["Friction"].as<float>();
-					bc2d.Restitution = boxCollider2DComponent["Restitution"].as<float>();
-					bc2d.RestitutionThreshold = boxCollider2DComponent["RestitutionThreshold"].as<float>();
-				}
+						fieldInstance.Field = fields.at(name);
 
-				auto circleCollider2DComponent = entity["CircleCollider2DComponent"];
-				if (circleCollider2DComponent)
-				{
-					auto& cc2d = deserializedEntity.AddComponent<CircleCollider2DComponent>();
-					cc2d.Offset = circleCollider2DComponent["Offset"].as<glm::vec2>();
-					cc2d.Radius = circleCollider2DComponent["Radius"].as<float>();
-					cc2d.Density = circleCollider2DComponent["Density"].as<float>();
-					cc2d.Friction = circleCollider2DComponent["Friction"].as<float>();
-					cc2d.Restitution = circleCollider2DComponent["Restitution"].as<float>();
-					cc2d.RestitutionThreshold = circleCollider2DComponent["RestitutionThreshold"].as<float>();
+						switch (type)
+						{
+							READ_SCRIPT_FIELD(Float, float);
+							READ_SCRIPT_FIELD(Double, double);
+							READ_SCRIPT_FIELD(Bool, bool);
+							READ_SCRIPT_FIELD(Char, char);
+							READ_SCRIPT_FIELD(Byte, int8_t);
+							READ_SCRIPT_FIELD(Short, int16_t);
+							READ_SCRIPT_FIELD(Int, int32_t);
+							READ_SCRIPT_FIELD(Long, int64_t);
+							READ_SCRIPT_FIELD(UByte, uint8_t);
+							READ_SCRIPT_FIELD(UShort, uint16_t);
+							READ_SCRIPT_FIELD(UInt, uint32_t);
+							READ_SCRIPT_FIELD(ULong, uint64_t);
+							READ_SCRIPT_FIELD(Vector2, glm::vec2);
+							READ_SCRIPT_FIELD(Vector3, glm::vec3);
+							READ_SCRIPT_FIELD(Vector4, glm::vec4);
+							READ_SCRIPT_FIELD(Entity, UUID);
+						}
+					}
 				}
+			}
 
-				auto textComponent = entity["TextComponent"];
-				if (textComponent)
+		}
+
+		auto spriteRendererComponent = node["SpriteRendererComponent"];
+		if (spriteRendererComponent)
+		{
+			auto& src = entity.GetComponent<SpriteRendererComponent>();
+			if (spriteRendererComponent["TexturePath"])
+			{
+				std::string texturePath = spriteRendererComponent["TexturePath"].as<std::string>();
+				auto path = Project::GetAssetFileSystemPath(texturePath);
+
+				Ref<TextureAtlas> spriteAtlas = Project::GetSpriteAtlas();
+				if (spriteAtlas)
+					src.SubTexture = AssetTable<SubTexture2D>::Add(spriteAtlas->GetSubTexture(path));
+
+				if (!src.SubTexture)
 				{
-					auto& tc = deserializedEntity.AddComponent<TextComponent>();
-					tc.TextString = textComponent["TextString"].as<std::string>();
-					// tc.FontAsset // TODO
-					tc.Color = textComponent["Color"].as<glm::vec4>();
-					tc.Kerning = textComponent["Kerning"].as<float>();
-					tc.LineSpacing = textComponent["LineSpacing"].as<float>();
+					// Sprites sharing an image share the texture
+					src.Texture = AssetTable<Texture2D>::Find(path.string());
+					if (!src.Texture)
+						src.Texture = AssetTable<Texture2D>::Add(Texture2D::Create(path.string()), path.string());
 				}
 			}
 		}
-
-		return true;
 	}
 
 	bool SceneSerializer::DeserializeRuntime(const std::string& filepath)
 	{
-		// Not implemented
-		HZ_CORE_ASSERT(false);
-		return false;
+		std::ifstream stream(filepath, std::ios::binary | std::ios::ate);
+		if (!stream)
+			return false;
+
+		size_t size = (size_t)stream.tellg();
+		stream.seekg(0, std::ios::beg);
+
+		char magic[4];
+		uint32_t version = 0;
+		if (size < sizeof(magic) + sizeof(version) || !stream.read(magic, sizeof(magic)) || !stream.read((char*)&version, sizeof(version)) ||
+			memcmp(magic, s_SnapshotMagic, sizeof(magic)) != 0 || version != s_SnapshotVersion)
+		{
+			HZ_CORE_ERROR("'{0}' is not a scene snapshot", filepath);
+			return false;
+		}
+
+		std::vector<uint8_t> snapshot(size - sizeof(magic) - sizeof(version));
+		stream.read((char*)snapshot.data(), snapshot.size());
+
+		// Only the state of entities the scene already has is restored
+		SceneSnapshot::Apply(*m_Scene, snapshot.data(), snapshot.size());
+		return true;
 	}
 
 }
@@ -2,6 +2,11 @@
 
 #include "Scene.h"
 
+namespace YAML {
+	class Emitter;
+	class Node;
+}
+
 namespace Hazel {
 
 	class SceneSerializer
@@ -10,10 +15,20 @@ namespace Hazel {
 		SceneSerializer(const Ref<Scene>& scene);
 
 		void Serialize(const std::string& filepath);
+		// Binary snapshot of a running scene's state, see SceneSnapshot
 		void SerializeRuntime(const std::string& filepath);
 
 		bool Deserialize(const std::string& filepath);
 		bool DeserializeRuntime(const std::string& filepath);
+
+		// Shared with prefab files. DeserializeEntity reads everything but the ID and tag into an existing entity.
+		static void SerializeEntity(YAML::Emitter& out, Entity entity);
+		static void DeserializeEntity(YAML::Node node, Entity entity);
+		// DeserializeEntity in two steps, so entities can be read on the job system: DeserializeComponents
+		// only writes to the entity's own scene, DeserializeReferences then resolves the sprite textures and
+		// script fields through the asset tables and the script engine, on the main thread.
+		static void DeserializeComponents(YAML::Node node, Entity entity);
+		static void DeserializeReferences(YAML::Node node, Entity entity);
 	private:
 		Ref<Scene> m_Scene;
 	};
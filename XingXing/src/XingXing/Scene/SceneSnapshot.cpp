@@ -0,0 +1,433 @@
+#include "hzpch.h"
+#include "XingXing/Scene/SceneSnapshot.h"
+
+#include "XingXing/Scene/Scene.h"
+#include "XingXing/Scene/Entity.h"
+#include "XingXing/Scene/Components.h"
+#include "XingXing/Scripting/ScriptEngine.h"
+#include "XingXing/Core/Timer.h"
+
+#include "box2d/b2_body.h"
+
+namespace Hazel {
+
+	// Per entity: UUID, flags, transform, then the optional blocks the flags announce. Every field is
+	// 4 or 8 bytes, so the whole snapshot can be delta encoded in 32-bit words.
+	enum SnapshotFlags : uint32_t
+	{
+		SnapshotFlags_Disabled  = 1 << 0,
+		SnapshotFlags_Rigidbody = 1 << 1,
+		SnapshotFlags_Script    = 1 << 2
+	};
+
+	struct SnapshotRigidbody
+	{
+		glm::vec2 Position;
+		float Angle;
+		glm::vec2 LinearVelocity;
+		float AngularVelocity;
+	};
+
+	namespace Utils {
+
+		template<typename T>
+		static void Write(std::vector<uint8_t>& data, const T& value)
+		{
+			size_t offset = data.size();
+			data.resize(offset + sizeof(T));
+			memcpy(data.data() + offset, &value, sizeof(T));
+		}
+
+		template<typename T>
+		static bool Read(const uint8_t*& data, const uint8_t* end, T& value)
+		{
+			if ((size_t)(end - data) < sizeof(T))
+				return false;
+
+			memcpy(&value, data, sizeof(T));
+			data += sizeof(T);
+			return true;
+		}
+
+	}
+
+	void SceneSnapshot::Capture(Scene& scene, std::vector<uint8_t>& data)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		entt::registry& registry = scene.m_Registry;
+		auto view = registry.view<IDComponent, TransformComponent>();
+
+		// The count is filled in at the end
+		data.clear();
+		Utils::Write(data, (uint32_t)0);
+
+		uint32_t count = 0;
+		for (auto e : view)
+		{
+			auto [id, transform] = view.get<IDComponent, TransformComponent>(e);
+
+			Ref<ScriptInstance> script;
+			if (registry.has<ScriptComponent>(e))
+				script = ScriptEngine::GetEntityScriptInstance(id.ID);
+
+			b2Body* body = nullptr;
+			if (auto* rb2d = registry.try_get<Rigidbody2DComponent>(e))
+				body = (b2Body*)rb2d->RuntimeBody;
+
+			uint32_t flags = 0;
+			if (registry.has<DisabledComponent>(e))
+				flags |= SnapshotFlags_Disabled;
+			if (body)
+				flags |= SnapshotFlags_Rigidbody;
+			if (script)
+				flags |= SnapshotFlags_Script;
+
+			Utils::Write(data, (uint64_t)id.ID);
+			Utils::Write(data, flags);
+			Utils::Write(data, transform.Translation);
+			Utils::Write(data, transform.Rotation);
+			Utils::Write(data, transform.Scale);
+
+			if (body)
+			{
+				SnapshotRigidbody rigidbody;
+				rigidbody.Position = { body->GetPosition().x, body->GetPosition().y };
+				rigidbody.Angle = body->GetAngle();
+				rigidbody.LinearVelocity = { body->GetLinearVelocity().x, body->GetLinearVelocity().y };
+				rigidbody.AngularVelocity = body->GetAngularVelocity();
+				Utils::Write(data, rigidbody);
+			}
+
+			if (script)
+			{
+				uint32_t fieldDataSize = script->GetFieldDataSize();
+				Utils::Write(data, fieldDataSize);
+
+				size_t offset = data.size();
+				data.resize(offset + fieldDataSize);
+				script->GetFieldData(data.data() + offset);
+			}
+
+			count++;
+		}
+
+		memcpy(data.data(), &count, sizeof(count));
+	}
+
+	uint32_t SceneSnapshot::Apply(Scene& scene, const uint8_t* data, size_t size)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		entt::registry& registry = scene.m_Registry;
+		const uint8_t* end = data + size;
+
+		uint32_t count = 0;
+		if (!Utils::Read(data, end, count))
+			return 0;
+
+		uint32_t restored = 0;
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint64_t uuid;
+			uint32_t flags;
+			glm::vec3 translation, rotation, scale;
+			if (!Utils::Read(data, end, uuid) || !Utils::Read(data, end, flags) ||
+				!Utils::Read(data, end, translation) || !Utils::Read(data, end, rotation) || !Utils::Read(data, end, scale))
+			{
+				HZ_CORE_ERROR("Scene snapshot is truncated");
+				return restored;
+			}
+
+			SnapshotRigidbody rigidbody;
+			if ((flags & SnapshotFlags_Rigidbody) && !Utils::Read(data, end, rigidbody))
+				return restored;
+
+			uint32_t fieldDataSize = 0;
+			const uint8_t* fieldData = nullptr;
+			if (flags & SnapshotFlags_Script)
+			{
+				if (!Utils::Read(data, end, fieldDataSize) || (size_t)(end - data) < fieldDataSize)
+					return restored;
+
+				fieldData = data;
+				data += fieldDataSize;
+			}
+
+			// Destroyed since the snapshot was taken
+			auto it = scene.m_EntityMap.find(uuid);
+			if (it == scene.m_EntityMap.end())
+				continue;
+
+			Entity entity = { it->second, &scene };
+
+			auto& transform = entity.GetComponent<TransformComponent>();
+			transform.Translation = translation;
+			transform.Rotation = rotation;
+			transform.Scale = scale;
+
+			scene.SetEntityActive(entity, !(flags & SnapshotFlags_Disabled));
+
+			if (flags & SnapshotFlags_Rigidbody)
+			{
+				auto* rb2d = registry.try_get<Rigidbody2DComponent>(entity);
+				if (b2Body* body = rb2d ? (b2Body*)rb2d->RuntimeBody : nullptr)
+				{
+					body->SetTransform(b2Vec2(rigidbody.Position.x, rigidbody.Position.y), rigidbody.Angle);
+					body->SetLinearVelocity(b2Vec2(rigidbody.LinearVelocity.x, rigidbody.LinearVelocity.y));
+					body->SetAngularVelocity(rigidbody.AngularVelocity);
+					body->SetAwake(true);
+
+					// No interpolation from wherever the body was before
+					rb2d->PreviousPosition = rigidbody.Position;
+					rb2d->PreviousAngle = rigidbody.Angle;
+				}
+			}
+
+			if (fieldData)
+			{
+				// Skipped if the class changed since, e.g. after an assembly reload
+				Ref<ScriptInstance> script = ScriptEngine::GetEntityScriptInstance(uuid);
+				if (script && script->GetFieldDataSize() == fieldDataSize)
+					script->SetFieldData(fieldData);
+			}
+
+			restored++;
+		}
+
+		return restored;
+	}
+
+	RewindBuffer::RewindBuffer(const RewindBufferSpecification& specification)
+		: m_Specification(specification)
+	{
+		HZ_CORE_ASSERT(m_Specification.Capacity > 0 && m_Specification.KeyframeInterval > 0);
+		m_Storage.resize(m_Specification.Capacity);
+	}
+
+	void RewindBuffer::Capture(Scene& scene, Timestep ts)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		Timer timer;
+
+		// Recording continues from a restored frame, the frames that followed it are history that didn't happen
+		while ((int64_t)m_Frames.size() > m_Cursor + 1)
+		{
+			m_Statistics.UsedBytes -= m_Frames.back().Size;
+			m_Frames.pop_back();
+		}
+		if (!m_Frames.empty())
+			m_Head = m_Frames.back().Offset + m_Frames.back().Size;
+
+		m_Time += ts;
+		SceneSnapshot::Capture(scene, m_Current);
+
+		bool keyframe = m_Frames.empty() || m_Previous.size() != m_Current.size() || m_FramesSinceKeyframe + 1 >= m_Specification.KeyframeInterval;
+		if (!keyframe)
+		{
+			EncodeDelta(m_Current, m_Previous, m_Delta);
+			// Nearly everything changed, the delta would only be larger
+			keyframe = m_Delta.size() >= m_Current.size();
+		}
+
+		Store(keyframe ? m_Current : m_Delta, keyframe);
+		std::swap(m_Previous, m_Current);
+
+		m_Statistics.LastSnapshotSize = (uint32_t)m_Previous.size();
+		m_Statistics.FrameCount = (uint32_t)m_Frames.size();
+		m_Statistics.RecordedSeconds = GetRecordedSeconds();
+		m_Statistics.LastCaptureTime = timer.ElapsedMillis();
+	}
+
+	void RewindBuffer::Store(const std::vector<uint8_t>& data, bool keyframe)
+	{
+		uint64_t offset;
+		if (!Allocate((uint32_t)data.size(), offset))
+		{
+			HZ_CORE_WARN("Scene snapshot of {0} bytes doesn't fit in the rewind buffer", data.size());
+			Clear();
+			return;
+		}
+
+		// Making room dropped the keyframe this delta builds on
+		if (!keyframe && m_Frames.empty())
+		{
+			Store(m_Current, true);
+			return;
+		}
+
+		memcpy(m_Storage.data() + offset, data.data(), data.size());
+
+		Frame& frame = m_Frames.emplace_back();
+		frame.Offset = offset;
+		frame.Size = (uint32_t)data.size();
+		frame.Time = m_Time;
+		frame.Keyframe = keyframe;
+
+		m_Head = offset + data.size();
+		m_Cursor = (int64_t)m_Frames.size() - 1;
+		m_FramesSinceKeyframe = keyframe ? 0 : m_FramesSinceKeyframe + 1;
+
+		m_Statistics.LastFrameSize = frame.Size;
+		m_Statistics.UsedBytes += frame.Size;
+	}
+
+	bool RewindBuffer::Allocate(uint32_t size, uint64_t& offset)
+	{
+		if (size > m_Storage.size())
+			return false;
+
+		// Frames are laid out oldest to newest around the ring, the space after the head holds the oldest
+		offset = m_Head;
+		if (offset + size > m_Storage.size())
+		{
+			// Not enough room before the end, whatever is still stored there goes first
+			while (!m_Frames.empty() && m_Frames.front().Offset >= m_Head)
+			{
+				m_Statistics.UsedBytes -= m_Frames.front().Size;
+				m_Frames.pop_front();
+				m_Cursor--;
+			}
+			offset = 0;
+		}
+
+		while (!m_Frames.empty())
+		{
+			const Frame& oldest = m_Frames.front();
+			if (oldest.Offset >= offset + size || oldest.Offset + oldest.Size <= offset)
+				break;
+
+			m_Statistics.UsedBytes -= oldest.Size;
+			m_Frames.pop_front();
+			m_Cursor--;
+		}
+
+		// Deltas without their keyframe can't be decoded anymore
+		while (!m_Frames.empty() && !m_Frames.front().Keyframe)
+		{
+			m_Statistics.UsedBytes -= m_Frames.front().Size;
+			m_Frames.pop_front();
+			m_Cursor--;
+		}
+
+		return true;
+	}
+
+	bool RewindBuffer::Rewind(Scene& scene, float seconds)
+	{
+		if (m_Frames.empty())
+			return false;
+
+		const float time = m_Frames.back().Time - seconds;
+		auto it = std::upper_bound(m_Frames.begin(), m_Frames.end(), time, [](float t, const Frame& frame) { return t < frame.Time; });
+		uint32_t frame = it == m_Frames.begin() ? 0 : (uint32_t)(it - m_Frames.begin()) - 1;
+		return RestoreFrame(scene, frame);
+	}
+
+	bool RewindBuffer::RestoreFrame(Scene& scene, uint32_t frame)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (frame >= m_Frames.size())
+			return false;
+
+		uint32_t keyframe = frame;
+		while (!m_Frames[keyframe].Keyframe)
+			keyframe--;
+
+		const Frame& key = m_Frames[keyframe];
+		m_Previous.assign(m_Storage.begin() + key.Offset, m_Storage.begin() + key.Offset + key.Size);
+		for (uint32_t i = keyframe + 1; i <= frame; i++)
+			ApplyDelta(m_Storage.data() + m_Frames[i].Offset, m_Frames[i].Size, m_Previous);
+
+		SceneSnapshot::Apply(scene, m_Previous.data(), m_Previous.size());
+
+		m_Cursor = frame;
+		m_FramesSinceKeyframe = frame - keyframe;
+		m_Time = m_Frames[frame].Time;
+		return true;
+	}
+
+	void RewindBuffer::Clear()
+	{
+		m_Frames.clear();
+		m_Previous.clear();
+		m_Head = 0;
+		m_Cursor = -1;
+		m_FramesSinceKeyframe = 0;
+		m_Statistics.UsedBytes = 0;
+		m_Statistics.FrameCount = 0;
+		m_Statistics.RecordedSeconds = 0.0f;
+	}
+
+	float RewindBuffer::GetRecordedSeconds() const
+	{
+		return m_Frames.empty() ? 0.0f : m_Frames.back().Time - m_Frames.front().Time;
+	}
+
+	// A delta is a sequence of runs: the number of unchanged words, the number of changed words, then
+	// the changed words XORed with the previous frame. Both counts are 16 bits, longer runs are split.
+	void RewindBuffer::EncodeDelta(const std::vector<uint8_t>& current, const std::vector<uint8_t>& previous, std::vector<uint8_t>& delta)
+	{
+		HZ_CORE_ASSERT(current.size() == previous.size() && current.size() % 4 == 0);
+
+		const uint32_t* currentWords = (const uint32_t*)current.data();
+		const uint32_t* previousWords = (const uint32_t*)previous.data();
+		const size_t wordCount = current.size() / 4;
+
+		delta.clear();
+		size_t i = 0;
+		while (i < wordCount)
+		{
+			uint16_t unchanged = 0;
+			while (i < wordCount && unchanged < UINT16_MAX && currentWords[i] == previousWords[i])
+			{
+				unchanged++;
+				i++;
+			}
+
+			size_t changedStart = i;
+			uint16_t changed = 0;
+			while (i < wordCount && changed < UINT16_MAX && currentWords[i] != previousWords[i])
+			{
+				changed++;
+				i++;
+			}
+
+			size_t offset = delta.size();
+			delta.resize(offset + 4 + changed * 4);
+			uint8_t* out = delta.data() + offset;
+			memcpy(out, &unchanged, 2);
+			memcpy(out + 2, &changed, 2);
+
+			uint32_t* outWords = (uint32_t*)(out + 4);
+			for (uint16_t j = 0; j < changed; j++)
+				outWords[j] = currentWords[changedStart + j] ^ previousWords[changedStart + j];
+		}
+	}
+
+	void RewindBuffer::ApplyDelta(const uint8_t* delta, uint32_t size, std::vector<uint8_t>& data)
+	{
+		uint32_t* words = (uint32_t*)data.data();
+		const uint8_t* end = delta + size;
+
+		size_t i = 0;
+		while (delta < end)
+		{
+			uint16_t unchanged, changed;
+			memcpy(&unchanged, delta, 2);
+			memcpy(&changed, delta + 2, 2);
+			delta += 4;
+
+			i += unchanged;
+			for (uint16_t j = 0; j < changed; j++, i++, delta += 4)
+			{
+				uint32_t word;
+				memcpy(&word, delta, 4);
+				words[i] ^= word;
+			}
+		}
+	}
+
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "XingXing/Core/Base.h"
+#include "XingXing/Core/Timestep.h"
+
+#include <deque>
+#include <vector>
+
+namespace Hazel {
+
+	class Scene;
+
+	// Binary snapshot of the state that changes while a scene runs: transforms, whether entities are
+	// active, rigidbody poses and velocities and the values of C# script fields. Structure is not
+	// captured, applying a snapshot only touches entities that still exist; native scripts are not captured.
+	class SceneSnapshot
+	{
+	public:
+		// Replaces the contents of data. The size is always a multiple of 4.
+		static void Capture(Scene& scene, std::vector<uint8_t>& data);
+		// Returns the number of entities that were restored
+		static uint32_t Apply(Scene& scene, const uint8_t* data, size_t size);
+	};
+
+	struct RewindBufferSpecification
+	{
+		// Oldest frames are dropped once the buffer is full, how many seconds fit depends on how much changes per frame
+		uint64_t Capacity = 64 * 1024 * 1024;
+		// Every this many frames a full snapshot is stored, the frames in between only store what changed
+		uint32_t KeyframeInterval = 60;
+	};
+
+	// Records a snapshot per frame into a fixed-size ring buffer, each delta encoded against the frame
+	// before it. Any recorded frame can be restored; capturing after a restore discards the frames that
+	// followed it, so the recording continues from the restored state.
+	class RewindBuffer
+	{
+	public:
+		struct Statistics
+		{
+			float LastCaptureTime = 0.0f; // ms
+			uint32_t LastFrameSize = 0; // Bytes stored for the last frame
+			uint32_t LastSnapshotSize = 0; // Bytes of the last frame before delta encoding
+			uint64_t UsedBytes = 0;
+			uint32_t FrameCount = 0;
+			float RecordedSeconds = 0.0f;
+		};
+	public:
+		RewindBuffer(const RewindBufferSpecification& specification = RewindBufferSpecification());
+
+		void Capture(Scene& scene, Timestep ts);
+
+		// Restores the last frame recorded at least seconds before the newest one, or the oldest frame
+		bool Rewind(Scene& scene, float seconds);
+		// 0 is the oldest recorded frame
+		bool RestoreFrame(Scene& scene, uint32_t frame);
+
+		void Clear();
+
+		uint32_t GetFrameCount() const { return (uint32_t)m_Frames.size(); }
+		float GetRecordedSeconds() const;
+		const Statistics& GetStatistics() const { return m_Statistics; }
+	private:
+		struct Frame
+		{
+			uint64_t Offset = 0;
+			uint32_t Size = 0;
+			float Time = 0.0f;
+			bool Keyframe = false;
+		};
+
+		// Finds room for size bytes, dropping the oldest frames it overlaps. Returns false if it can never fit.
+		bool Allocate(uint32_t size, uint64_t& offset);
+		void Store(const std::vector<uint8_t>& data, bool keyframe);
+
+		static void EncodeDelta(const std::vector<uint8_t>& current, const std::vector<uint8_t>& previous, std::vector<uint8_t>& delta);
+		static void ApplyDelta(const uint8_t* delta, uint32_t size, std::vector<uint8_t>& data);
+	private:
+		RewindBufferSpecification m_Specification;
+
+		std::vector<uint8_t> m_Storage;
+		std::deque<Frame> m_Frames;
+		uint64_t m_Head = 0;
+		float m_Time = 0.0f;
+
+		// The frame new captures are encoded against, and its index
+		std::vector<uint8_t> m_Previous;
+		int64_t m_Cursor = -1;
+		uint32_t m_FramesSinceKeyframe = 0;
+
+		std::vector<uint8_t> m_Current;
+		std::vector<uint8_t> m_Delta;
+
+		Statistics m_Statistics;
+	};
+
+}
@@ -18,6 +18,8 @@ namespace Hazel {
 		virtual void OnCreate() {}
 		virtual void OnDestroy() {}
 		virtual void OnUpdate(Timestep ts) {}
+		// Called at the scene's fixed timestep, before each physics step
+		virtual void OnFixedUpdate(Timestep ts) {}
 	private:
 		Entity m_Entity;
 		friend class Scene;
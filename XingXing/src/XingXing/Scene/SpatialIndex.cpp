@@ -0,0 +1,179 @@
+#include "hzpch.h"
+#include "XingXing/Scene/SpatialIndex.h"
+
+#include "box2d/b2_dynamic_tree.h"
+
+namespace Hazel {
+
+	namespace Utils {
+
+		static b2AABB ToBox2DAABB(const glm::vec2& min, const glm::vec2& max)
+		{
+			b2AABB aabb;
+			aabb.lowerBound.Set(min.x, min.y);
+			aabb.upperBound.Set(max.x, max.y);
+			return aabb;
+		}
+
+		static float DistanceSquaredToBox(const glm::vec2& point, const glm::vec2& min, const glm::vec2& max)
+		{
+			glm::vec2 closest = glm::clamp(point, min, max);
+			glm::vec2 delta = point - closest;
+			return glm::dot(delta, delta);
+		}
+
+	}
+
+	SpatialIndex::SpatialIndex()
+		: m_Tree(CreateScope<b2DynamicTree>())
+	{
+	}
+
+	SpatialIndex::~SpatialIndex() = default;
+
+	void SpatialIndex::Update(entt::entity entity, const glm::vec2& min, const glm::vec2& max)
+	{
+		b2AABB aabb = Utils::ToBox2DAABB(min, max);
+
+		auto it = m_Proxies.find(entity);
+		if (it == m_Proxies.end())
+		{
+			int32_t treeID = m_Tree->CreateProxy(aabb, (void*)(uintptr_t)entity);
+			m_Proxies[entity] = { treeID, min, max };
+			return;
+		}
+
+		Proxy& proxy = it->second;
+		if (proxy.Min == min && proxy.Max == max)
+			return;
+
+		// The displacement only enlarges the tree's box in the direction of movement
+		glm::vec2 displacement = (min + max - proxy.Min - proxy.Max) * 0.5f;
+		m_Tree->MoveProxy(proxy.TreeID, aabb, b2Vec2(displacement.x, displacement.y));
+		proxy.Min = min;
+		proxy.Max = max;
+	}
+
+	void SpatialIndex::Remove(entt::entity entity)
+	{
+		auto it = m_Proxies.find(entity);
+		if (it == m_Proxies.end())
+			return;
+
+		m_Tree->DestroyProxy(it->second.TreeID);
+		m_Proxies.erase(it);
+	}
+
+	void SpatialIndex::Clear()
+	{
+		m_Tree = CreateScope<b2DynamicTree>();
+		m_Proxies.clear();
+	}
+
+	template<typename Func>
+	void SpatialIndex::Query(const glm::vec2& min, const glm::vec2& max, Func func) const
+	{
+		struct Callback
+		{
+			const SpatialIndex* Index;
+			Func& Function;
+
+			bool QueryCallback(int32 treeID)
+			{
+				entt::entity entity = (entt::entity)(uintptr_t)Index->m_Tree->GetUserData(treeID);
+				Function(entity, Index->m_Proxies.at(entity));
+				return true;
+			}
+		};
+
+		Callback callback{ this, func };
+		m_Tree->Query(&callback, Utils::ToBox2DAABB(min, max));
+	}
+
+	void SpatialIndex::QueryAABB(const glm::vec2& min, const glm::vec2& max, std::vector<entt::entity>& result) const
+	{
+		Query(min, max, [&](entt::entity entity, const Proxy& proxy)
+		{
+			if (glm::all(glm::lessThanEqual(proxy.Min, max)) && glm::all(glm::lessThanEqual(min, proxy.Max)))
+				result.push_back(entity);
+		});
+	}
+
+	void SpatialIndex::QueryRadius(const glm::vec2& center, float radius, std::vector<entt::entity>& result) const
+	{
+		const float radiusSquared = radius * radius;
+		Query(center - radius, center + radius, [&](entt::entity entity, const Proxy& proxy)
+		{
+			if (Utils::DistanceSquaredToBox(center, proxy.Min, proxy.Max) <= radiusSquared)
+				result.push_back(entity);
+		});
+	}
+
+	void SpatialIndex::QueryPoint(const glm::vec2& point, std::vector<entt::entity>& result) const
+	{
+		Query(point, point, [&](entt::entity entity, const Proxy& proxy)
+		{
+			if (glm::all(glm::lessThanEqual(proxy.Min, point)) && glm::all(glm::lessThanEqual(point, proxy.Max)))
+				result.push_back(entity);
+		});
+	}
+
+	void SpatialIndex::QueryNearest(const glm::vec2& point, uint32_t count, std::vector<entt::entity>& result,
+		const std::function<bool(entt::entity)>& filter) const
+	{
+		if (count == 0 || m_Proxies.empty())
+			return;
+
+		count = glm::min(count, (uint32_t)m_Proxies.size());
+
+		// Grow a square around the point until it holds enough boxes. Everything closer than the
+		// count-th candidate lies within the search radius, so the closest ones are among them.
+		struct Candidate
+		{
+			float DistanceSquared;
+			entt::entity Entity;
+		};
+		std::vector<Candidate> candidates;
+
+		float radius = 1.0f;
+		while (true)
+		{
+			candidates.clear();
+			uint32_t found = 0;
+			const float radiusSquared = radius * radius;
+			Query(point - radius, point + radius, [&](entt::entity entity, const Proxy& proxy)
+			{
+				float distanceSquared = Utils::DistanceSquaredToBox(point, proxy.Min, proxy.Max);
+				if (distanceSquared > radiusSquared)
+					return;
+
+				found++;
+				if (!filter || filter(entity))
+					candidates.push_back({ distanceSquared, entity });
+			});
+
+			if (candidates.size() >= count)
+				break;
+
+			// Every box was found but too few passed the filter. Boxes that can't be measured,
+			// e.g. NaN positions, are never found.
+			if (found == m_Proxies.size() || std::isinf(radius))
+			{
+				count = (uint32_t)candidates.size();
+				break;
+			}
+
+			radius *= 2.0f;
+		}
+
+		std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end(), [](const Candidate& a, const Candidate& b)
+		{
+			return a.DistanceSquared < b.DistanceSquared;
+		});
+
+		result.reserve(result.size() + count);
+		for (uint32_t i = 0; i < count; i++)
+			result.push_back(candidates[i].Entity);
+	}
+
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "XingXing/Core/Base.h"
+#include "XingXing/Core/FlatHashMap.h"
+
+#include "entt.hpp"
+
+#include <glm/glm.hpp>
+
+#include <functional>
+#include <vector>
+
+class b2DynamicTree;
+
+namespace Hazel {
+
+	// World space bounding boxes of entities on the xy plane, kept in Box2D's dynamic AABB tree.
+	// The tree stores slightly enlarged boxes so small movements don't restructure it; queries
+	// test the exact boxes. All queries append to result.
+	class SpatialIndex
+	{
+	public:
+		SpatialIndex();
+		~SpatialIndex();
+
+		SpatialIndex(const SpatialIndex&) = delete;
+		SpatialIndex& operator=(const SpatialIndex&) = delete;
+
+		// Inserts the entity or moves its box
+		void Update(entt::entity entity, const glm::vec2& min, const glm::vec2& max);
+		void Remove(entt::entity entity);
+		void Clear();
+
+		bool Contains(entt::entity entity) const { return m_Proxies.find(entity) != m_Proxies.end(); }
+		uint32_t GetCount() const { return (uint32_t)m_Proxies.size(); }
+
+		void QueryAABB(const glm::vec2& min, const glm::vec2& max, std::vector<entt::entity>& result) const;
+		void QueryRadius(const glm::vec2& center, float radius, std::vector<entt::entity>& result) const;
+		void QueryPoint(const glm::vec2& point, std::vector<entt::entity>& result) const;
+		// The count entities whose boxes are closest to point, closest first. Entities the filter
+		// rejects are skipped and don't count.
+		void QueryNearest(const glm::vec2& point, uint32_t count, std::vector<entt::entity>& result,
+			const std::function<bool(entt::entity)>& filter = {}) const;
+	private:
+		struct Proxy
+		{
+			int32_t TreeID;
+			glm::vec2 Min, Max;
+		};
+
+		// Calls func(entity, proxy) for every proxy whose enlarged box overlaps [min, max]
+		template<typename Func>
+		void Query(const glm::vec2& min, const glm::vec2& max, Func func) const;
+	private:
+		Scope<b2DynamicTree> m_Tree;
+		FlatHashMap<entt::entity, Proxy> m_Proxies;
+	};
+
+}
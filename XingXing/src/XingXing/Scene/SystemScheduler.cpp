@@ -0,0 +1,152 @@
+#include "hzpch.h"
+#include "XingXing/Scene/SystemScheduler.h"
+
+namespace Hazel {
+
+	bool SystemAccess::ConflictsWith(const SystemAccess& other) const
+	{
+		if (m_Exclusive || other.m_Exclusive)
+			return true;
+
+		for (const Entry& entry : m_Entries)
+		{
+			for (const Entry& otherEntry : other.m_Entries)
+			{
+				if (entry.ID == otherEntry.ID && (entry.Write || otherEntry.Write))
+					return true;
+			}
+		}
+		return false;
+	}
+
+	SystemAccess& SystemAccess::AddResource(const std::string& name, bool write)
+	{
+		entt::id_type id = entt::hashed_string::value(name.c_str(), name.size());
+		m_Entries.push_back({ id, name, write, nullptr });
+		return *this;
+	}
+
+	std::string SystemAccess::GetTypeName(std::string_view name)
+	{
+		// MSVC: "struct Hazel::TransformComponent"
+		size_t pos = name.find_last_of(": ");
+		if (pos != std::string_view::npos)
+			name.remove_prefix(pos + 1);
+		return std::string(name);
+	}
+
+	void SystemScheduler::AddSystem(const std::string& name, const SystemAccess& access, const SystemFunction& function)
+	{
+		System& system = m_Systems.emplace_back();
+		system.Name = name;
+		system.Access = access;
+		system.Function = function;
+
+		m_GraphDirty = true;
+	}
+
+	void SystemScheduler::Clear()
+	{
+		m_Systems.clear();
+		m_GraphDirty = true;
+	}
+
+	void SystemScheduler::Execute(entt::registry& registry, Timestep ts)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (m_Systems.empty())
+			return;
+
+		if (m_GraphDirty)
+			BuildGraph();
+
+		for (const System& system : m_Systems)
+		{
+			for (const SystemAccess::Entry& entry : system.Access.GetEntries())
+			{
+				if (entry.Prepare)
+					entry.Prepare(registry);
+			}
+		}
+
+		for (uint32_t i = 0; i < m_Systems.size(); i++)
+			m_PendingDependencies[i] = (uint32_t)m_Systems[i].Dependencies.size();
+
+		m_ExecutionStart = std::chrono::steady_clock::now();
+
+		JobCounter counter;
+		for (uint32_t i = 0; i < m_Systems.size(); i++)
+		{
+			if (m_Systems[i].Dependencies.empty())
+				Launch(i, ts, counter);
+		}
+		JobSystem::Wait(counter);
+
+		m_ExecutionTime = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - m_ExecutionStart).count();
+	}
+
+	void SystemScheduler::BuildGraph()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		for (System& system : m_Systems)
+		{
+			system.Dependencies.clear();
+			system.Dependents.clear();
+		}
+
+		// Registration order decides which of two conflicting systems runs first
+		for (uint32_t i = 0; i < m_Systems.size(); i++)
+		{
+			for (uint32_t j = 0; j < i; j++)
+			{
+				if (m_Systems[i].Access.ConflictsWith(m_Systems[j].Access))
+				{
+					m_Systems[i].Dependencies.push_back(j);
+					m_Systems[j].Dependents.push_back(i);
+				}
+			}
+		}
+
+		m_PendingDependencies = CreateScope<std::atomic<uint32_t>[]>(m_Systems.size());
+		m_GraphDirty = false;
+	}
+
+	void SystemScheduler::Launch(uint32_t index, Timestep ts, JobCounter& counter)
+	{
+		auto job = [this, index, ts, &counter]()
+		{
+			Run(index, ts);
+
+			// Whichever dependency finishes last launches the system
+			for (uint32_t dependent : m_Systems[index].Dependents)
+			{
+				if (m_PendingDependencies[dependent].fetch_sub(1, std::memory_order_acq_rel) == 1)
+					Launch(dependent, ts, counter);
+			}
+		};
+
+		if (m_Systems[index].Access.IsMainThread())
+			JobSystem::ExecuteOnMainThread(job, &counter);
+		else
+			JobSystem::Execute(job, &counter);
+	}
+
+	void SystemScheduler::Run(uint32_t index, Timestep ts)
+	{
+		System& system = m_Systems[index];
+		HZ_PROFILE_SCOPE_DYNAMIC(system.Name.c_str());
+
+		auto start = std::chrono::steady_clock::now();
+		system.Function(ts);
+		auto end = std::chrono::steady_clock::now();
+
+		SystemTiming& timing = system.Timing;
+		timing.Start = std::chrono::duration<float, std::milli>(start - m_ExecutionStart).count();
+		timing.Duration = std::chrono::duration<float, std::milli>(end - start).count();
+		timing.AverageDuration = timing.AverageDuration * 0.95f + timing.Duration * 0.05f;
+		timing.WorkerIndex = JobSystem::GetWorkerIndex();
+	}
+
+}
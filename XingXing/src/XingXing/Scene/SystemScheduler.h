@@ -0,0 +1,153 @@
+#pragma once
+
+#include "XingXing/Core/Base.h"
+#include "XingXing/Core/Timestep.h"
+#include "XingXing/Core/JobSystem.h"
+
+#include "entt.hpp"
+
+#include <atomic>
+#include <limits>
+#include <typeinfo>
+
+namespace Hazel {
+
+	// What a system touches. Two systems conflict when one of them writes something the other
+	// reads or writes; systems without conflicts run in parallel.
+	class SystemAccess
+	{
+	public:
+		template<typename... Components>
+		SystemAccess& Read() { (AddComponent<Components>(false), ...); return *this; }
+		template<typename... Components>
+		SystemAccess& Write() { (AddComponent<Components>(true), ...); return *this; }
+
+		// Shared state outside the registry, e.g. the physics world
+		SystemAccess& ReadResource(const std::string& name) { return AddResource(name, false); }
+		SystemAccess& WriteResource(const std::string& name) { return AddResource(name, true); }
+
+		// May touch any component and create or destroy entities, e.g. scripts
+		SystemAccess& Exclusive() { m_Exclusive = true; return *this; }
+		// Has to run on the main thread, e.g. for the renderer or the script runtime
+		SystemAccess& MainThread() { m_MainThread = true; return *this; }
+
+		bool ConflictsWith(const SystemAccess& other) const;
+
+		bool IsExclusive() const { return m_Exclusive; }
+		bool IsMainThread() const { return m_MainThread; }
+
+		struct Entry
+		{
+			entt::id_type ID;
+			std::string Name;
+			bool Write;
+			// Creates the component pool up front, entt creates pools lazily which isn't thread safe
+			void(*Prepare)(entt::registry&);
+		};
+		const std::vector<Entry>& GetEntries() const { return m_Entries; }
+	private:
+		template<typename Component>
+		void AddComponent(bool write)
+		{
+			m_Entries.push_back({ entt::type_info<Component>::id(), GetTypeName(typeid(Component).name()), write,
+				[](entt::registry& registry) { registry.view<Component>(); } });
+		}
+
+		SystemAccess& AddResource(const std::string& name, bool write);
+
+		static std::string GetTypeName(std::string_view name);
+	private:
+		std::vector<Entry> m_Entries;
+		bool m_Exclusive = false;
+		bool m_MainThread = false;
+	};
+
+	using SystemFunction = std::function<void(Timestep)>;
+
+	// Runs a set of systems once per Execute. Each system waits for the systems registered before it
+	// that it conflicts with, everything else is spread over the job system.
+	class SystemScheduler
+	{
+	public:
+		struct SystemTiming
+		{
+			float Start = 0.0f; // ms since the start of Execute
+			float Duration = 0.0f; // ms
+			float AverageDuration = 0.0f; // ms
+			int32_t WorkerIndex = -1; // -1 for threads outside the job system
+		};
+
+		struct System
+		{
+			std::string Name;
+			SystemAccess Access;
+			SystemFunction Function;
+
+			// Indices of conflicting systems registered earlier and later
+			std::vector<uint32_t> Dependencies;
+			std::vector<uint32_t> Dependents;
+
+			SystemTiming Timing;
+		};
+	public:
+		void AddSystem(const std::string& name, const SystemAccess& access, const SystemFunction& function);
+		void Clear();
+
+		void Execute(entt::registry& registry, Timestep ts);
+
+		const std::vector<System>& GetSystems() const { return m_Systems; }
+		float GetExecutionTime() const { return m_ExecutionTime; }
+	private:
+		void BuildGraph();
+		void Launch(uint32_t index, Timestep ts, JobCounter& counter);
+		void Run(uint32_t index, Timestep ts);
+	private:
+		std::vector<System> m_Systems;
+		Scope<std::atomic<uint32_t>[]> m_PendingDependencies;
+		bool m_GraphDirty = true;
+
+		std::chrono::time_point<std::chrono::steady_clock> m_ExecutionStart;
+		float m_ExecutionTime = 0.0f;
+	};
+
+	// Calls func(entity, components...) for every entity that has all of Components and none of the excluded
+	// components, split into chunks over the job system. Like a view, it walks the smallest of the pools and
+	// checks the others through the view, so there are no registry lookups per entity. func must only touch
+	// the given entity's components. Excluding DisabledComponent skips disabled entities only, not their children.
+	template<typename... Components, typename Func, typename... Exclude>
+	void ParallelEach(entt::registry& registry, uint32_t grainSize, Func func, entt::exclude_t<Exclude...> exclude = {})
+	{
+		if constexpr (sizeof...(Components) == 1 && sizeof...(Exclude) == 0)
+		{
+			// Every entity of the pool is iterated, walk its arrays directly
+			auto view = registry.view<Components...>();
+			const entt::entity* entities = view.data();
+			auto* components = view.raw();
+
+			JobSystem::ParallelFor((uint32_t)view.size(), grainSize, [&](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t i = begin; i < end; i++)
+					func(entities[i], components[i]);
+			});
+		}
+		else
+		{
+			auto view = registry.view<Components...>(exclude);
+
+			const entt::entity* candidates = nullptr;
+			size_t count = std::numeric_limits<size_t>::max();
+			((view.template size<Components>() < count ? (void)(count = view.template size<Components>(), candidates = view.template data<Components>()) : (void)0), ...);
+
+			JobSystem::ParallelFor((uint32_t)count, grainSize, [&](uint32_t begin, uint32_t end)
+			{
+				for (uint32_t i = begin; i < end; i++)
+				{
+					entt::entity entity = candidates[i];
+					if (view.contains(entity))
+						func(entity, view.template get<Components>(entity)...);
+				}
+			});
+		}
+	}
+
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+
+namespace Hazel {
+
+	enum class UpdateLODTier : uint8_t
+	{
+		Full = 0, Reduced, Suspended
+	};
+
+	struct UpdateLODSettings
+	{
+		// Beyond ReducedDistance from the primary camera scripts update every ReducedInterval frames,
+		// with the time since their last update, beyond SuspendDistance not at all.
+		float ReducedDistance = 30.0f;
+		float SuspendDistance = 100.0f;
+		uint32_t ReducedInterval = 4;
+		// Entities outside the camera's view are at least Reduced
+		bool ReduceOffscreen = true;
+		// Suspended dynamic bodies are put to sleep, a collision wakes them up again
+		bool SleepSuspendedBodies = false;
+	};
+
+}
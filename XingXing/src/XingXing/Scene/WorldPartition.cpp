@@ -0,0 +1,448 @@
+#include "hzpch.h"
+#include "XingXing/Scene/WorldPartition.h"
+
+#include "XingXing/Scene/Scene.h"
+#include "XingXing/Scene/Entity.h"
+#include "XingXing/Scene/Components.h"
+#include "XingXing/Scene/SceneSerializer.h"
+#include "XingXing/Project/Project.h"
+#include "XingXing/Renderer/TextureAtlas.h"
+
+#include <fstream>
+#include <map>
+
+#include <yaml-cpp/yaml.h>
+
+namespace Hazel {
+
+	using StreamingClock = std::chrono::steady_clock;
+
+	struct WorldPartition::CellLoadRequest
+	{
+		std::filesystem::path Path;
+		StreamingClock::time_point RequestTime;
+
+		// Written by the load job, only read once Done is set. The entities are read into a staging scene
+		// of their own, in file order; integrating clones them into the streamed scene.
+		YAML::Node Entities;
+		Ref<Scene> Staging;
+		std::vector<entt::entity> StagedEntities;
+		// The sprite textures that aren't in the sprite atlas. Ones that are loaded already are decoded
+		// all the same, the job can't look at the asset table; they're dropped when integrating.
+		std::vector<std::pair<std::string, TextureImage>> Images;
+		bool Failed = false;
+		std::atomic<bool> Done = false;
+
+		// Integration progress. The uploaded textures are held until the cell's sprites refer to them.
+		size_t NextEntity = 0;
+		std::vector<Ref<Texture2D>> Textures;
+
+		~CellLoadRequest()
+		{
+			for (auto& [path, image] : Images)
+				Texture2D::FreeImage(image);
+		}
+
+		// Runs on the load job, see SceneSerializer::DeserializeComponents
+		void Stage()
+		{
+			HZ_PROFILE_FUNCTION();
+
+			// Untracked, the main thread may be releasing assets while the job fills it
+			Staging = Ref<Scene>(new Scene(false));
+			StagedEntities.reserve(Entities.size());
+
+			std::vector<std::string> texturePaths;
+			for (auto node : Entities)
+			{
+				std::string name;
+				auto tagComponent = node["TagComponent"];
+				if (tagComponent)
+					name = tagComponent["Tag"].as<std::string>();
+
+				Entity entity = Staging->CreateEntityWithUUID(node["Entity"].as<uint64_t>(), name);
+				SceneSerializer::DeserializeComponents(node, entity);
+				StagedEntities.push_back(entity);
+
+				auto spriteRendererComponent = node["SpriteRendererComponent"];
+				if (spriteRendererComponent && spriteRendererComponent["TexturePath"])
+					texturePaths.push_back(spriteRendererComponent["TexturePath"].as<std::string>());
+			}
+
+			std::sort(texturePaths.begin(), texturePaths.end());
+			texturePaths.erase(std::unique(texturePaths.begin(), texturePaths.end()), texturePaths.end());
+
+			// Resolved like SceneSerializer::DeserializeReferences does, atlas sprites need no texture of their own
+			Ref<TextureAtlas> spriteAtlas = Project::GetSpriteAtlas();
+			for (const std::string& texturePath : texturePaths)
+			{
+				std::filesystem::path path = Project::GetAssetFileSystemPath(texturePath);
+				if (spriteAtlas && spriteAtlas->GetSubTexture(path))
+					continue;
+
+				TextureImage image;
+				if (Texture2D::Decode(path.string(), image))
+					Images.emplace_back(path.string(), image);
+			}
+		}
+	};
+
+	WorldPartition::WorldPartition(Scene* scene, const WorldPartitionSpecification& specification)
+		: m_Scene(scene), m_Specification(specification)
+	{
+		if (Project::GetActive())
+			m_Specification.WorldPath = Project::GetAssetFileSystemPath(specification.WorldPath);
+
+		HZ_CORE_ASSERT(m_Specification.UnloadRadius >= m_Specification.LoadRadius, "Cells would be unloaded right after loading");
+	}
+
+	WorldPartition::~WorldPartition()
+	{
+		JobSystem::Wait(m_LoadCounter);
+	}
+
+	Scope<WorldPartition> WorldPartition::Create(Scene* scene, const WorldPartitionSpecification& specification)
+	{
+		Scope<WorldPartition> partition = CreateScope<WorldPartition>(scene, specification);
+		if (!partition->LoadIndex())
+			return nullptr;
+
+		return partition;
+	}
+
+	std::filesystem::path WorldPartition::GetCellPath(const std::filesystem::path& worldPath, int32_t x, int32_t y)
+	{
+		std::filesystem::path directory = worldPath.parent_path() / worldPath.stem();
+		return directory / ("Cell_" + std::to_string(x) + "_" + std::to_string(y) + ".hzcell");
+	}
+
+	bool WorldPartition::LoadIndex()
+	{
+		YAML::Node data;
+		try
+		{
+			data = YAML::LoadFile(m_Specification.WorldPath.string());
+		}
+		catch (YAML::Exception e)
+		{
+			HZ_CORE_ERROR("Failed to load world file '{0}'\n     {1}", m_Specification.WorldPath.string(), e.what());
+			return false;
+		}
+
+		if (!data["World"])
+		{
+			HZ_CORE_ERROR("'{0}' is not a world file", m_Specification.WorldPath.string());
+			return false;
+		}
+
+		m_CellSize = data["CellSize"].as<float>();
+
+		auto cells = data["Cells"];
+		m_Cells.reserve(cells.size());
+		for (auto cellNode : cells)
+		{
+			Cell cell;
+			cell.X = cellNode[0].as<int32_t>();
+			cell.Y = cellNode[1].as<int32_t>();
+			m_Cells[GetCellKey(cell.X, cell.Y)] = std::move(cell);
+		}
+
+		HZ_CORE_TRACE("Loaded world '{0}' with {1} cells", data["World"].as<std::string>(), m_Cells.size());
+		return true;
+	}
+
+	void WorldPartition::Update(const glm::vec3& focus)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		const int32_t focusX = (int32_t)glm::floor(focus.x / m_CellSize);
+		const int32_t focusY = (int32_t)glm::floor(focus.y / m_CellSize);
+
+		// Only the neighbourhood is looked up, the world can have many more cells than are ever resident
+		const int32_t loadRadius = m_Specification.LoadRadius;
+		for (int32_t y = focusY - loadRadius; y <= focusY + loadRadius; y++)
+		{
+			for (int32_t x = focusX - loadRadius; x <= focusX + loadRadius; x++)
+			{
+				auto it = m_Cells.find(GetCellKey(x, y));
+				if (it != m_Cells.end() && it->second.State == CellState::Unloaded)
+					RequestLoad(it->second);
+			}
+		}
+
+		m_Statistics.ResidentCells = 0;
+		m_Statistics.LoadingCells = 0;
+		m_Statistics.ResidentEntities = 0;
+		bool unloaded = false;
+		for (auto& [key, cell] : m_Cells)
+		{
+			if (cell.State == CellState::Unloaded)
+				continue;
+
+			int32_t distance = glm::max(glm::abs(cell.X - focusX), glm::abs(cell.Y - focusY));
+			if (distance > m_Specification.UnloadRadius)
+			{
+				Unload(cell);
+				unloaded = true;
+				continue;
+			}
+
+			if (cell.State == CellState::Loading && cell.Request->Done.load(std::memory_order_acquire))
+			{
+				cell.State = CellState::Integrating;
+				m_IntegrationQueue.push_back(key);
+			}
+		}
+
+		// Once for all the cells, the release looks at every scene's components
+		if (unloaded)
+			Scene::ReleaseUnusedAssets();
+
+		// Time-sliced, a cell that doesn't fit in this frame's budget continues in the next
+		uint32_t budget = m_Specification.EntitiesPerFrame;
+		while (budget > 0 && !m_IntegrationQueue.empty())
+		{
+			Cell& cell = m_Cells.at(m_IntegrationQueue.front());
+			budget -= Integrate(cell, budget);
+			if (cell.State != CellState::Resident)
+				break;
+
+			m_IntegrationQueue.pop_front();
+		}
+
+		for (auto& [key, cell] : m_Cells)
+		{
+			if (cell.State == CellState::Resident)
+			{
+				m_Statistics.ResidentCells++;
+				m_Statistics.ResidentEntities += (uint32_t)cell.Entities.size();
+			}
+			else if (cell.State != CellState::Unloaded)
+			{
+				m_Statistics.LoadingCells++;
+			}
+		}
+	}
+
+	void WorldPartition::UnloadAll()
+	{
+		for (auto& [key, cell] : m_Cells)
+		{
+			if (cell.State != CellState::Unloaded)
+				Unload(cell);
+		}
+
+		Scene::ReleaseUnusedAssets();
+	}
+
+	void WorldPartition::RequestLoad(Cell& cell)
+	{
+		Ref<CellLoadRequest> request = CreateRef<CellLoadRequest>();
+		request->Path = GetCellPath(m_Specification.WorldPath, cell.X, cell.Y);
+		request->RequestTime = StreamingClock::now();
+
+		cell.State = CellState::Loading;
+		cell.Request = request;
+
+		// Reading, parsing and decoding are the slow parts; the job keeps the request alive if the cell is unloaded meanwhile
+		JobSystem::Execute([request]()
+		{
+			try
+			{
+				YAML::Node data = YAML::LoadFile(request->Path.string());
+				request->Entities = data["Entities"];
+				request->Stage();
+			}
+			catch (YAML::Exception e)
+			{
+				HZ_CORE_ERROR("Failed to load world cell '{0}'\n     {1}", request->Path.string(), e.what());
+				request->Failed = true;
+			}
+
+			request->Done.store(true, std::memory_order_release);
+		}, &m_LoadCounter);
+	}
+
+	uint32_t WorldPartition::Integrate(Cell& cell, uint32_t budget)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		CellLoadRequest& request = *cell.Request;
+
+		// Uploaded up front, the sprites then find their textures in the asset table
+		for (auto& [path, image] : request.Images)
+		{
+			if (AssetTable<Texture2D>::Find(path))
+			{
+				Texture2D::FreeImage(image);
+				continue;
+			}
+
+			Ref<Texture2D> texture = Texture2D::Create(path, image);
+			AssetTable<Texture2D>::Add(texture, path);
+			request.Textures.push_back(texture);
+		}
+		request.Images.clear();
+
+		uint32_t created = 0;
+		const size_t entityCount = request.Failed ? 0 : request.StagedEntities.size();
+		while (created < budget && request.NextEntity < entityCount)
+		{
+			const size_t index = request.NextEntity++;
+			Entity staged = { request.StagedEntities[index], request.Staging.get() };
+			created++;
+
+			UUID uuid = staged.GetUUID();
+			if (m_Scene->GetEntityByUUID(uuid))
+			{
+				HZ_CORE_WARN("Entity {0} of world cell ({1}, {2}) already exists, skipping it", (uint64_t)uuid, cell.X, cell.Y);
+				continue;
+			}
+
+			entt::entity handle;
+			m_Scene->CloneEntities(staged, &uuid, &handle, 1);
+			Entity entity = { handle, m_Scene };
+			SceneSerializer::DeserializeReferences(request.Entities[index], entity);
+
+			// Clones start out as roots. Cells are written parents first, so a parent has always been created already.
+			auto& relationship = entity.GetComponent<RelationshipComponent>();
+			relationship = staged.GetComponent<RelationshipComponent>();
+			if (Entity parent = m_Scene->GetParent(entity))
+			{
+				auto& world = entity.GetComponent<WorldTransformComponent>();
+				world.Parent = parent;
+				world.Depth = parent.GetComponent<WorldTransformComponent>().Depth + 1;
+			}
+			else
+			{
+				relationship.Parent = 0;
+			}
+
+			m_Scene->InitializeRuntimeEntity(entity);
+			cell.Entities.push_back(uuid);
+		}
+
+		if (request.NextEntity >= entityCount)
+		{
+			float latency = std::chrono::duration<float, std::milli>(StreamingClock::now() - request.RequestTime).count();
+			m_Statistics.LastLoadLatency = latency;
+			m_Statistics.MaxLoadLatency = glm::max(m_Statistics.MaxLoadLatency, latency);
+			m_Statistics.AverageLoadLatency += (latency - m_Statistics.AverageLoadLatency) / (float)(m_Statistics.CellsLoaded + 1);
+			m_Statistics.CellsLoaded++;
+
+			// A cell that failed to load counts as resident, so it isn't requested again every frame
+			cell.State = CellState::Resident;
+			cell.Request = nullptr;
+		}
+
+		return created;
+	}
+
+	void WorldPartition::Unload(Cell& cell)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (cell.State == CellState::Resident)
+			m_Statistics.CellsUnloaded++;
+
+		if (cell.State == CellState::Integrating)
+			m_IntegrationQueue.erase(std::find(m_IntegrationQueue.begin(), m_IntegrationQueue.end(), GetCellKey(cell.X, cell.Y)));
+
+		// Children go with their parents, so some of these are gone already
+		for (UUID uuid : cell.Entities)
+		{
+			if (Entity entity = m_Scene->GetEntityByUUID(uuid))
+				m_Scene->DestroyEntity(entity);
+		}
+
+		cell.Entities.clear();
+		cell.Request = nullptr;
+		cell.State = CellState::Unloaded;
+	}
+
+	static void SerializeSubtree(YAML::Emitter& out, Scene& scene, Entity entity)
+	{
+		SceneSerializer::SerializeEntity(out, entity);
+
+		for (UUID childID : entity.GetChildren())
+		{
+			if (Entity child = scene.GetEntityByUUID(childID))
+				SerializeSubtree(out, scene, child);
+		}
+	}
+
+	bool WorldPartition::Partition(Scene& scene, const std::filesystem::path& worldPath, float cellSize)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		HZ_CORE_ASSERT(cellSize > 0.0f);
+
+		// Ordered, so the files come out the same for the same scene
+		std::map<std::pair<int32_t, int32_t>, std::vector<Entity>> cells;
+
+		auto view = scene.m_Registry.view<RelationshipComponent, TransformComponent>();
+		for (auto e : view)
+		{
+			auto [relationship, transform] = view.get<RelationshipComponent, TransformComponent>(e);
+			if (relationship.Parent != 0 || scene.m_Registry.has<CameraComponent>(e))
+				continue;
+
+			int32_t x = (int32_t)glm::floor(transform.Translation.x / cellSize);
+			int32_t y = (int32_t)glm::floor(transform.Translation.y / cellSize);
+			cells[{ x, y }].emplace_back(e, &scene);
+		}
+
+		std::error_code error;
+		std::filesystem::create_directories(worldPath.parent_path() / worldPath.stem(), error);
+		if (error)
+		{
+			HZ_CORE_ERROR("Failed to create the cell directory for world '{0}': {1}", worldPath.string(), error.message());
+			return false;
+		}
+
+		for (const auto& [coord, roots] : cells)
+		{
+			YAML::Emitter out;
+			out << YAML::BeginMap;
+			out << YAML::Key << "Cell" << YAML::Value << YAML::Flow << YAML::BeginSeq << coord.first << coord.second << YAML::EndSeq;
+			out << YAML::Key << "Entities" << YAML::Value << YAML::BeginSeq;
+			for (Entity root : roots)
+				SerializeSubtree(out, scene, root);
+			out << YAML::EndSeq;
+			out << YAML::EndMap;
+
+			std::ofstream fout(GetCellPath(worldPath, coord.first, coord.second));
+			if (!fout)
+				return false;
+
+			fout << out.c_str();
+		}
+
+		YAML::Emitter out;
+		out << YAML::BeginMap;
+		out << YAML::Key << "World" << YAML::Value << worldPath.stem().string();
+		out << YAML::Key << "CellSize" << YAML::Value << cellSize;
+		out << YAML::Key << "Cells" << YAML::Value << YAML::BeginSeq;
+		for (const auto& [coord, roots] : cells)
+			out << YAML::Flow << YAML::BeginSeq << coord.first << coord.second << YAML::EndSeq;
+		out << YAML::EndSeq;
+		out << YAML::EndMap;
+
+		std::ofstream fout(worldPath);
+		if (!fout)
+			return false;
+
+		fout << out.c_str();
+
+		// The streamed entities now live in the cells
+		for (const auto& [coord, roots] : cells)
+		{
+			for (Entity root : roots)
+				scene.DestroyEntity(root);
+		}
+
+		HZ_CORE_INFO("Partitioned the scene into {0} cells of {1} units", cells.size(), cellSize);
+		return true;
+	}
+
+}
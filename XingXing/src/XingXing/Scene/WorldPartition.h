@@ -0,0 +1,109 @@
+#pragma once
+
+#include "XingXing/Core/Base.h"
+#include "XingXing/Core/UUID.h"
+#include "XingXing/Core/FlatHashMap.h"
+#include "XingXing/Core/JobSystem.h"
+
+#include <glm/glm.hpp>
+
+#include <chrono>
+#include <deque>
+#include <filesystem>
+
+namespace Hazel {
+
+	class Scene;
+
+	struct WorldPartitionSpecification
+	{
+		// The .hzworld index, relative to the project's asset directory. The cells are stored in a
+		// directory of the same name next to it.
+		std::filesystem::path WorldPath;
+		// Cells within LoadRadius cells of the camera are streamed in, cells beyond UnloadRadius out again.
+		// The gap keeps a camera moving along a cell border from loading and unloading the same cells.
+		int32_t LoadRadius = 1;
+		int32_t UnloadRadius = 2;
+		// Entities added to the scene per frame, so a large cell is spread over several frames
+		uint32_t EntitiesPerFrame = 256;
+	};
+
+	// Streams the cells of a partitioned world in and out of a running scene around the camera.
+	// Cell files are read, parsed into a staging scene and their textures decoded on the job system;
+	// the main thread clones the entities into the scene in time-sliced batches. Unloading a cell destroys the entities it created, along with
+	// their physics bodies and script instances. Entities spawned at runtime belong to no cell.
+	class WorldPartition
+	{
+	public:
+		struct Statistics
+		{
+			uint32_t ResidentCells = 0;
+			// Being read or added to the scene
+			uint32_t LoadingCells = 0;
+			uint32_t ResidentEntities = 0;
+			uint32_t CellsLoaded = 0;
+			uint32_t CellsUnloaded = 0;
+
+			// From requesting a cell to its last entity being added, in milliseconds
+			float LastLoadLatency = 0.0f;
+			float AverageLoadLatency = 0.0f;
+			float MaxLoadLatency = 0.0f;
+		};
+	public:
+		WorldPartition(Scene* scene, const WorldPartitionSpecification& specification);
+		// Waits for reads still in flight
+		~WorldPartition();
+
+		// Returns nullptr if the world index can't be read
+		static Scope<WorldPartition> Create(Scene* scene, const WorldPartitionSpecification& specification);
+
+		// Moves the scene's root entities, with their children, into cells of cellSize by translation and
+		// writes them next to a world index at worldPath. Entities with cameras stay in the scene.
+		// This is destructive: the moved entities are destroyed in the scene, and an existing world at
+		// worldPath is replaced rather than merged with, its cells that get no entities are left on disk
+		// but dropped from the index.
+		static bool Partition(Scene& scene, const std::filesystem::path& worldPath, float cellSize = 64.0f);
+
+		void Update(const glm::vec3& focus);
+		void UnloadAll();
+
+		float GetCellSize() const { return m_CellSize; }
+		const Statistics& GetStatistics() const { return m_Statistics; }
+	private:
+		enum class CellState
+		{
+			Unloaded, Loading, Integrating, Resident
+		};
+
+		struct CellLoadRequest;
+
+		struct Cell
+		{
+			int32_t X = 0, Y = 0;
+			CellState State = CellState::Unloaded;
+			std::vector<UUID> Entities;
+			Ref<CellLoadRequest> Request;
+		};
+
+		static uint64_t GetCellKey(int32_t x, int32_t y) { return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y; }
+		static std::filesystem::path GetCellPath(const std::filesystem::path& worldPath, int32_t x, int32_t y);
+
+		bool LoadIndex();
+		void RequestLoad(Cell& cell);
+		// Returns the number of entities created
+		uint32_t Integrate(Cell& cell, uint32_t budget);
+		void Unload(Cell& cell);
+	private:
+		Scene* m_Scene = nullptr;
+		WorldPartitionSpecification m_Specification;
+		float m_CellSize = 64.0f;
+
+		FlatHashMap<uint64_t, Cell> m_Cells;
+		// Cells that have been read, in the order they finished
+		std::deque<uint64_t> m_IntegrationQueue;
+		JobCounter m_LoadCounter;
+
+		Statistics m_Statistics;
+	};
+
+}
@@ -16,6 +16,8 @@
 #include "XingXing/Core/Timer.h"
 #include "XingXing/Core/Buffer.h"
 #include "XingXing/Core/FileSystem.h"
+#include "XingXing/Core/FlatHashMap.h"
+#include "XingXing/Core/ObjectPool.h"
 
 #include "XingXing/Project/Project.h"
 
@@ -129,8 +131,11 @@ namespace Hazel {
 		ScriptClass EntityClass;
 
 		std::unordered_map<std::string, Ref<ScriptClass>> EntityClasses;
-		std::unordered_map<UUID, Ref<ScriptInstance>> EntityInstances;
-		std::unordered_map<UUID, ScriptFieldMap> EntityScriptFields;
+		FlatHashMap<UUID, Ref<ScriptInstance>> EntityInstances;
+		FlatHashMap<UUID, ScriptFieldMap> EntityScriptFields;
+
+		std::unordered_map<std::string, Ref<Prefab>> PrefabsByPath;
+		FlatHashMap<UUID, Ref<Prefab>> Prefabs;
 
 		Scope<filewatch::FileWatch<std::string>> AppAssemblyFileWatcher;
 		bool AssemblyReloadPending = false;
@@ -193,8 +198,12 @@ namespace Hazel {
 
 	void ScriptEngine::Shutdown()
 	{
+		if (!s_Data)
+			return;
+
 		ShutdownMono();
 		delete s_Data;
+		s_Data = nullptr;
 	}
 
 	void ScriptEngine::InitMono()
@@ -282,6 +291,10 @@ namespace Hazel {
 
 	void ScriptEngine::OnRuntimeStart(Scene* scene)
 	{
+		// Scenes with native scripts only also run without the script engine
+		if (!s_Data)
+			return;
+
 		s_Data->SceneContext = scene;
 	}
 
@@ -301,9 +314,9 @@ namespace Hazel {
 			s_Data->EntityInstances[entityID] = instance;
 
 			// Copy field values
-			if (s_Data->EntityScriptFields.find(entityID) != s_Data->EntityScriptFields.end())
+			if (auto it = s_Data->EntityScriptFields.find(entityID); it != s_Data->EntityScriptFields.end())
 			{
-				const ScriptFieldMap& fieldMap = s_Data->EntityScriptFields.at(entityID);
+				const ScriptFieldMap& fieldMap = it->second;
 				for (const auto& [name, fieldInstance] : fieldMap)
 					instance->SetFieldValueInternal(name, fieldInstance.m_Buffer);
 			}
@@ -315,10 +328,9 @@ namespace Hazel {
 	void ScriptEngine::OnUpdateEntity(Entity entity, Timestep ts)
 	{
 		UUID entityUUID = entity.GetUUID();
-		if (s_Data->EntityInstances.find(entityUUID) != s_Data->EntityInstances.end())
+		if (auto it = s_Data->EntityInstances.find(entityUUID); it != s_Data->EntityInstances.end())
 		{
-			Ref<ScriptInstance> instance = s_Data->EntityInstances[entityUUID];
-			instance->InvokeOnUpdate((float)ts);
+			it->second->InvokeOnUpdate((float)ts);
 		}
 		else
 		{
@@ -326,6 +338,24 @@ namespace Hazel {
 		}
 	}
 
+	void ScriptEngine::OnFixedUpdateEntity(Entity entity, Timestep ts)
+	{
+		UUID entityUUID = entity.GetUUID();
+		if (auto it = s_Data->EntityInstances.find(entityUUID); it != s_Data->EntityInstances.end())
+		{
+			it->second->InvokeOnFixedUpdate((float)ts);
+		}
+		else
+		{
+			HZ_CORE_ERROR("Could not find ScriptInstance for entity {}",  entityUUID);
+		}
+	}
+
+	void ScriptEngine::OnDestroyEntity(Entity entity)
+	{
+		s_Data->EntityInstances.erase(entity.GetUUID());
+	}
+
 	Scene* ScriptEngine::GetSceneContext()
 	{
 		return s_Data->SceneContext;
@@ -351,9 +381,15 @@ namespace Hazel {
 
 	void ScriptEngine::OnRuntimeStop()
 	{
+		if (!s_Data)
+			return;
+
 		s_Data->SceneContext = nullptr;
 
 		s_Data->EntityInstances.clear();
+
+		s_Data->PrefabsByPath.clear();
+		s_Data->Prefabs.clear();
 	}
 
 	std::unordered_map<std::string, Ref<ScriptClass>> ScriptEngine::GetEntityClasses()
@@ -369,6 +405,27 @@ namespace Hazel {
 		return s_Data->EntityScriptFields[entityID];
 	}
 
+	Ref<Prefab> ScriptEngine::LoadPrefab(const std::filesystem::path& path)
+	{
+		std::string key = path.generic_string();
+		if (auto it = s_Data->PrefabsByPath.find(key); it != s_Data->PrefabsByPath.end())
+			return it->second;
+
+		Ref<Prefab> prefab = Prefab::Load(Project::GetAssetFileSystemPath(path));
+		if (!prefab)
+			return nullptr;
+
+		s_Data->PrefabsByPath[key] = prefab;
+		s_Data->Prefabs[prefab->GetID()] = prefab;
+		return prefab;
+	}
+
+	Ref<Prefab> ScriptEngine::GetPrefab(UUID prefabID)
+	{
+		auto it = s_Data->Prefabs.find(prefabID);
+		return it != s_Data->Prefabs.end() ? it->second : nullptr;
+	}
+
 	void ScriptEngine::LoadAssemblyClasses()
 	{
 		s_Data->EntityClasses.clear();
@@ -440,8 +497,9 @@ namespace Hazel {
 
 	MonoObject* ScriptEngine::GetManagedInstance(UUID uuid)
 	{
-		HZ_CORE_ASSERT(s_Data->EntityInstances.find(uuid) != s_Data->EntityInstances.end());
-		return s_Data->EntityInstances.at(uuid)->GetManagedObject();
+		auto it = s_Data->EntityInstances.find(uuid);
+		HZ_CORE_ASSERT(it != s_Data->EntityInstances.end());
+		return it->second->GetManagedObject();
 	}
 
 	MonoString* ScriptEngine::CreateString(const char* string)
@@ -478,7 +536,7 @@ namespace Hazel {
 		return mono_runtime_invoke(method, instance, params, &exception);
 	}
 
-	ScriptInstance::ScriptInstance(Ref<ScriptClass> scriptClass, Entity entity)
+	ScriptInstance::ScriptInstance(const Ref<ScriptClass>& scriptClass, Entity entity)
 		: m_ScriptClass(scriptClass)
 	{
 		m_Instance = scriptClass->Instantiate();
@@ -486,6 +544,7 @@ namespace Hazel {
 		m_Constructor = s_Data->EntityClass.GetMethod(".ctor", 1);
 		m_OnCreateMethod = scriptClass->GetMethod("OnCreate", 0);
 		m_OnUpdateMethod = scriptClass->GetMethod("OnUpdate", 1);
+		m_OnFixedUpdateMethod = scriptClass->GetMethod("OnFixedUpdate", 1);
 
 		// Call Entity constructor
 		{
@@ -495,6 +554,17 @@ namespace Hazel {
 		}
 	}
 
+	void* ScriptInstance::operator new(size_t size)
+	{
+		HZ_CORE_ASSERT(size == sizeof(ScriptInstance));
+		return ObjectPool<ScriptInstance>::Get().Allocate();
+	}
+
+	void ScriptInstance::operator delete(void* instance)
+	{
+		ObjectPool<ScriptInstance>::Get().Free(instance);
+	}
+
 	void ScriptInstance::InvokeOnCreate()
 	{
 		if (m_OnCreateMethod)
@@ -510,6 +580,15 @@ namespace Hazel {
 		}
 	}
 
+	void ScriptInstance::InvokeOnFixedUpdate(float ts)
+	{
+		if (m_OnFixedUpdateMethod)
+		{
+			void* param = &ts;
+			m_ScriptClass->InvokeMethod(m_Instance, m_OnFixedUpdateMethod, &param);
+		}
+	}
+
 	bool ScriptInstance::GetFieldValueInternal(const std::string& name, void* buffer)
 	{
 		const auto& fields = m_ScriptClass->GetFields();
@@ -522,6 +601,49 @@ namespace Hazel {
 		return true;
 	}
 
+	static bool IsSnapshotField(const ScriptField& field)
+	{
+		return field.Type != ScriptFieldType::None && field.Type != ScriptFieldType::Entity;
+	}
+
+	uint32_t ScriptInstance::GetFieldDataSize() const
+	{
+		uint32_t count = 0;
+		for (const auto& [name, field] : m_ScriptClass->GetFields())
+		{
+			if (IsSnapshotField(field))
+				count++;
+		}
+		return count * 16;
+	}
+
+	void ScriptInstance::GetFieldData(void* buffer)
+	{
+		uint8_t* data = (uint8_t*)buffer;
+		for (const auto& [name, field] : m_ScriptClass->GetFields())
+		{
+			if (!IsSnapshotField(field))
+				continue;
+
+			memset(data, 0, 16);
+			mono_field_get_value(m_Instance, field.ClassField, data);
+			data += 16;
+		}
+	}
+
+	void ScriptInstance::SetFieldData(const void* buffer)
+	{
+		const uint8_t* data = (const uint8_t*)buffer;
+		for (const auto& [name, field] : m_ScriptClass->GetFields())
+		{
+			if (!IsSnapshotField(field))
+				continue;
+
+			mono_field_set_value(m_Instance, field.ClassField, (void*)data);
+			data += 16;
+		}
+	}
+
 	bool ScriptInstance::SetFieldValueInternal(const std::string& name, const void* value)
 	{
 		const auto& fields = m_ScriptClass->GetFields();
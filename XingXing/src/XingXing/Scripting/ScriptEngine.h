@@ -2,6 +2,7 @@
 
 #include "XingXing/Scene/Scene.h"
 #include "XingXing/Scene/Entity.h"
+#include "XingXing/Scene/Prefab.h"
 
 #include <filesystem>
 #include <string>
@@ -19,6 +20,12 @@ extern "C" {
 
 namespace Hazel {
 
+	// Only referenced from the main thread, and instances come and go with entities
+	class ScriptClass;
+	class ScriptInstance;
+	HZ_INTRUSIVE_REF(ScriptClass)
+	HZ_INTRUSIVE_REF(ScriptInstance)
+
 	enum class ScriptFieldType
 	{
 		None = 0,
@@ -69,7 +76,7 @@ namespace Hazel {
 
 	using ScriptFieldMap = std::unordered_map<std::string, ScriptFieldInstance>;
 
-	class ScriptClass
+	class ScriptClass : public RefCounted
 	{
 	public:
 		ScriptClass() = default;
@@ -91,15 +98,20 @@ namespace Hazel {
 		friend class ScriptEngine;
 	};
 
-	class ScriptInstance
+	class ScriptInstance : public RefCounted
 	{
 	public:
-		ScriptInstance(Ref<ScriptClass> scriptClass, Entity entity);
+		ScriptInstance(const Ref<ScriptClass>& scriptClass, Entity entity);
+
+		// Allocated from ObjectPool<ScriptInstance>
+		static void* operator new(size_t size);
+		static void operator delete(void* instance);
 
 		void InvokeOnCreate();
 		void InvokeOnUpdate(float ts);
+		void InvokeOnFixedUpdate(float ts);
 
-		Ref<ScriptClass> GetScriptClass() { return m_ScriptClass; }
+		const Ref<ScriptClass>& GetScriptClass() const { return m_ScriptClass; }
 
 		template<typename T>
 		T GetFieldValue(const std::string& name)
@@ -122,6 +134,12 @@ namespace Hazel {
 		}
 
 		MonoObject* GetManagedObject() { return m_Instance; }
+
+		// Values of all value type fields, 16 bytes each in field name order, for scene snapshots.
+		// Entity fields are references into the managed heap and are left out.
+		uint32_t GetFieldDataSize() const;
+		void GetFieldData(void* buffer);
+		void SetFieldData(const void* buffer);
 	private:
 		bool GetFieldValueInternal(const std::string& name, void* buffer);
 		bool SetFieldValueInternal(const std::string& name, const void* value);
@@ -132,6 +150,7 @@ namespace Hazel {
 		MonoMethod* m_Constructor = nullptr;
 		MonoMethod* m_OnCreateMethod = nullptr;
 		MonoMethod* m_OnUpdateMethod = nullptr;
+		MonoMethod* m_OnFixedUpdateMethod = nullptr;
 
 		inline static char s_FieldValueBuffer[16];
 
@@ -156,13 +175,20 @@ namespace Hazel {
 		static bool EntityClassExists(const std::string& fullClassName);
 		static void OnCreateEntity(Entity entity);
 		static void OnUpdateEntity(Entity entity, Timestep ts);
+		static void OnFixedUpdateEntity(Entity entity, Timestep ts);
+		static void OnDestroyEntity(Entity entity);
 
 		static Scene* GetSceneContext();
 		static Ref<ScriptInstance> GetEntityScriptInstance(UUID entityID);
 		
 		static Ref<ScriptClass> GetEntityClass(const std::string& name);
 		static std::unordered_map<std::string, Ref<ScriptClass>> GetEntityClasses();
+		// The reference is invalidated when a field map is created for another entity
 		static ScriptFieldMap& GetScriptFieldMap(Entity entity);
+
+		// Prefabs loaded by scripts are cached by path until the runtime stops
+		static Ref<Prefab> LoadPrefab(const std::filesystem::path& path);
+		static Ref<Prefab> GetPrefab(UUID prefabID);
 		
 		static MonoImage* GetCoreAssemblyImage();
 
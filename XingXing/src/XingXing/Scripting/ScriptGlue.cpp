@@ -3,15 +3,19 @@
 #include "ScriptEngine.h"
 
 #include "XingXing/Core/UUID.h"
+#include "XingXing/Core/FlatHashMap.h"
 #include "XingXing/Core/KeyCodes.h"
 #include "XingXing/Core/Input.h"
+#include "XingXing/Core/FrameAllocator.h"
 
 #include "XingXing/Scene/Scene.h"
 #include "XingXing/Scene/Entity.h"
+#include "XingXing/Scene/EntityCommandBuffer.h"
 
 #include "XingXing/Physics/Physics2D.h"
 
 #include "mono/metadata/object.h"
+#include "mono/metadata/appdomain.h"
 #include "mono/metadata/reflection.h"
 
 #include "box2d/b2_body.h"
@@ -20,24 +24,60 @@ namespace Hazel {
 
 	namespace Utils {
 
-		std::string MonoStringToString(MonoString* string)
+		// Converts the UTF-16 characters straight into scratch memory instead of going through
+		// mono_string_to_utf8 and a std::string. Only valid inside the caller's ScratchScope.
+		std::string_view MonoStringToScratch(MonoString* string)
 		{
-			char* cStr = mono_string_to_utf8(string);
-			std::string str(cStr);
-			mono_free(cStr);
-			return str;
+			const mono_unichar2* chars = mono_string_chars(string);
+			const int32_t length = mono_string_length(string);
+
+			// A unit takes at most 3 bytes, a surrogate pair of two units takes 4
+			char* result = ScratchAllocator::Get().Allocate<char>((uint64_t)length * 3 + 1);
+			char* out = result;
+			for (int32_t i = 0; i < length; i++)
+			{
+				uint32_t c = chars[i];
+				if (c >= 0xD800 && c < 0xDC00 && i + 1 < length && chars[i + 1] >= 0xDC00 && chars[i + 1] < 0xE000)
+					c = 0x10000 + ((c - 0xD800) << 10) + (chars[++i] - 0xDC00);
+
+				if (c < 0x80)
+				{
+					*out++ = (char)c;
+				}
+				else if (c < 0x800)
+				{
+					*out++ = (char)(0xC0 | (c >> 6));
+					*out++ = (char)(0x80 | (c & 0x3F));
+				}
+				else if (c < 0x10000)
+				{
+					*out++ = (char)(0xE0 | (c >> 12));
+					*out++ = (char)(0x80 | ((c >> 6) & 0x3F));
+					*out++ = (char)(0x80 | (c & 0x3F));
+				}
+				else
+				{
+					*out++ = (char)(0xF0 | (c >> 18));
+					*out++ = (char)(0x80 | ((c >> 12) & 0x3F));
+					*out++ = (char)(0x80 | ((c >> 6) & 0x3F));
+					*out++ = (char)(0x80 | (c & 0x3F));
+				}
+			}
+			*out = '\0';
+
+			return std::string_view(result, out - result);
 		}
 
 	}
 
-	static std::unordered_map<MonoType*, std::function<bool(Entity)>> s_EntityHasComponentFuncs;
+	static FlatHashMap<MonoType*, std::function<bool(Entity)>> s_EntityHasComponentFuncs;
 
 #define HZ_ADD_INTERNAL_CALL(Name) mono_add_internal_call("Hazel.InternalCalls::" #Name, Name)
 
 	static void NativeLog(MonoString* string, int parameter)
 	{
-		std::string str = Utils::MonoStringToString(string);
-		std::cout << str << ", " << parameter << std::endl;
+		ScratchScope scratch;
+		std::cout << Utils::MonoStringToScratch(string) << ", " << parameter << std::endl;
 	}
 
 	static void NativeLog_Vector(glm::vec3* parameter, glm::vec3* outResult)
@@ -65,18 +105,18 @@ namespace Hazel {
 		HZ_CORE_ASSERT(entity);
 
 		MonoType* managedType = mono_reflection_type_get_type(componentType);
-		HZ_CORE_ASSERT(s_EntityHasComponentFuncs.find(managedType) != s_EntityHasComponentFuncs.end());
-		return s_EntityHasComponentFuncs.at(managedType)(entity);
+		auto it = s_EntityHasComponentFuncs.find(managedType);
+		HZ_CORE_ASSERT(it != s_EntityHasComponentFuncs.end());
+		return it->second(entity);
 	}
 
 	static uint64_t Entity_FindEntityByName(MonoString* name)
 	{
-		char* nameCStr = mono_string_to_utf8(name);
+		ScratchScope scratch;
 
 		Scene* scene = ScriptEngine::GetSceneContext();
 		HZ_CORE_ASSERT(scene);
-		Entity entity = scene->FindEntityByName(nameCStr);
-		mono_free(nameCStr);
+		Entity entity = scene->FindEntityByName(Utils::MonoStringToScratch(name));
 
 		if (!entity)
 			return 0;
@@ -84,6 +124,75 @@ namespace Hazel {
 		return entity.GetUUID();
 	}
 
+	static uint64_t Entity_Instantiate(UUID sourceID, glm::vec3* translation, bool overrideTranslation)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		HZ_CORE_ASSERT(scene);
+
+		// Scripts run while the scene iterates its entities, so structural changes are deferred
+		EntityCommandBuffer& commands = scene->GetCommandBuffer();
+		return overrideTranslation ? commands.Instantiate(sourceID, *translation) : commands.Instantiate(sourceID);
+	}
+
+	static void Entity_Destroy(UUID entityID)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		HZ_CORE_ASSERT(scene);
+		scene->GetCommandBuffer().DestroyEntity(entityID);
+	}
+
+	static bool Entity_IsActive(UUID entityID)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		HZ_CORE_ASSERT(scene);
+		Entity entity = scene->GetEntityByUUID(entityID);
+		HZ_CORE_ASSERT(entity);
+		return entity.IsActive();
+	}
+
+	static void Entity_SetActive(UUID entityID, bool active)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		HZ_CORE_ASSERT(scene);
+		Entity entity = scene->GetEntityByUUID(entityID);
+		HZ_CORE_ASSERT(entity);
+
+		// The tag pool isn't iterated by the script update, so this is safe to do right away
+		entity.SetActive(active);
+	}
+
+	static uint64_t Prefab_Load(MonoString* path)
+	{
+		ScratchScope scratch;
+		Ref<Prefab> prefab = ScriptEngine::LoadPrefab(Utils::MonoStringToScratch(path));
+
+		return prefab ? (uint64_t)prefab->GetID() : 0;
+	}
+
+	static uint64_t Prefab_Instantiate(UUID prefabID, glm::vec3* translation, bool overrideTranslation)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		HZ_CORE_ASSERT(scene);
+		Ref<Prefab> prefab = ScriptEngine::GetPrefab(prefabID);
+		HZ_CORE_ASSERT(prefab);
+
+		EntityCommandBuffer& commands = scene->GetCommandBuffer();
+		return overrideTranslation ? commands.Instantiate(prefab, *translation) : commands.Instantiate(prefab);
+	}
+
+	static void Prefab_InstantiateMany(UUID prefabID, MonoArray* translations)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		HZ_CORE_ASSERT(scene);
+		Ref<Prefab> prefab = ScriptEngine::GetPrefab(prefabID);
+		HZ_CORE_ASSERT(prefab);
+
+		// Vector3 is blittable, so the managed array can be read in place
+		uint32_t count = (uint32_t)mono_array_length(translations);
+		const glm::vec3* data = mono_array_addr(translations, glm::vec3, 0);
+		scene->GetCommandBuffer().Instantiate(prefab, data, count);
+	}
+
 	static void TransformComponent_GetTranslation(UUID entityID, glm::vec3* outTranslation)
 	{
 		Scene* scene = ScriptEngine::GetSceneContext();
@@ -185,8 +294,10 @@ namespace Hazel {
 		HZ_CORE_ASSERT(entity);
 		HZ_CORE_ASSERT(entity.HasComponent<TextComponent>());
 
+		// Assigning reuses the capacity the text already has
+		ScratchScope scratch;
 		auto& tc = entity.GetComponent<TextComponent>();
-		tc.TextString = Utils::MonoStringToString(textString);
+		tc.TextString.assign(Utils::MonoStringToScratch(textString));
 	}
 
 	static void TextComponent_GetColor(UUID entityID, glm::vec4* color)
@@ -261,6 +372,44 @@ namespace Hazel {
 		tc.LineSpacing = lineSpacing;
 	}
 
+	// Results go back as one array of entity IDs per query
+	static MonoArray* CreateEntityIDArray(const std::vector<Entity>& entities)
+	{
+		MonoArray* result = mono_array_new(mono_domain_get(), mono_get_uint64_class(), entities.size());
+		uint64_t* ids = mono_array_addr(result, uint64_t, 0);
+		for (size_t i = 0; i < entities.size(); i++)
+			ids[i] = Entity(entities[i]).GetUUID();
+		return result;
+	}
+
+	static MonoArray* Scene_QueryAABB(glm::vec2* min, glm::vec2* max)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		HZ_CORE_ASSERT(scene);
+		return CreateEntityIDArray(scene->QueryAABB(*min, *max));
+	}
+
+	static MonoArray* Scene_QueryRadius(glm::vec2* center, float radius)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		HZ_CORE_ASSERT(scene);
+		return CreateEntityIDArray(scene->QueryRadius(*center, radius));
+	}
+
+	static MonoArray* Scene_QueryPoint(glm::vec2* point)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		HZ_CORE_ASSERT(scene);
+		return CreateEntityIDArray(scene->QueryPoint(*point));
+	}
+
+	static MonoArray* Scene_QueryNearest(glm::vec2* point, int32_t count)
+	{
+		Scene* scene = ScriptEngine::GetSceneContext();
+		HZ_CORE_ASSERT(scene);
+		return CreateEntityIDArray(scene->QueryNearest(*point, (uint32_t)glm::max(count, 0)));
+	}
+
 	static bool Input_IsKeyDown(KeyCode keycode)
 	{
 		return Input::IsKeyPressed(keycode);
@@ -308,6 +457,14 @@ namespace Hazel {
 
 		HZ_ADD_INTERNAL_CALL(Entity_HasComponent);
 		HZ_ADD_INTERNAL_CALL(Entity_FindEntityByName);
+		HZ_ADD_INTERNAL_CALL(Entity_Instantiate);
+		HZ_ADD_INTERNAL_CALL(Entity_Destroy);
+		HZ_ADD_INTERNAL_CALL(Entity_IsActive);
+		HZ_ADD_INTERNAL_CALL(Entity_SetActive);
+
+		HZ_ADD_INTERNAL_CALL(Prefab_Load);
+		HZ_ADD_INTERNAL_CALL(Prefab_Instantiate);
+		HZ_ADD_INTERNAL_CALL(Prefab_InstantiateMany);
 
 		HZ_ADD_INTERNAL_CALL(TransformComponent_GetTranslation);
 		HZ_ADD_INTERNAL_CALL(TransformComponent_SetTranslation);
@@ -327,6 +484,11 @@ namespace Hazel {
 		HZ_ADD_INTERNAL_CALL(TextComponent_GetLineSpacing);
 		HZ_ADD_INTERNAL_CALL(TextComponent_SetLineSpacing);
 
+		HZ_ADD_INTERNAL_CALL(Scene_QueryAABB);
+		HZ_ADD_INTERNAL_CALL(Scene_QueryRadius);
+		HZ_ADD_INTERNAL_CALL(Scene_QueryPoint);
+		HZ_ADD_INTERNAL_CALL(Scene_QueryNearest);
+
 		HZ_ADD_INTERNAL_CALL(Input_IsKeyDown);
 	}
 
@@ -10,6 +10,10 @@
 #include "XingXing/Core/Assert.h"
 
 #include "XingXing/Core/Timestep.h"
+#include "XingXing/Core/JobSystem.h"
+#include "XingXing/Core/FrameAllocator.h"
+#include "XingXing/Core/AllocationTracker.h"
+#include "XingXing/Core/ObjectPool.h"
 
 #include "XingXing/Core/Input.h"
 #include "XingXing/Core/KeyCodes.h"
@@ -22,6 +26,11 @@
 #include "XingXing/Scene/Entity.h"
 #include "XingXing/Scene/ScriptableEntity.h"
 #include "XingXing/Scene/Components.h"
+#include "XingXing/Scene/Prefab.h"
+#include "XingXing/Scene/SceneGenerator.h"
+#include "XingXing/Scene/WorldPartition.h"
+
+#include "XingXing/Asset/AssetTable.h"
 
 #include "XingXing/Project/Project.h"
 
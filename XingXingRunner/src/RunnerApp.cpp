@@ -0,0 +1,76 @@
+#include <xingxing.h>
+#include <xingxing/Core/EntryPoint.h>
+
+#include "RunnerLayer.h"
+
+namespace Hazel {
+
+	class Runner : public Application
+	{
+	public:
+		Runner(const ApplicationSpecification& spec, const RunnerSpecification& runnerSpec, bool valid)
+			: Application(spec)
+		{
+			if (valid)
+				PushLayer(new RunnerLayer(runnerSpec));
+			else
+				Close();
+		}
+	};
+
+	namespace Utils {
+
+		static void PrintUsage()
+		{
+			HZ_INFO("Usage: XingXingRunner <project.hproj> [scene.hazel|parameters.hgen] [--frames <count>] [--timestep <seconds>] [--no-render] [--trace <file.json>]");
+		}
+
+		// Returns false if the arguments can't be used
+		static bool ParseCommandLine(const ApplicationCommandLineArgs& args, RunnerSpecification& spec)
+		{
+			for (int i = 1; i < args.Count; i++)
+			{
+				std::string_view arg = args[i];
+				bool hasValue = i + 1 < args.Count;
+
+				if (arg == "--frames" && hasValue)
+					spec.FrameCount = (uint32_t)std::max(std::atoi(args[++i]), 1);
+				else if (arg == "--timestep" && hasValue)
+					spec.Timestep = (float)std::atof(args[++i]);
+				else if (arg == "--trace" && hasValue)
+					spec.TracePath = args[++i];
+				else if (arg == "--no-render")
+					spec.Render = false;
+				else if (arg.substr(0, 2) == "--")
+					return false;
+				else if (spec.ProjectPath.empty())
+					spec.ProjectPath = args[i];
+				else if (spec.ScenePath.empty())
+					spec.ScenePath = args[i];
+				else
+					return false;
+			}
+
+			return !spec.ProjectPath.empty() && spec.Timestep > 0.0f;
+		}
+
+	}
+
+	Application* CreateApplication(ApplicationCommandLineArgs args)
+	{
+		RunnerSpecification runnerSpec;
+		bool valid = Utils::ParseCommandLine(args, runnerSpec);
+		if (!valid)
+			Utils::PrintUsage();
+
+		ApplicationSpecification spec;
+		spec.Name = "XingXing Runner";
+		spec.CommandLineArgs = args;
+		spec.RenderThreadingPolicy = ThreadingPolicy::MultiThreaded;
+		// Scenes still need a context to load their textures and fonts, the window just isn't shown
+		spec.WindowVisible = runnerSpec.Render;
+
+		return new Runner(spec, runnerSpec, valid);
+	}
+
+}
@@ -0,0 +1,172 @@
+#include "RunnerLayer.h"
+#include "XingXing/Scene/SceneSerializer.h"
+#include "XingXing/Scripting/ScriptEngine.h"
+
+namespace Hazel {
+
+	RunnerLayer::RunnerLayer(const RunnerSpecification& specification)
+		: Layer("RunnerLayer"), m_Specification(specification)
+	{
+		m_FrameStatistics.Name = "Frame";
+	}
+
+	void RunnerLayer::OnAttach()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (!LoadScene())
+		{
+			m_Finished = true;
+			Application::Get().Close();
+			return;
+		}
+
+		Window& window = Application::Get().GetWindow();
+		window.SetVSync(false);
+		m_Scene->OnViewportResize(window.GetWidth(), window.GetHeight());
+		m_Scene->SetRenderingEnabled(m_Specification.Render);
+
+		HZ_INFO("Running {0} frames of {1} ms{2}", m_Specification.FrameCount, m_Specification.Timestep * 1000.0f,
+			m_Specification.Render ? "" : " without rendering");
+
+		// Replaces the entry point's runtime session, if profiling is compiled in, so the trace only covers the run
+		Instrumentor::Get().EndSession();
+		Instrumentor::Get().BeginSession("Runner", m_Specification.TracePath.string());
+
+		m_Scene->OnRuntimeStart();
+		m_Timer.Reset();
+	}
+
+	void RunnerLayer::OnDetach()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (!m_Finished)
+			Finish();
+	}
+
+	void RunnerLayer::OnUpdate(Timestep ts)
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (m_Finished)
+			return;
+
+		{
+			InstrumentationTimer timer("Frame");
+
+			if (m_Specification.Render)
+			{
+				Renderer2D::ResetStats();
+				RenderCommand::SetClearColor({ 0.1f, 0.1f, 0.1f, 1 });
+				RenderCommand::Clear();
+			}
+
+			// The frame's real duration is ignored, every run of a scene simulates the same frames
+			m_Scene->OnUpdateRuntime(m_Specification.Timestep);
+		}
+
+		RecordTimings();
+
+		if (++m_Frame == m_Specification.FrameCount)
+		{
+			Finish();
+			Application::Get().Close();
+		}
+	}
+
+	bool RunnerLayer::LoadScene()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		if (!Project::Load(m_Specification.ProjectPath))
+		{
+			HZ_ERROR("Could not load project {0}", m_Specification.ProjectPath.string());
+			return false;
+		}
+
+		ScriptEngine::Init();
+
+		std::filesystem::path scenePath = m_Specification.ScenePath;
+		if (scenePath.empty())
+			scenePath = Project::GetAssetFileSystemPath(Project::GetActive()->GetConfig().StartScene);
+		else if (scenePath.is_relative() && !std::filesystem::exists(scenePath))
+			scenePath = Project::GetAssetFileSystemPath(scenePath);
+
+		// Generator parameter files are run without writing the scene out first
+		if (scenePath.extension() == ".hgen")
+		{
+			SceneGeneratorSpecification specification;
+			if (!SceneGenerator::LoadSpecification(scenePath, specification))
+			{
+				HZ_ERROR("Could not load generator parameters {0}", scenePath.string());
+				return false;
+			}
+
+			m_Scene = SceneGenerator::Generate(specification);
+		}
+		else
+		{
+			m_Scene = CreateRef<Scene>();
+			SceneSerializer serializer(m_Scene);
+			if (!serializer.Deserialize(scenePath.string()))
+			{
+				HZ_ERROR("Could not load scene {0}", scenePath.string());
+				m_Scene = nullptr;
+				return false;
+			}
+		}
+
+		HZ_INFO("Loaded scene {0}", scenePath.string());
+		return true;
+	}
+
+	void RunnerLayer::RecordTimings()
+	{
+		const SystemScheduler& scheduler = m_Scene->GetSystemScheduler();
+		for (const auto& system : scheduler.GetSystems())
+		{
+			// Systems can be added while the scene runs, look them up by name
+			auto it = std::find_if(m_Statistics.begin(), m_Statistics.end(), [&](const SystemStatistics& statistics) { return statistics.Name == system.Name; });
+			if (it == m_Statistics.end())
+			{
+				it = m_Statistics.emplace(m_Statistics.end());
+				it->Name = system.Name;
+			}
+
+			it->Add(system.Timing.Duration);
+		}
+
+		m_FrameStatistics.Add(scheduler.GetExecutionTime());
+	}
+
+	void RunnerLayer::PrintTimings()
+	{
+		HZ_INFO("{0} frames in {1:.1f} ms", m_Frame, m_Timer.ElapsedMillis());
+		HZ_INFO("{0:<28} {1:>10} {2:>10} {3:>10}", "System (ms)", "Average", "Min", "Max");
+
+		auto print = [](const SystemStatistics& statistics)
+		{
+			float average = statistics.Frames ? statistics.Total / statistics.Frames : 0.0f;
+			HZ_INFO("{0:<28} {1:>10.4f} {2:>10.4f} {3:>10.4f}", statistics.Name, average, statistics.Min, statistics.Max);
+		};
+
+		for (const SystemStatistics& statistics : m_Statistics)
+			print(statistics);
+		print(m_FrameStatistics);
+	}
+
+	void RunnerLayer::Finish()
+	{
+		HZ_PROFILE_FUNCTION();
+
+		m_Scene->OnRuntimeStop();
+		Instrumentor::Get().EndSession();
+
+		PrintTimings();
+		HZ_INFO("Trace written to {0}", m_Specification.TracePath.string());
+
+		m_Finished = true;
+	}
+
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "xingxing.h"
+#include "XingXing/Core/Timer.h"
+
+#include <filesystem>
+
+namespace Hazel {
+
+	struct RunnerSpecification
+	{
+		std::filesystem::path ProjectPath;
+		// Empty for the project's start scene, a .hgen file is generated with SceneGenerator
+		std::filesystem::path ScenePath;
+		uint32_t FrameCount = 600;
+		float Timestep = 1.0f / 60.0f;
+		bool Render = true;
+		std::filesystem::path TracePath = "HazelProfile-Runner.json";
+	};
+
+	// Loads a project and scene, runs the scene for a fixed number of frames with a fixed timestep,
+	// then prints how long each of the scene's systems took and closes the application
+	class RunnerLayer : public Layer
+	{
+	public:
+		RunnerLayer(const RunnerSpecification& specification);
+		virtual ~RunnerLayer() = default;
+
+		virtual void OnAttach() override;
+		virtual void OnDetach() override;
+
+		void OnUpdate(Timestep ts) override;
+	private:
+		bool LoadScene();
+		void RecordTimings();
+		void PrintTimings();
+		void Finish();
+	private:
+		struct SystemStatistics
+		{
+			std::string Name;
+			float Total = 0.0f; // ms
+			float Min = 0.0f;
+			float Max = 0.0f;
+			uint32_t Frames = 0;
+
+			void Add(float duration)
+			{
+				Min = Frames == 0 ? duration : std::min(Min, duration);
+				Max = Frames == 0 ? duration : std::max(Max, duration);
+				Total += duration;
+				Frames++;
+			}
+		};
+
+		RunnerSpecification m_Specification;
+		Ref<Scene> m_Scene;
+
+		uint32_t m_Frame = 0;
+		bool m_Finished = false;
+		Timer m_Timer;
+
+		// In the order the scheduler runs them
+		std::vector<SystemStatistics> m_Statistics;
+		SystemStatistics m_FrameStatistics;
+	};
+
+}
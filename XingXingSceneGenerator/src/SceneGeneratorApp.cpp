@@ -0,0 +1,68 @@
+#include <xingxing.h>
+#include <xingxing/Core/EntryPoint.h>
+
+#include "XingXing/Scene/SceneSerializer.h"
+#include "XingXing/Scripting/ScriptEngine.h"
+#include "XingXing/Core/Timer.h"
+
+namespace Hazel {
+
+	// Writes a scene built by SceneGenerator from a parameter file, then exits.
+	// The window is never shown; the context is there for loading the textures sprites refer to.
+	class SceneGeneratorApp : public Application
+	{
+	public:
+		SceneGeneratorApp(const ApplicationSpecification& spec)
+			: Application(spec)
+		{
+			const ApplicationCommandLineArgs& args = spec.CommandLineArgs;
+			if (args.Count != 4)
+				HZ_INFO("Usage: XingXingSceneGenerator <project.hproj> <parameters.hgen> <output.hazel>");
+			else
+				Generate(args[1], args[2], args[3]);
+
+			Close();
+		}
+	private:
+		void Generate(const std::filesystem::path& projectPath, const std::filesystem::path& parametersPath, const std::filesystem::path& outputPath)
+		{
+			if (!Project::Load(projectPath))
+			{
+				HZ_ERROR("Could not load project {0}", projectPath.string());
+				return;
+			}
+
+			// Script fields are written with their defaults, which come from the script classes
+			ScriptEngine::Init();
+
+			SceneGeneratorSpecification specification;
+			if (!SceneGenerator::LoadSpecification(parametersPath, specification))
+			{
+				HZ_ERROR("Could not load parameters {0}", parametersPath.string());
+				return;
+			}
+
+			Timer timer;
+			Ref<Scene> scene = SceneGenerator::Generate(specification);
+			float generateTime = timer.ElapsedMillis();
+
+			timer.Reset();
+			SceneSerializer serializer(scene);
+			serializer.Serialize(outputPath.string());
+
+			HZ_INFO("Generated {0} entities in {1:.1f} ms, wrote {2} in {3:.1f} ms", scene->GetAllEntitiesWith<IDComponent>().size(),
+				generateTime, outputPath.string(), timer.ElapsedMillis());
+		}
+	};
+
+	Application* CreateApplication(ApplicationCommandLineArgs args)
+	{
+		ApplicationSpecification spec;
+		spec.Name = "XingXing Scene Generator";
+		spec.CommandLineArgs = args;
+		spec.WindowVisible = false;
+
+		return new SceneGeneratorApp(spec);
+	}
+
+}
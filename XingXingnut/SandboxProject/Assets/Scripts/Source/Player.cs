@@ -12,6 +12,7 @@ namespace Sandbox
 	{
 		private TransformComponent m_Transform;
 		private Rigidbody2DComponent m_Rigidbody;
+		private Vector3 m_Input = Vector3.Zero;
 
 		public float Speed;
 		public float Time = 0.0f;
@@ -54,14 +55,18 @@ namespace Sandbox
 					camera.DistanceFromPlayer -= speed * 2.0f * ts;
 			}
 
-			velocity *= speed * ts;
-
-			m_Rigidbody.ApplyLinearImpulse(velocity.XY, true);
+			m_Input = velocity * speed;
 
 			//Vector3 translation = m_Transform.Translation;
 			//translation += velocity * ts;
 			//m_Transform.Translation = translation;
 		}
 
+		// Forces go to the physics body at the fixed rate, so the movement is the same at any frame rate
+		void OnFixedUpdate(float ts)
+		{
+			m_Rigidbody.ApplyLinearImpulse(m_Input.XY * ts, true);
+		}
+
 	}
 }
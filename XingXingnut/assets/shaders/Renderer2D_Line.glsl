@@ -7,12 +7,18 @@
 #version 450 core
 
 layout(location = 0) in vec3 a_Position;
-layout(location = 1) in vec4 a_Color;
-layout(location = 2) in int a_EntityID;
+layout(location = 1) in vec3 a_OtherPosition;
+layout(location = 2) in vec3 a_JoinPosition;
+layout(location = 3) in vec4 a_Color;
+layout(location = 4) in vec2 a_Corner;
+layout(location = 5) in float a_Width;
+layout(location = 6) in int a_Cap;
+layout(location = 7) in int a_EntityID;
 
 layout(std140, binding = 0) uniform Camera
 {
 	mat4 u_ViewProjection;
+	vec2 u_ViewportSize;
 };
 
 struct VertexOutput
@@ -22,13 +28,66 @@ struct VertexOutput
 
 layout (location = 0) out VertexOutput Output;
 layout (location = 1) out flat int v_EntityID;
+// x: distance across the line, y: distance along the segment, z: segment length, w: half width (all in pixels)
+layout (location = 2) out noperspective vec4 v_LineCoords;
+layout (location = 3) out flat int v_Cap;
+
+vec2 ToScreen(vec4 clipPosition)
+{
+	return clipPosition.xy / clipPosition.w * 0.5 * u_ViewportSize;
+}
 
 void main()
 {
+	// Each segment is a quad whose vertices all carry both endpoints; a_Corner.x picks the side of the
+	// segment and a_Corner.y whether this vertex belongs to its start (0) or end (1)
+	vec4 clipPosition = u_ViewProjection * vec4(a_Position, 1.0);
+	vec2 position = ToScreen(clipPosition);
+	vec2 other = ToScreen(u_ViewProjection * vec4(a_OtherPosition, 1.0));
+	vec2 join = ToScreen(u_ViewProjection * vec4(a_JoinPosition, 1.0));
+
+	bool isEnd = a_Corner.y > 0.5;
+	vec2 segment = isEnd ? position - other : other - position;
+	float segmentLength = length(segment);
+	vec2 direction = segmentLength > 0.0001 ? segment / segmentLength : vec2(1.0, 0.0);
+	vec2 normal = vec2(-direction.y, direction.x);
+
+	float halfWidth = a_Width * 0.5;
+	// One extra pixel on each side leaves room for the anti-aliased edge
+	float extent = halfWidth + 1.0;
+
+	vec2 offset = normal * a_Corner.x * extent;
+	float along = isEnd ? segmentLength : 0.0;
+
+	// The join position is the neighbouring polyline point, or this point itself at a free end
+	vec2 joinSegment = isEnd ? join - position : position - join;
+	if (length(joinSegment) > 0.0001)
+	{
+		vec2 joinDirection = normalize(joinSegment);
+		vec2 miter = normal + vec2(-joinDirection.y, joinDirection.x);
+		if (length(miter) > 0.0001)
+		{
+			miter = normalize(miter);
+			// Miter limit: very sharp corners get clamped instead of producing long spikes
+			offset = miter * a_Corner.x * extent / max(dot(miter, normal), 0.25);
+		}
+	}
+	else if (a_Cap != 0)
+	{
+		// Square and round caps extend the segment by half its width
+		float capDirection = isEnd ? 1.0 : -1.0;
+		offset += direction * capDirection * extent;
+		along += capDirection * extent;
+	}
+
 	Output.Color = a_Color;
 	v_EntityID = a_EntityID;
+	v_LineCoords = vec4(a_Corner.x * extent, along, segmentLength, halfWidth);
+	v_Cap = a_Cap;
 
-	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+	position += offset;
+	clipPosition.xy = position / (0.5 * u_ViewportSize) * clipPosition.w;
+	gl_Position = clipPosition;
 }
 
 #type fragment
@@ -44,9 +103,30 @@ struct VertexOutput
 
 layout (location = 0) in VertexOutput Input;
 layout (location = 1) in flat int v_EntityID;
+layout (location = 2) in noperspective vec4 v_LineCoords;
+layout (location = 3) in flat int v_Cap;
 
 void main()
 {
+	float across = v_LineCoords.x;
+	float along = v_LineCoords.y;
+	float segmentLength = v_LineCoords.z;
+	float halfWidth = v_LineCoords.w;
+
+	float edgeDistance = abs(across);
+	if (v_Cap == 2) // Round
+	{
+		if (along < 0.0)
+			edgeDistance = length(vec2(along, across));
+		else if (along > segmentLength)
+			edgeDistance = length(vec2(along - segmentLength, across));
+	}
+
+	float alpha = clamp(halfWidth - edgeDistance + 0.5, 0.0, 1.0);
+	if (alpha == 0.0)
+		discard;
+
 	o_Color = Input.Color;
+	o_Color.a *= alpha;
 	o_EntityID = v_EntityID;
 }
@@ -0,0 +1,196 @@
+//--------------------------
+// - Hazel 2D -
+// Renderer2D Unified Shader
+// Textured quads, SDF circles and MSDF text in a single pipeline
+// --------------------------
+
+#type vertex
+#version 450 core
+
+layout(location = 0) in vec3 a_Position;
+layout(location = 1) in vec4 a_Color;
+layout(location = 2) in vec2 a_TexCoord;
+layout(location = 3) in vec2 a_Params;
+layout(location = 4) in float a_TexIndex;
+layout(location = 5) in int a_Kind;
+layout(location = 6) in int a_EntityID;
+
+layout(std140, binding = 0) uniform Camera
+{
+	mat4 u_ViewProjection;
+	vec2 u_ViewportSize;
+};
+
+struct VertexOutput
+{
+	vec4 Color;
+	vec2 TexCoord;
+	vec2 Params;
+};
+
+layout (location = 0) out VertexOutput Output;
+layout (location = 3) out flat float v_TexIndex;
+layout (location = 4) out flat int v_Kind;
+layout (location = 5) out flat int v_EntityID;
+
+void main()
+{
+	Output.Color = a_Color;
+	Output.TexCoord = a_TexCoord;
+	Output.Params = a_Params;
+	v_TexIndex = a_TexIndex;
+	v_Kind = a_Kind;
+	v_EntityID = a_EntityID;
+
+	gl_Position = u_ViewProjection * vec4(a_Position, 1.0);
+}
+
+#type fragment
+#version 450 core
+
+layout(location = 0) out vec4 o_Color;
+layout(location = 1) out int o_EntityID;
+
+struct VertexOutput
+{
+	vec4 Color;
+	vec2 TexCoord;
+	vec2 Params;
+};
+
+layout (location = 0) in VertexOutput Input;
+layout (location = 3) in flat float v_TexIndex;
+layout (location = 4) in flat int v_Kind;
+layout (location = 5) in flat int v_EntityID;
+
+layout (binding = 0) uniform sampler2D u_Textures[32];
+
+// Must match Renderer2D's UnifiedPrimitiveKind
+const int PrimitiveKind_Quad = 0;
+const int PrimitiveKind_Circle = 1;
+const int PrimitiveKind_Text = 2;
+
+vec4 SampleTexture(int index, vec2 texCoord)
+{
+	switch(index)
+	{
+		case  0: return texture(u_Textures[ 0], texCoord);
+		case  1: return texture(u_Textures[ 1], texCoord);
+		case  2: return texture(u_Textures[ 2], texCoord);
+		case  3: return texture(u_Textures[ 3], texCoord);
+		case  4: return texture(u_Textures[ 4], texCoord);
+		case  5: return texture(u_Textures[ 5], texCoord);
+		case  6: return texture(u_Textures[ 6], texCoord);
+		case  7: return texture(u_Textures[ 7], texCoord);
+		case  8: return texture(u_Textures[ 8], texCoord);
+		case  9: return texture(u_Textures[ 9], texCoord);
+		case 10: return texture(u_Textures[10], texCoord);
+		case 11: return texture(u_Textures[11], texCoord);
+		case 12: return texture(u_Textures[12], texCoord);
+		case 13: return texture(u_Textures[13], texCoord);
+		case 14: return texture(u_Textures[14], texCoord);
+		case 15: return texture(u_Textures[15], texCoord);
+		case 16: return texture(u_Textures[16], texCoord);
+		case 17: return texture(u_Textures[17], texCoord);
+		case 18: return texture(u_Textures[18], texCoord);
+		case 19: return texture(u_Textures[19], texCoord);
+		case 20: return texture(u_Textures[20], texCoord);
+		case 21: return texture(u_Textures[21], texCoord);
+		case 22: return texture(u_Textures[22], texCoord);
+		case 23: return texture(u_Textures[23], texCoord);
+		case 24: return texture(u_Textures[24], texCoord);
+		case 25: return texture(u_Textures[25], texCoord);
+		case 26: return texture(u_Textures[26], texCoord);
+		case 27: return texture(u_Textures[27], texCoord);
+		case 28: return texture(u_Textures[28], texCoord);
+		case 29: return texture(u_Textures[29], texCoord);
+		case 30: return texture(u_Textures[30], texCoord);
+		case 31: return texture(u_Textures[31], texCoord);
+	}
+	return vec4(1.0);
+}
+
+vec2 GetTextureSize(int index)
+{
+	switch(index)
+	{
+		case  0: return vec2(textureSize(u_Textures[ 0], 0));
+		case  1: return vec2(textureSize(u_Textures[ 1], 0));
+		case  2: return vec2(textureSize(u_Textures[ 2], 0));
+		case  3: return vec2(textureSize(u_Textures[ 3], 0));
+		case  4: return vec2(textureSize(u_Textures[ 4], 0));
+		case  5: return vec2(textureSize(u_Textures[ 5], 0));
+		case  6: return vec2(textureSize(u_Textures[ 6], 0));
+		case  7: return vec2(textureSize(u_Textures[ 7], 0));
+		case  8: return vec2(textureSize(u_Textures[ 8], 0));
+		case  9: return vec2(textureSize(u_Textures[ 9], 0));
+		case 10: return vec2(textureSize(u_Textures[10], 0));
+		case 11: return vec2(textureSize(u_Textures[11], 0));
+		case 12: return vec2(textureSize(u_Textures[12], 0));
+		case 13: return vec2(textureSize(u_Textures[13], 0));
+		case 14: return vec2(textureSize(u_Textures[14], 0));
+		case 15: return vec2(textureSize(u_Textures[15], 0));
+		case 16: return vec2(textureSize(u_Textures[16], 0));
+		case 17: return vec2(textureSize(u_Textures[17], 0));
+		case 18: return vec2(textureSize(u_Textures[18], 0));
+		case 19: return vec2(textureSize(u_Textures[19], 0));
+		case 20: return vec2(textureSize(u_Textures[20], 0));
+		case 21: return vec2(textureSize(u_Textures[21], 0));
+		case 22: return vec2(textureSize(u_Textures[22], 0));
+		case 23: return vec2(textureSize(u_Textures[23], 0));
+		case 24: return vec2(textureSize(u_Textures[24], 0));
+		case 25: return vec2(textureSize(u_Textures[25], 0));
+		case 26: return vec2(textureSize(u_Textures[26], 0));
+		case 27: return vec2(textureSize(u_Textures[27], 0));
+		case 28: return vec2(textureSize(u_Textures[28], 0));
+		case 29: return vec2(textureSize(u_Textures[29], 0));
+		case 30: return vec2(textureSize(u_Textures[30], 0));
+		case 31: return vec2(textureSize(u_Textures[31], 0));
+	}
+	return vec2(1.0);
+}
+
+float median(float r, float g, float b) {
+    return max(min(r, g), min(max(r, g), b));
+}
+
+void main()
+{
+	int texIndex = int(v_TexIndex);
+	// Derivatives have to be taken outside of the per-kind branches
+	vec2 texCoordWidth = fwidth(Input.TexCoord);
+
+	vec4 color = Input.Color;
+	if (v_Kind == PrimitiveKind_Quad)
+	{
+		// Params.x: tiling factor
+		color *= SampleTexture(texIndex, Input.TexCoord * Input.Params.x);
+	}
+	else if (v_Kind == PrimitiveKind_Circle)
+	{
+		// TexCoord: local position in [-1, 1], Params: thickness and fade
+		float distance = 1.0 - length(Input.TexCoord);
+		float circle = smoothstep(0.0, Input.Params.y, distance);
+		circle *= smoothstep(Input.Params.x + Input.Params.y, Input.Params.x, distance);
+		color.a *= circle;
+	}
+	else if (v_Kind == PrimitiveKind_Text)
+	{
+		const float pxRange = 2.0; // set to distance field's pixel range
+		vec2 unitRange = vec2(pxRange) / GetTextureSize(texIndex);
+		vec2 screenTexSize = vec2(1.0) / texCoordWidth;
+		float screenPxRange = max(0.5 * dot(unitRange, screenTexSize), 1.0);
+
+		vec3 msd = SampleTexture(texIndex, Input.TexCoord).rgb;
+		float sd = median(msd.r, msd.g, msd.b);
+		float screenPxDistance = screenPxRange * (sd - 0.5);
+		float opacity = clamp(screenPxDistance + 0.5, 0.0, 1.0);
+		color = mix(vec4(0.0), Input.Color, opacity);
+	}
+
+	if (color.a == 0.0)
+		discard;
+
+	o_Color = color;
+	o_EntityID = v_EntityID;
+}
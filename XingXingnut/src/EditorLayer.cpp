@@ -1,9 +1,13 @@
 #include "EditorLayer.h"
 #include "XingXing/Scene/SceneSerializer.h"
+#include "XingXing/Scene/Prefab.h"
 #include "XingXing/Utils/PlatformUtils.h"
 #include "XingXing/Math/Math.h"
 #include "XingXing/Scripting/ScriptEngine.h"
 #include "XingXing/Renderer/Font.h"
+#include "XingXing/Renderer/GPUResourceRegistry.h"
+#include "XingXing/Core/FrameAllocator.h"
+#include "XingXing/Core/AllocationTracker.h"
 
 #include <imgui/imgui.h>
 
@@ -83,6 +87,7 @@ namespace Hazel {
 			m_Framebuffer->Resize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
 			m_CameraController.OnResize(m_ViewportSize.x, m_ViewportSize.y);
 			m_EditorCamera.SetViewportSize(m_ViewportSize.x, m_ViewportSize.y);
+			Renderer2D::SetViewportSize((uint32_t)m_ViewportSize.x, (uint32_t)m_ViewportSize.y);
 		}
 
 		// Render
@@ -132,6 +137,28 @@ namespace Hazel {
 		{
 			int pixelData = m_Framebuffer->ReadPixel(1, mouseX, mouseY);
 			m_HoveredEntity = pixelData == -1 ? Entity() : Entity((entt::entity)pixelData, m_ActiveScene.get());
+
+			// Entities that draw nothing, e.g. bare colliders, aren't in the ID buffer; find them by their bounds
+			if (!m_HoveredEntity && m_SceneState != SceneState::Play)
+			{
+				glm::vec2 ndc = { mx / viewportSize.x * 2.0f - 1.0f, my / viewportSize.y * 2.0f - 1.0f };
+				glm::mat4 inverseViewProjection = glm::inverse(m_EditorCamera.GetViewProjection());
+				glm::vec4 nearPoint = inverseViewProjection * glm::vec4(ndc, -1.0f, 1.0f);
+				glm::vec4 farPoint = inverseViewProjection * glm::vec4(ndc, 1.0f, 1.0f);
+				glm::vec3 rayStart = glm::vec3(nearPoint) / nearPoint.w;
+				glm::vec3 rayEnd = glm::vec3(farPoint) / farPoint.w;
+
+				// Where the mouse ray meets the z = 0 plane
+				if (rayStart.z != rayEnd.z)
+				{
+					float t = rayStart.z / (rayStart.z - rayEnd.z);
+					glm::vec2 worldPoint = glm::vec2(rayStart + (rayEnd - rayStart) * t);
+
+					std::vector<Entity> entities = m_ActiveScene->QueryPoint(worldPoint);
+					if (!entities.empty())
+						m_HoveredEntity = entities.front();
+				}
+			}
 		}
 
 		OnOverlayRender();
@@ -211,6 +238,9 @@ namespace Hazel {
 				if (ImGui::MenuItem("Save Scene As...", "Ctrl+Shift+S"))
 					SaveSceneAs();
 
+				if (ImGui::MenuItem("Partition World...", nullptr, false, m_SceneState == SceneState::Edit))
+					PartitionWorld();
+
 				ImGui::Separator();
 
 				if (ImGui::MenuItem("Exit"))
@@ -232,6 +262,7 @@ namespace Hazel {
 
 		m_SceneHierarchyPanel.OnImGuiRender();
 		m_ContentBrowserPanel->OnImGuiRender();
+		m_SystemSchedulePanel.OnImGuiRender();
 
 		ImGui::Begin("Stats");
 
@@ -246,14 +277,94 @@ namespace Hazel {
 		ImGui::Text("Renderer2D Stats:");
 		ImGui::Text("Draw Calls: %d", stats.DrawCalls);
 		ImGui::Text("Quads: %d", stats.QuadCount);
+		ImGui::Text("Lines: %d", stats.LineCount);
 		ImGui::Text("Vertices: %d", stats.GetTotalVertexCount());
 		ImGui::Text("Indices: %d", stats.GetTotalIndexCount());
 
+		auto gpuStats = GPUResourceRegistry::GetStats();
+		ImGui::Separator();
+		ImGui::Text("GPU Memory:");
+		for (size_t i = 0; i < (size_t)GPUResourceCategory::Count; i++)
+		{
+			ImGui::Text("%s: %.2f MB (%d)", GPUResourceCategoryToString((GPUResourceCategory)i),
+				gpuStats.Usage[i] / (1024.0f * 1024.0f), gpuStats.ResourceCount[i]);
+		}
+		ImGui::Text("Total: %.2f MB", gpuStats.GetTotalUsage() / (1024.0f * 1024.0f));
+		ImGui::Text("Evicted Textures: %d", gpuStats.EvictedTextureCount);
+
+		ImGui::Separator();
+		ImGui::Text("CPU Memory:");
+		if (AllocationTracker::IsEnabled())
+		{
+			auto allocationStats = AllocationTracker::GetStats();
+			ImGui::Text("Heap Allocations: %llu per frame (%.1f KB)", allocationStats.AllocationsLastFrame, allocationStats.BytesLastFrame / 1024.0f);
+		}
+		else
+			ImGui::Text("Heap Allocations: not tracked (HZ_TRACK_ALLOCATIONS)");
+		auto frameStats = FrameAllocator::GetStats();
+		ImGui::Text("Frame Arena: %.1f/%.0f KB (%d overflows)", frameStats.UsedLastFrame / 1024.0f, frameStats.Capacity / 1024.0f, frameStats.OverflowsLastFrame);
+
+		if (m_ActiveScene->IsRunning())
+		{
+			const auto& lodStats = m_ActiveScene->GetUpdateLODStatistics();
+			ImGui::Separator();
+			ImGui::Text("Script Update LOD:");
+			ImGui::Text("Full: %d", lodStats.Full);
+			ImGui::Text("Reduced: %d", lodStats.Reduced);
+			ImGui::Text("Suspended: %d", lodStats.Suspended);
+		}
+
+		if (RewindBuffer* rewindBuffer = m_ActiveScene->GetRewindBuffer())
+		{
+			const auto& rewindStats = rewindBuffer->GetStatistics();
+			ImGui::Separator();
+			ImGui::Text("Rewind:");
+			ImGui::Text("Capture: %.3f ms", rewindStats.LastCaptureTime);
+			ImGui::Text("Frame: %d bytes (%d before delta)", rewindStats.LastFrameSize, rewindStats.LastSnapshotSize);
+			ImGui::Text("Recorded: %.1f s in %d frames, %.2f MB", rewindStats.RecordedSeconds, rewindStats.FrameCount, rewindStats.UsedBytes / (1024.0f * 1024.0f));
+		}
+
+		if (WorldPartition* world = m_ActiveScene->GetWorldPartition())
+		{
+			const auto& worldStats = world->GetStatistics();
+			ImGui::Separator();
+			ImGui::Text("World Streaming:");
+			ImGui::Text("Resident Cells: %d (%d entities)", worldStats.ResidentCells, worldStats.ResidentEntities);
+			ImGui::Text("Loading Cells: %d", worldStats.LoadingCells);
+			ImGui::Text("Loaded/Unloaded: %d/%d", worldStats.CellsLoaded, worldStats.CellsUnloaded);
+			ImGui::Text("Load Latency: %.2f ms (avg %.2f, max %.2f)", worldStats.LastLoadLatency, worldStats.AverageLoadLatency, worldStats.MaxLoadLatency);
+		}
+
 		ImGui::End();
 
 		ImGui::Begin("Settings");
 		ImGui::Checkbox("Show physics colliders", &m_ShowPhysicsColliders);
 
+		int gpuMemoryBudget = (int)(GPUResourceRegistry::GetBudget() / (1024 * 1024));
+		if (ImGui::DragInt("GPU Memory Budget (MB)", &gpuMemoryBudget, 1.0f, 0, 16384, gpuMemoryBudget == 0 ? "Unlimited" : "%d"))
+			GPUResourceRegistry::SetBudget((uint64_t)gpuMemoryBudget * 1024 * 1024);
+
+		bool unifiedPipeline = Renderer2D::IsUnifiedPipelineEnabled();
+		if (ImGui::Checkbox("Unified 2D pipeline", &unifiedPipeline))
+			Renderer2D::SetUnifiedPipelineEnabled(unifiedPipeline);
+
+		bool rewind = m_ActiveScene->IsRewindEnabled();
+		if (ImGui::Checkbox("Record rewind", &rewind))
+			m_ActiveScene->SetRewindEnabled(rewind);
+
+		if (RewindBuffer* rewindBuffer = m_ActiveScene->GetRewindBuffer())
+		{
+			// Scrubbing pauses the scene, playing on continues from the restored frame
+			if (!m_ActiveScene->IsPaused())
+				m_RewindSeconds = 0.0f;
+
+			if (ImGui::SliderFloat("Rewind (s)", &m_RewindSeconds, 0.0f, rewindBuffer->GetRecordedSeconds()))
+			{
+				m_ActiveScene->SetPaused(true);
+				rewindBuffer->Rewind(*m_ActiveScene, m_RewindSeconds);
+			}
+		}
+
 		ImGui::Image((ImTextureID)s_Font->GetAtlasTexture()->GetRendererID(), { 512,512 }, {0, 1}, {1, 0});
 
 
@@ -282,8 +393,11 @@ namespace Hazel {
 		{
 			if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("CONTENT_BROWSER_ITEM"))
 			{
-				const wchar_t* path = (const wchar_t*)payload->Data;
-				OpenScene(path);
+				std::filesystem::path path = (const wchar_t*)payload->Data;
+				if (path.extension().string() == ".hprefab")
+					InstantiatePrefab(path);
+				else
+					OpenScene(path);
 			}
 			ImGui::EndDragDropTarget();
 		}
@@ -309,9 +423,9 @@ namespace Hazel {
 			const glm::mat4& cameraProjection = m_EditorCamera.GetProjection();
 			glm::mat4 cameraView = m_EditorCamera.GetViewMatrix();
 
-			// Entity transform
+			// Entity transform, manipulated in world space
 			auto& tc = selectedEntity.GetComponent<TransformComponent>();
-			glm::mat4 transform = tc.GetTransform();
+			glm::mat4 transform = selectedEntity.GetComponent<WorldTransformComponent>().Transform;
 
 			// Snapping
 			bool snap = Input::IsKeyPressed(Key::LeftControl);
@@ -328,6 +442,9 @@ namespace Hazel {
 
 			if (ImGuizmo::IsUsing())
 			{
+				if (Entity parent = selectedEntity.GetParent())
+					transform = glm::inverse(parent.GetComponent<WorldTransformComponent>().Transform) * transform;
+
 				glm::vec3 translation, rotation, scale;
 				Math::DecomposeTransform(transform, translation, rotation, scale);
 
@@ -558,7 +675,7 @@ namespace Hazel {
 			if (!camera)
 				return;
 			
-			Renderer2D::BeginScene(camera.GetComponent<CameraComponent>().Camera, camera.GetComponent<TransformComponent>().GetTransform());
+			Renderer2D::BeginScene(camera.GetComponent<CameraComponent>().Camera, camera.GetComponent<WorldTransformComponent>().Transform);
 		}
 		else
 		{
@@ -569,7 +686,7 @@ namespace Hazel {
 		{
 			// Box Colliders
 			{
-				auto view = m_ActiveScene->GetAllEntitiesWith<TransformComponent, BoxCollider2DComponent>();
+				auto view = m_ActiveScene->GetAllActiveEntitiesWith<TransformComponent, BoxCollider2DComponent>();
 				for (auto entity : view)
 				{
 					auto [tc, bc2d] = view.get<TransformComponent, BoxCollider2DComponent>(entity);
@@ -588,7 +705,7 @@ namespace Hazel {
 
 			// Circle Colliders
 			{
-				auto view = m_ActiveScene->GetAllEntitiesWith<TransformComponent, CircleCollider2DComponent>();
+				auto view = m_ActiveScene->GetAllActiveEntitiesWith<TransformComponent, CircleCollider2DComponent>();
 				for (auto entity : view)
 				{
 					auto [tc, cc2d] = view.get<TransformComponent, CircleCollider2DComponent>(entity);
@@ -599,7 +716,7 @@ namespace Hazel {
 					glm::mat4 transform = glm::translate(glm::mat4(1.0f), translation)
 						* glm::scale(glm::mat4(1.0f), scale);
 
-					Renderer2D::DrawCircle(transform, glm::vec4(0, 1, 0, 1), 0.01f);
+					Renderer2D::DrawCircleOutline(transform, glm::vec4(0, 1, 0, 1));
 				}
 			}
 		}
@@ -607,8 +724,8 @@ namespace Hazel {
 		// Draw selected entity outline 
 		if (Entity selectedEntity = m_SceneHierarchyPanel.GetSelectedEntity())
 		{
-			const TransformComponent& transform = selectedEntity.GetComponent<TransformComponent>();
-			Renderer2D::DrawRect(transform.GetTransform(), glm::vec4(1.0f, 0.5f, 0.0f, 1.0f));
+			const WorldTransformComponent& transform = selectedEntity.GetComponent<WorldTransformComponent>();
+			Renderer2D::DrawRect(transform.Transform, glm::vec4(1.0f, 0.5f, 0.0f, 1.0f));
 		}
 
 		Renderer2D::EndScene();
@@ -651,6 +768,7 @@ namespace Hazel {
 	{
 		m_ActiveScene = CreateRef<Scene>();
 		m_SceneHierarchyPanel.SetContext(m_ActiveScene);
+		m_SystemSchedulePanel.SetContext(m_ActiveScene);
 		
 		m_EditorScenePath = std::filesystem::path();
 	}
@@ -679,6 +797,7 @@ namespace Hazel {
 		{
 			m_EditorScene = newScene;
 			m_SceneHierarchyPanel.SetContext(m_EditorScene);
+			m_SystemSchedulePanel.SetContext(m_EditorScene);
 
 			m_ActiveScene = m_EditorScene;
 			m_EditorScenePath = path;
@@ -709,6 +828,40 @@ namespace Hazel {
 		serializer.Serialize(path.string());
 	}
 
+	void EditorLayer::InstantiatePrefab(const std::filesystem::path& path)
+	{
+		if (m_SceneState != SceneState::Edit)
+			return;
+
+		Ref<Prefab> prefab = Prefab::Load(path);
+		if (prefab)
+			m_SceneHierarchyPanel.SetSelectedEntity(m_EditorScene->InstantiatePrefab(prefab));
+	}
+
+	void EditorLayer::PartitionWorld()
+	{
+		if (m_SceneState != SceneState::Edit)
+			return;
+
+		std::string filepath = FileDialogs::SaveFile("Hazel World (*.hzworld)\0*.hzworld\0");
+		if (filepath.empty())
+			return;
+
+		// The streamed entities are moved out of the scene, which then only holds what is always loaded.
+		// Picking an existing world replaces it, see WorldPartition::Partition.
+		if (WorldPartition::Partition(*m_EditorScene, filepath))
+		{
+			// Kept relative to the asset directory, like the scene's other paths, so the project can be moved
+			std::error_code error;
+			std::filesystem::path worldPath = std::filesystem::relative(filepath, Project::GetAssetDirectory(), error);
+
+			WorldPartitionSpecification world = m_EditorScene->GetWorldSpecification();
+			world.WorldPath = worldPath.empty() ? std::filesystem::path(filepath) : worldPath;
+			m_EditorScene->SetWorldSpecification(world);
+			m_SceneHierarchyPanel.SetSelectedEntity({});
+		}
+	}
+
 	void EditorLayer::OnScenePlay()
 	{
 		if (m_SceneState == SceneState::Simulate)
@@ -720,6 +873,7 @@ namespace Hazel {
 		m_ActiveScene->OnRuntimeStart();
 
 		m_SceneHierarchyPanel.SetContext(m_ActiveScene);
+		m_SystemSchedulePanel.SetContext(m_ActiveScene);
 	}
 
 	void EditorLayer::OnSceneSimulate()
@@ -733,6 +887,7 @@ namespace Hazel {
 		m_ActiveScene->OnSimulationStart();
 
 		m_SceneHierarchyPanel.SetContext(m_ActiveScene);
+		m_SystemSchedulePanel.SetContext(m_ActiveScene);
 	}
 
 	void EditorLayer::OnSceneStop()
@@ -749,6 +904,7 @@ namespace Hazel {
 		m_ActiveScene = m_EditorScene;
 
 		m_SceneHierarchyPanel.SetContext(m_ActiveScene);
+		m_SystemSchedulePanel.SetContext(m_ActiveScene);
 	}
 
 	void EditorLayer::OnScenePause()
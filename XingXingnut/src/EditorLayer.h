@@ -3,6 +3,7 @@
 #include "xingxing.h"
 #include "Panels/SceneHierarchyPanel.h"
 #include "Panels/ContentBrowserPanel.h"
+#include "Panels/SystemSchedulePanel.h"
 
 #include "XingXing/Renderer/EditorCamera.h"
 
@@ -39,6 +40,9 @@ namespace Hazel {
 
 		void SerializeScene(Ref<Scene> scene, const std::filesystem::path& path);
 
+		void InstantiatePrefab(const std::filesystem::path& path);
+		void PartitionWorld();
+
 		void OnScenePlay();
 		void OnSceneSimulate();
 		void OnSceneStop();
@@ -80,6 +84,8 @@ namespace Hazel {
 		int m_GizmoType = -1;
 
 		bool m_ShowPhysicsColliders = false;
+		// How far back the rewind slider is, in seconds
+		float m_RewindSeconds = 0.0f;
 
 		enum class SceneState
 		{
@@ -89,6 +95,7 @@ namespace Hazel {
 
 		// Panels
 		SceneHierarchyPanel m_SceneHierarchyPanel;
+		SystemSchedulePanel m_SystemSchedulePanel;
 		Scope<ContentBrowserPanel> m_ContentBrowserPanel;
 
 		// Editor resources
@@ -20,6 +20,7 @@ namespace Hazel {
 		ApplicationSpecification spec;
 		spec.Name = "Hazelnut";
 		spec.CommandLineArgs = args;
+		spec.RenderThreadingPolicy = ThreadingPolicy::MultiThreaded;
 
 		return new Hazelnut(spec);
 	}
@@ -1,8 +1,12 @@
 #include "SceneHierarchyPanel.h"
 #include "XingXing/Scene/Components.h"
 
+#include "XingXing/Scene/Prefab.h"
 #include "XingXing/Scripting/ScriptEngine.h"
+#include "XingXing/Utils/PlatformUtils.h"
 #include "XingXing/UI/UI.h"
+#include "XingXing/Project/Project.h"
+#include "XingXing/Renderer/TextureAtlas.h"
 
 #include <imgui/imgui.h>
 #include <imgui/imgui_internal.h>
@@ -38,15 +42,44 @@ namespace Hazel {
 
 		if (m_Context)
 		{
-			m_Context->m_Registry.each([&](auto entityID)
-				{
-					Entity entity{ entityID , m_Context.get() };
-					DrawEntityNode(entity);
-				});
+			ImGui::PushItemWidth(-1);
+			ImGui::InputTextWithHint("##Search", "Search", &m_SearchFilter);
+			ImGui::PopItemWidth();
+
+			if (m_SearchFilter.empty())
+			{
+				// Children are drawn by their parents. Collect the roots first, nodes can be deleted or reparented while drawing.
+				std::vector<Entity> roots;
+				m_Context->m_Registry.view<RelationshipComponent>().each([&](auto entityID, const RelationshipComponent& relationship)
+					{
+						if (relationship.Parent == 0)
+							roots.push_back(Entity{ entityID, m_Context.get() });
+					});
+
+				for (auto it = roots.rbegin(); it != roots.rend(); ++it)
+					DrawEntityNode(*it, true);
+			}
+			else
+			{
+				for (Entity entity : m_Context->FindEntitiesByNamePrefix(m_SearchFilter))
+					DrawEntityNode(entity, false);
+			}
 
 			if (ImGui::IsMouseDown(0) && ImGui::IsWindowHovered())
 				m_SelectionContext = {};
 
+			// Dropping an entity on blank space makes it a root again
+			if (ImGui::BeginDragDropTargetCustom(ImGui::GetCurrentWindow()->InnerRect, ImGui::GetID("Scene Hierarchy")))
+			{
+				if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("SCENE_HIERARCHY_ENTITY"))
+				{
+					Entity child = m_Context->GetEntityByUUID(*(const UUID*)payload->Data);
+					if (child)
+						m_Context->SetParent(child, {}, true);
+				}
+				ImGui::EndDragDropTarget();
+			}
+
 			// Right-click on blank space
 			if (ImGui::BeginPopupContextWindow(0, 1, false))
 			{
@@ -73,21 +106,62 @@ namespace Hazel {
 		m_SelectionContext = entity;
 	}
 
-	void SceneHierarchyPanel::DrawEntityNode(Entity entity)
+	void SceneHierarchyPanel::DrawEntityNode(Entity entity, bool drawChildren)
 	{
 		auto& tag = entity.GetComponent<TagComponent>().Tag;
+		// Copied, the children can change while they are being drawn
+		std::vector<UUID> children = drawChildren ? entity.GetChildren() : std::vector<UUID>();
 		
 		ImGuiTreeNodeFlags flags = ((m_SelectionContext == entity) ? ImGuiTreeNodeFlags_Selected : 0) | ImGuiTreeNodeFlags_OpenOnArrow;
 		flags |= ImGuiTreeNodeFlags_SpanAvailWidth;
+		if (children.empty())
+			flags |= ImGuiTreeNodeFlags_Leaf;
+		bool active = entity.IsActive();
+		if (!active)
+			ImGui::PushStyleColor(ImGuiCol_Text, ImGui::GetStyleColorVec4(ImGuiCol_TextDisabled));
 		bool opened = ImGui::TreeNodeEx((void*)(uint64_t)(uint32_t)entity, flags, tag.c_str());
+		if (!active)
+			ImGui::PopStyleColor();
 		if (ImGui::IsItemClicked())
 		{
 			m_SelectionContext = entity;
 		}
 
+		if (ImGui::BeginDragDropSource())
+		{
+			UUID uuid = entity.GetUUID();
+			ImGui::SetDragDropPayload("SCENE_HIERARCHY_ENTITY", &uuid, sizeof(UUID));
+			ImGui::Text(tag.c_str());
+			ImGui::EndDragDropSource();
+		}
+
+		if (ImGui::BeginDragDropTarget())
+		{
+			if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("SCENE_HIERARCHY_ENTITY"))
+			{
+				Entity child = m_Context->GetEntityByUUID(*(const UUID*)payload->Data);
+				if (child)
+					m_Context->SetParent(child, entity, true);
+			}
+			ImGui::EndDragDropTarget();
+		}
+
 		bool entityDeleted = false;
 		if (ImGui::BeginPopupContextItem())
 		{
+			if (ImGui::MenuItem("Create Child Entity"))
+			{
+				Entity child = m_Context->CreateEntity("Empty Entity");
+				m_Context->SetParent(child, entity);
+			}
+
+			if (ImGui::MenuItem("Create Prefab"))
+			{
+				std::string filepath = FileDialogs::SaveFile("Hazel Prefab (*.hprefab)\0*.hprefab\0");
+				if (!filepath.empty())
+					Prefab::Create(entity)->Save(filepath);
+			}
+
 			if (ImGui::MenuItem("Delete Entity"))
 				entityDeleted = true;
 
@@ -96,31 +170,33 @@ namespace Hazel {
 
 		if (opened)
 		{
-			ImGuiTreeNodeFlags flags = ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_SpanAvailWidth;
-			bool opened = ImGui::TreeNodeEx((void*)9817239, flags, tag.c_str());
-			if (opened)
-				ImGui::TreePop();
+			for (UUID childID : children)
+			{
+				Entity child = m_Context->GetEntityByUUID(childID);
+				if (child)
+					DrawEntityNode(child, true);
+			}
 			ImGui::TreePop();
 		}
 
 		if (entityDeleted)
 		{
-			m_Context->DestroyEntity(entity);
-			if (m_SelectionContext == entity)
+			if (m_SelectionContext && (m_SelectionContext == entity || m_Context->IsDescendantOf(m_SelectionContext, entity)))
 				m_SelectionContext = {};
+			m_Context->DestroyEntity(entity);
 		}
 	}
 
-	static void DrawVec3Control(const std::string& label, glm::vec3& values, float resetValue = 0.0f, float columnWidth = 100.0f)
+	static void DrawVec3Control(const char* label, glm::vec3& values, float resetValue = 0.0f, float columnWidth = 100.0f)
 	{
 		ImGuiIO& io = ImGui::GetIO();
 		auto boldFont = io.Fonts->Fonts[0];
 
-		ImGui::PushID(label.c_str());
+		ImGui::PushID(label);
 
 		ImGui::Columns(2);
 		ImGui::SetColumnWidth(0, columnWidth);
-		ImGui::Text(label.c_str());
+		ImGui::Text(label);
 		ImGui::NextColumn();
 
 		ImGui::PushMultiItemsWidths(3, ImGui::CalcItemWidth());
@@ -178,7 +254,7 @@ namespace Hazel {
 	}
 	
 	template<typename T, typename UIFunction>
-	static void DrawComponent(const std::string& name, Entity entity, UIFunction uiFunction)
+	static void DrawComponent(const char* name, Entity entity, UIFunction uiFunction)
 	{
 		const ImGuiTreeNodeFlags treeNodeFlags = ImGuiTreeNodeFlags_DefaultOpen | ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_AllowItemOverlap | ImGuiTreeNodeFlags_FramePadding;
 		if (entity.HasComponent<T>())
@@ -189,7 +265,7 @@ namespace Hazel {
 			ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, ImVec2{ 4, 4 });
 			float lineHeight = GImGui->Font->FontSize + GImGui->Style.FramePadding.y * 2.0f;
 			ImGui::Separator();
-			bool open = ImGui::TreeNodeEx((void*)typeid(T).hash_code(), treeNodeFlags, name.c_str());
+			bool open = ImGui::TreeNodeEx((void*)typeid(T).hash_code(), treeNodeFlags, name);
 			ImGui::PopStyleVar(
 			);
 			ImGui::SameLine(contentRegionAvailable.x - lineHeight * 0.5f);
@@ -220,6 +296,12 @@ namespace Hazel {
 
 	void SceneHierarchyPanel::DrawComponents(Entity entity)
 	{
+		bool active = entity.IsActive();
+		if (ImGui::Checkbox("##Active", &active))
+			entity.SetActive(active);
+
+		ImGui::SameLine();
+
 		if (entity.HasComponent<TagComponent>())
 		{
 			auto& tag = entity.GetComponent<TagComponent>().Tag;
@@ -229,7 +311,7 @@ namespace Hazel {
 			strncpy_s(buffer, sizeof(buffer), tag.c_str(), sizeof(buffer));
 			if (ImGui::InputText("##Tag", buffer, sizeof(buffer)))
 			{
-				tag = std::string(buffer);
+				entity.SetName(buffer);
 			}
 		}
 
@@ -249,6 +331,7 @@ namespace Hazel {
 			DisplayAddComponentEntry<BoxCollider2DComponent>("Box Collider 2D");
 			DisplayAddComponentEntry<CircleCollider2DComponent>("Circle Collider 2D");
 			DisplayAddComponentEntry<TextComponent>("Text Component");
+			DisplayAddComponentEntry<UpdateLODComponent>("Update LOD");
 
 			ImGui::EndPopup();
 		}
@@ -412,11 +495,30 @@ namespace Hazel {
 				{
 					const wchar_t* path = (const wchar_t*)payload->Data;
 					std::filesystem::path texturePath(path);
-					Ref<Texture2D> texture = Texture2D::Create(texturePath.string());
-					if (texture->IsLoaded())
-						component.Texture = texture;
+
+					Ref<TextureAtlas> spriteAtlas = Project::GetSpriteAtlas();
+					Ref<SubTexture2D> subtexture = spriteAtlas ? spriteAtlas->GetSubTexture(texturePath) : nullptr;
+					if (subtexture)
+					{
+						component.SubTexture = AssetTable<SubTexture2D>::Add(subtexture);
+						component.Texture = {};
+					}
+					else if (AssetHandle<Texture2D> loaded = AssetTable<Texture2D>::Find(texturePath.string()))
+					{
+						component.Texture = loaded;
+						component.SubTexture = {};
+					}
 					else
-						HZ_WARN("Could not load texture {0}", texturePath.filename().string());
+					{
+						Ref<Texture2D> texture = Texture2D::Create(texturePath.string());
+						if (texture->IsLoaded())
+						{
+							component.Texture = AssetTable<Texture2D>::Add(texture, texturePath.string());
+							component.SubTexture = {};
+						}
+						else
+							HZ_WARN("Could not load texture {0}", texturePath.filename().string());
+					}
 				}
 				ImGui::EndDragDropTarget();
 			}
@@ -484,13 +586,25 @@ namespace Hazel {
 			ImGui::DragFloat("Line Spacing", &component.LineSpacing, 0.025f);
 		});
 
+		DrawComponent<UpdateLODComponent>("Update LOD", entity, [](auto& component)
+		{
+			auto& settings = component.Settings;
+			ImGui::DragFloat("Reduced Distance", &settings.ReducedDistance, 0.5f, 0.0f, settings.SuspendDistance);
+			ImGui::DragFloat("Suspend Distance", &settings.SuspendDistance, 0.5f, settings.ReducedDistance, FLT_MAX);
+			int interval = (int)settings.ReducedInterval;
+			if (ImGui::DragInt("Reduced Interval", &interval, 0.1f, 1, 64, "Every %d frames"))
+				settings.ReducedInterval = (uint32_t)glm::max(interval, 1);
+			ImGui::Checkbox("Reduce Offscreen", &settings.ReduceOffscreen);
+			ImGui::Checkbox("Sleep Suspended Bodies", &settings.SleepSuspendedBodies);
+		});
+
 	}
 	
 	template<typename T>
-	void SceneHierarchyPanel::DisplayAddComponentEntry(const std::string& entryName) {
+	void SceneHierarchyPanel::DisplayAddComponentEntry(const char* entryName) {
 		if (!m_SelectionContext.HasComponent<T>())
 		{
-			if (ImGui::MenuItem(entryName.c_str()))
+			if (ImGui::MenuItem(entryName))
 			{
 				m_SelectionContext.AddComponent<T>();
 				ImGui::CloseCurrentPopup();
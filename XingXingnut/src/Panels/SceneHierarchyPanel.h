@@ -20,13 +20,14 @@ namespace Hazel {
 		void SetSelectedEntity(Entity entity);
 	private:
 		template<typename T>
-		void DisplayAddComponentEntry(const std::string& entryName);
+		void DisplayAddComponentEntry(const char* entryName);
 	
-		void DrawEntityNode(Entity entity);
+		void DrawEntityNode(Entity entity, bool drawChildren);
 		void DrawComponents(Entity entity);
 	private:
 		Ref<Scene> m_Context;
 		Entity m_SelectionContext;
+		std::string m_SearchFilter;
 	};
 
 }
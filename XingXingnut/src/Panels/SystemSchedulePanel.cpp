@@ -0,0 +1,110 @@
+#include "SystemSchedulePanel.h"
+
+#include "XingXing/Core/JobSystem.h"
+
+#include <imgui/imgui.h>
+
+namespace Hazel {
+
+	void SystemSchedulePanel::SetContext(const Ref<Scene>& scene)
+	{
+		m_Context = scene;
+	}
+
+	void SystemSchedulePanel::OnImGuiRender()
+	{
+		ImGui::Begin("Systems");
+
+		if (!m_Context || m_Context->GetSystemScheduler().GetSystems().empty())
+		{
+			ImGui::TextDisabled("No systems scheduled, start the scene to populate");
+			ImGui::End();
+			return;
+		}
+
+		const SystemScheduler& scheduler = m_Context->GetSystemScheduler();
+		const auto& systems = scheduler.GetSystems();
+
+		ImGui::Text("Frame: %.3f ms, %d workers", scheduler.GetExecutionTime(), JobSystem::GetWorkerCount());
+
+		// Timeline, one row per thread
+		{
+			const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+			const uint32_t rowCount = JobSystem::GetWorkerCount() + 1;
+			const float frameTime = std::max(scheduler.GetExecutionTime(), 0.001f);
+
+			ImVec2 origin = ImGui::GetCursorScreenPos();
+			float width = ImGui::GetContentRegionAvail().x;
+			ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+			drawList->AddRectFilled(origin, { origin.x + width, origin.y + rowHeight * rowCount }, IM_COL32(40, 40, 40, 255));
+			for (uint32_t i = 0; i < systems.size(); i++)
+			{
+				const auto& timing = systems[i].Timing;
+				uint32_t row = timing.WorkerIndex < 0 ? 0 : (uint32_t)timing.WorkerIndex + 1;
+
+				float x0 = origin.x + width * (timing.Start / frameTime);
+				float x1 = std::max(origin.x + width * ((timing.Start + timing.Duration) / frameTime), x0 + 2.0f);
+				float y0 = origin.y + row * rowHeight;
+				ImU32 color = ImGui::ColorConvertFloat4ToU32(ImColor::HSV((float)i / (float)systems.size(), 0.6f, 0.8f));
+
+				drawList->AddRectFilled({ x0, y0 + 1.0f }, { x1, y0 + rowHeight - 1.0f }, color);
+				drawList->PushClipRect({ x0, y0 }, { x1, y0 + rowHeight }, true);
+				drawList->AddText({ x0 + 2.0f, y0 }, IM_COL32(0, 0, 0, 255), systems[i].Name.c_str());
+				drawList->PopClipRect();
+			}
+
+			ImGui::Dummy({ width, rowHeight * rowCount });
+		}
+
+		ImGui::Separator();
+
+		ImGui::Columns(4);
+		ImGui::Text("System");   ImGui::NextColumn();
+		ImGui::Text("Thread");   ImGui::NextColumn();
+		ImGui::Text("Time (ms)"); ImGui::NextColumn();
+		ImGui::Text("Avg (ms)");  ImGui::NextColumn();
+		ImGui::Separator();
+
+		for (uint32_t i = 0; i < systems.size(); i++)
+		{
+			const auto& system = systems[i];
+
+			ImGui::PushID((int)i);
+			bool open = ImGui::TreeNodeEx(system.Name.c_str(), ImGuiTreeNodeFlags_SpanAvailWidth);
+			ImGui::NextColumn();
+			if (system.Timing.WorkerIndex < 0)
+				ImGui::Text("Main");
+			else
+				ImGui::Text("Worker %d", system.Timing.WorkerIndex);
+			ImGui::NextColumn();
+			ImGui::Text("%.3f", system.Timing.Duration); ImGui::NextColumn();
+			ImGui::Text("%.3f", system.Timing.AverageDuration); ImGui::NextColumn();
+
+			if (open)
+			{
+				const SystemAccess& access = system.Access;
+				if (access.IsExclusive())
+					ImGui::TextDisabled("Exclusive");
+				if (access.IsMainThread())
+					ImGui::TextDisabled("Main thread");
+
+				for (const auto& entry : access.GetEntries())
+					ImGui::TextDisabled("%s %s", entry.Write ? "Write" : "Read ", entry.Name.c_str());
+
+				for (uint32_t dependency : system.Dependencies)
+					ImGui::TextDisabled("After %s", systems[dependency].Name.c_str());
+
+				ImGui::TreePop();
+
+				// Details only fill the first column
+				ImGui::NextColumn(); ImGui::NextColumn(); ImGui::NextColumn();
+			}
+			ImGui::PopID();
+		}
+		ImGui::Columns(1);
+
+		ImGui::End();
+	}
+
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "XingXing/Core/Base.h"
+#include "XingXing/Scene/Scene.h"
+
+namespace Hazel {
+
+	// Shows the systems of the active scene, their declared access and dependencies,
+	// and a timeline of the last frame per thread
+	class SystemSchedulePanel
+	{
+	public:
+		SystemSchedulePanel() = default;
+
+		void SetContext(const Ref<Scene>& scene);
+
+		void OnImGuiRender();
+	private:
+		Ref<Scene> m_Context;
+	};
+
+}
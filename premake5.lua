@@ -42,6 +42,8 @@ group ""
 
 group "Tools"
     include "XingXingnut"
+    include "XingXingRunner"
+    include "XingXingSceneGenerator"
 group ""
 
 group "Misc"